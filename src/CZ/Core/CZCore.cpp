@@ -1,10 +1,12 @@
 #include <CZ/Core/CZLog.h>
 #include <CZ/Core/CZCore.h>
+#include <CZ/Core/CZInputRecorder.h>
 #include <CZ/Core/CZTimer.h>
 #include <CZ/Core/CZAnimation.h>
 #include <CZ/Core/CZLockGuard.h>
 #include <CZ/Core/CZKeymap.h>
 #include <CZ/Core/CZBus.h>
+#include <CZ/Core/CZObjectCensus.h>
 #include <CZ/Core/Events/CZEvent.h>
 #include <sys/timerfd.h>
 
@@ -65,6 +67,8 @@ int CZCore::dispatch(int msTimeout) noexcept
     if (ret == -1)
         return ret;
 
+    m_loopTimeUs = CZTime::Us();
+
     CZEventSource *source;
 
     for (int i = 0; i < ret; i++)
@@ -77,8 +81,12 @@ int CZCore::dispatch(int msTimeout) noexcept
         source->m_callback(source->fd(), m_epollEvents[i].events, source);
     }
 
-    CZSafeEventQueue tmp { std::move(m_eventQueue) };
-    tmp.dispatch();
+    // Events deferred by the lane budgets are dispatched on the next iteration
+    if (m_eventQueue.dispatch())
+        unlockLoop();
+
+    if (CZObjectCensus::IsEnabled())
+        CZObjectCensus::Collect();
 
     return ret;
 }
@@ -93,11 +101,27 @@ bool CZCore::sendEvent(const CZEvent &event, CZObject &object) noexcept
         return true;
     }
 
+    // Events re-sent by handlers are not recorded
+    if (m_inputRecorder && m_sendEventDepth == 0 && event.isInputEvent())
+        m_inputRecorder->record(event, &object);
+
+    m_sendEventDepth++;
+    bool accepted { false };
+
     for (CZObject *filter : object.m_installedEventFilters)
+    {
         if (filter->eventFilter(event, object))
-            return true;
+        {
+            accepted = true;
+            break;
+        }
+    }
 
-    return object.event(event);
+    if (!accepted)
+        accepted = object.event(event);
+
+    m_sendEventDepth--;
+    return accepted;
 }
 
 void CZCore::postEvent(std::shared_ptr<CZEvent> event, CZObject &object) noexcept
@@ -154,8 +178,8 @@ CZCore::~CZCore() noexcept
 bool CZCore::init() noexcept
 {
     m_loopUnlocker = CZBooleanEventSource::Make(false, [this](auto) {
-        CZSafeEventQueue tmp { std::move(m_eventQueue) };
-        tmp.dispatch();
+        if (m_eventQueue.dispatch())
+            unlockLoop();
     });
 
     if (!initTimersSource())
@@ -168,6 +192,16 @@ bool CZCore::init() noexcept
     m_animationsTimer->setCallback([this](CZTimer*) {
         updateAnimations();
     });
+
+    if (CZObjectCensus::DumpIntervalMs() > 0)
+    {
+        m_censusTimer = std::make_unique<CZTimer>([](CZTimer *timer) {
+            CZObjectCensus::Dump();
+            timer->start(CZObjectCensus::DumpIntervalMs());
+        });
+        m_censusTimer->start(CZObjectCensus::DumpIntervalMs());
+    }
+
     return true;
 }
 
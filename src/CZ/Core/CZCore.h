@@ -5,6 +5,7 @@
 #include <CZ/Core/CZEventSource.h>
 #include <CZ/Core/CZSafeEventQueue.h>
 #include <CZ/Core/CZBooleanEventSource.h>
+#include <CZ/Core/CZTime.h>
 #include <memory>
 #include <vector>
 #include <sys/epoll.h>
@@ -71,6 +72,14 @@ public:
      */
     int dispatch(int msTimeout = -1) noexcept;
 
+    /**
+     * @brief Monotonic time in microseconds captured each time dispatch() wakes up.
+     *
+     * A clock-free alternative to CZTime::Us() for timestamps that do not need to be exact,
+     * such as input events created while handling a batch of file descriptor events.
+     */
+    UInt64 loopTimeUs() const noexcept { return m_loopTimeUs; }
+
     /**
      * @brief Sends an event synchronously to the specified object.
      *
@@ -93,6 +102,55 @@ public:
      */
     void postEvent(std::shared_ptr<CZEvent> event, CZObject &object) noexcept;
 
+    /**
+     * @brief Constructs an event in place and posts it to the specified object.
+     *
+     * The event is built inside a recycled CZEventPool slot, avoiding the heap allocation and atomic
+     * reference counting of the `std::shared_ptr` variant. The returned reference can be used to fill
+     * the event fields before the loop dispatches it.
+     *
+     * @code
+     * auto &event { core->postEvent<CZPointerMoveEvent>(target) };
+     * event.pos = pos;
+     * event.delta = delta;
+     * @endcode
+     *
+     * @note Must be called from the thread running the loop.
+     *
+     * @param object The target object.
+     * @param args Arguments forwarded to the event constructor.
+     * @return The queued event, valid until dispatched.
+     */
+    template<class T, class... Args>
+    T &postEvent(CZObject &object, Args&&... args) noexcept
+    {
+        auto event { CZEventPool::Make<T>(std::forward<Args>(args)...) };
+        T &ref { static_cast<T&>(*event) };
+        unlockLoop();
+        m_eventQueue.addEvent(std::move(event), object);
+        return ref;
+    }
+
+    /**
+     * @brief Sets how posted events are merged before being dispatched.
+     *
+     * Disabled by default. With CZSafeEventQueue::CoalescePolicy::Motion, bursts of pointer or touch motion
+     * posted within the same loop iteration are delivered as a single event per target.
+     */
+    void setEventCoalescePolicy(CZSafeEventQueue::CoalescePolicy policy) noexcept { m_eventQueue.setCoalescePolicy(policy); }
+
+    /**
+     * @brief The current coalescing policy of posted events.
+     */
+    CZSafeEventQueue::CoalescePolicy eventCoalescePolicy() const noexcept { return m_eventQueue.coalescePolicy(); }
+
+    /**
+     * @brief Queue of posted events.
+     *
+     * Can be used to tune the lane budgets or inspect queueing delays, see CZSafeEventQueue::laneStats().
+     */
+    CZSafeEventQueue &eventQueue() noexcept { return m_eventQueue; }
+
     /**
      * @brief Updates all running animations.
      *
@@ -143,6 +201,7 @@ private:
     friend class CZEventSource;
     friend class CZAnimation;
     friend class CZTimer;
+    friend class CZInputRecorder;
     friend class LCompositor;
     friend class LKeyboard;
 
@@ -161,6 +220,7 @@ private:
     void updateTimers() noexcept;
     void scheduleTimer() noexcept;
     int m_epollFd;
+    UInt64 m_loopTimeUs { CZTime::Us() };
     std::vector<epoll_event> m_epollEvents;
     std::vector<std::shared_ptr<CZEventSource>> m_currentEventSources;
     std::vector<std::shared_ptr<CZEventSource>> m_pendingEventSources;
@@ -177,6 +237,11 @@ private:
     bool m_animationsChanged { false };
     UInt64 m_animationInteval { 8 };
 
+    std::unique_ptr<CZTimer> m_censusTimer;
+
+    CZInputRecorder *m_inputRecorder {};
+    UInt32 m_sendEventDepth { 0 };
+
     std::shared_ptr<CZKeymap> m_keymap;
 };
 
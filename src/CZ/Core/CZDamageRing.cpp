@@ -0,0 +1,84 @@
+#include <CZ/Core/CZDamageRing.h>
+#include <CZ/Core/Utils/CZRegionUtils.h>
+#include <algorithm>
+
+using namespace CZ;
+
+CZDamageRing::CZDamageRing(UInt32 capacity) noexcept :
+    m_frames(std::max(capacity, 1u)),
+    m_unions(m_frames.size() + 1)
+{}
+
+void CZDamageRing::setGeometry(SkISize logicalSize, Float32 scale, CZTransform transform) noexcept
+{
+    if (scale <= 0.f)
+        scale = 1.f;
+
+    if (logicalSize == m_logicalSize && scale == m_scale && transform == m_transform)
+        return;
+
+    m_logicalSize = logicalSize;
+    m_scale = scale;
+    m_transform = transform;
+
+    const SkISize scaled { SkISize::Make(
+        SkScalarCeilToInt(SkScalar(logicalSize.width()) * scale),
+        SkScalarCeilToInt(SkScalar(logicalSize.height()) * scale)) };
+
+    m_bufferSize = Is90Transform(transform) ? SkISize::Make(scaled.height(), scaled.width()) : scaled;
+    m_full.setRect(SkIRect::MakeSize(m_bufferSize));
+    reset();
+}
+
+void CZDamageRing::addFrame(const SkRegion &damage) noexcept
+{
+    m_last = (m_last + 1) % capacity();
+    toBuffer(damage, m_frames[m_last]);
+    m_known = std::min(m_known + 1, capacity() + 1);
+    m_cached = 1;
+}
+
+void CZDamageRing::reset() noexcept
+{
+    m_known = 0;
+    m_cached = 1;
+}
+
+const SkRegion &CZDamageRing::damageForAge(UInt32 age) noexcept
+{
+    if (!isKnownAge(age))
+        return m_full;
+
+    // Extend the cached unions up to this age, each one adds a single frame to the previous
+    for (; m_cached < age; m_cached++)
+        m_unions[m_cached].op(m_unions[m_cached - 1], frame(m_cached - 1), SkRegion::Op::kUnion_Op);
+
+    return m_unions[age - 1];
+}
+
+void CZDamageRing::repaintRegion(const SkRegion &damage, UInt32 age, SkRegion &repaint) noexcept
+{
+    if (!isKnownAge(age))
+    {
+        repaint = m_full;
+        return;
+    }
+
+    toBuffer(damage, repaint);
+    repaint.op(damageForAge(age), SkRegion::Op::kUnion_Op);
+}
+
+void CZDamageRing::toBuffer(const SkRegion &logical, SkRegion &buffer) const noexcept
+{
+    buffer = logical;
+    buffer.op(SkIRect::MakeSize(m_logicalSize), SkRegion::Op::kIntersect_Op);
+    CZRegionUtils::Scale(buffer, m_scale);
+
+    const SkISize scaled { Is90Transform(m_transform) ? SkISize::Make(m_bufferSize.height(), m_bufferSize.width()) : m_bufferSize };
+    CZRegionUtils::ApplyTransform(buffer, scaled, m_transform);
+}
+
+const SkRegion &CZDamageRing::frame(UInt32 back) const noexcept
+{
+    return m_frames[(m_last + capacity() - back) % capacity()];
+}
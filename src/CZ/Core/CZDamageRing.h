@@ -0,0 +1,121 @@
+#ifndef CZ_CZDAMAGERING_H
+#define CZ_CZDAMAGERING_H
+
+#include <CZ/Core/CZTransform.h>
+#include <CZ/skia/core/SkRegion.h>
+#include <CZ/skia/core/SkSize.h>
+#include <vector>
+
+/**
+ * @brief Damage history of a swapchain for partial repaints based on the buffer age.
+ *
+ * A buffer of age N (`EGL_EXT_buffer_age`, Vulkan `VK_KHR_incremental_present`, or tracked manually for shm
+ * buffers) holds the contents of the frame rendered N frames ago. To bring it up to date, the damage of the
+ * current frame and of the N - 1 frames in between must be repainted. The ring keeps the damage of the last
+ * capacity() frames and returns that union with damageForAge().
+ *
+ * Damage is passed in logical coordinates and stored in buffer coordinates, scaled and transformed with
+ * CZRegionUtils. Unions are cached per age for the current frame: answering an age costs at most N - 1 unions once
+ * per frame, and nothing for ages already answered. Ages that are 0 (undefined contents), older than the history or
+ * older than the last reset() return the full buffer.
+ *
+ * @code
+ * SkRegion repaint;
+ * ring.repaintRegion(frameDamage, bufferAge, repaint); // buffer coordinates
+ * render(repaint);
+ * ring.addFrame(frameDamage);
+ * @endcode
+ */
+class CZ::CZDamageRing
+{
+public:
+
+    /**
+     * @brief Constructs an empty ring.
+     *
+     * @param capacity Number of frames remembered, at least 1. Buffers older than capacity() + 1 are fully repainted.
+     */
+    explicit CZDamageRing(UInt32 capacity = 4) noexcept;
+
+    /**
+     * @brief Sets the logical size, scale and transform of the buffers.
+     *
+     * Any change resets the history.
+     */
+    void setGeometry(SkISize logicalSize, Float32 scale = 1.f, CZTransform transform = CZTransform::Normal) noexcept;
+
+    SkISize logicalSize() const noexcept { return m_logicalSize; }
+    Float32 scale() const noexcept { return m_scale; }
+    CZTransform transform() const noexcept { return m_transform; }
+
+    /**
+     * @brief Size of the buffers in pixels, after the scale and transform.
+     */
+    SkISize bufferSize() const noexcept { return m_bufferSize; }
+
+    /**
+     * @brief Number of frames remembered.
+     */
+    UInt32 capacity() const noexcept { return static_cast<UInt32>(m_frames.size()); }
+
+    /**
+     * @brief Records the damage of the frame just rendered.
+     *
+     * @param damage Damage in logical coordinates, clipped to logicalSize().
+     */
+    void addFrame(const SkRegion &damage) noexcept;
+
+    /**
+     * @brief Forgets the history, e.g. after the buffers are recreated.
+     *
+     * Until new frames are added, every age returns the full buffer.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Damage added since a buffer of the given age was rendered, in buffer coordinates.
+     *
+     * Excludes the damage of the frame being rendered. Age 1 (the buffer presented last) returns an empty region.
+     *
+     * @return The union of the last `age - 1` frames, or the full buffer if the age is unknown. Valid until the next
+     *         non-const call.
+     */
+    const SkRegion &damageForAge(UInt32 age) noexcept;
+
+    /**
+     * @brief Region to repaint in a buffer of the given age, in buffer coordinates.
+     *
+     * @param damage Damage of the current frame in logical coordinates.
+     * @param age Age of the buffer, 0 if unknown.
+     * @param repaint Receives the damage plus damageForAge().
+     */
+    void repaintRegion(const SkRegion &damage, UInt32 age, SkRegion &repaint) noexcept;
+
+    /**
+     * @brief Maps a logical region to buffer coordinates.
+     */
+    void toBuffer(const SkRegion &logical, SkRegion &buffer) const noexcept;
+
+    /**
+     * @brief Whether damageForAge() has the history needed for the age.
+     */
+    bool isKnownAge(UInt32 age) const noexcept { return age > 0 && age <= m_known; }
+
+private:
+    // Damage of the frame rendered `back` frames ago (0 is the last one)
+    const SkRegion &frame(UInt32 back) const noexcept;
+    std::vector<SkRegion> m_frames;
+
+    // m_unions[k] is the union of the last k frames, valid for k < m_cached
+    std::vector<SkRegion> m_unions;
+    SkRegion m_full;
+    SkISize m_logicalSize {};
+    SkISize m_bufferSize {};
+    Float32 m_scale { 1.f };
+    CZTransform m_transform { CZTransform::Normal };
+    UInt32 m_last { 0 };
+    UInt32 m_known { 0 };
+    UInt32 m_cached { 1 };
+};
+
+#endif // CZ_CZDAMAGERING_H
@@ -0,0 +1,461 @@
+#include <CZ/Core/CZInputRecorder.h>
+#include <CZ/Core/CZInputDevice.h>
+#include <CZ/Core/CZCore.h>
+#include <CZ/Core/CZLog.h>
+#include <CZ/Core/Events/CZPointerMoveEvent.h>
+#include <CZ/Core/Events/CZPointerScrollEvent.h>
+#include <CZ/Core/Events/CZPointerButtonEvent.h>
+#include <CZ/Core/Events/CZPointerEnterEvent.h>
+#include <CZ/Core/Events/CZPointerLeaveEvent.h>
+#include <CZ/Core/Events/CZPointerSwipeBeginEvent.h>
+#include <CZ/Core/Events/CZPointerSwipeUpdateEvent.h>
+#include <CZ/Core/Events/CZPointerSwipeEndEvent.h>
+#include <CZ/Core/Events/CZPointerPinchBeginEvent.h>
+#include <CZ/Core/Events/CZPointerPinchUpdateEvent.h>
+#include <CZ/Core/Events/CZPointerPinchEndEvent.h>
+#include <CZ/Core/Events/CZPointerHoldBeginEvent.h>
+#include <CZ/Core/Events/CZPointerHoldEndEvent.h>
+#include <CZ/Core/Events/CZKeyboardKeyEvent.h>
+#include <CZ/Core/Events/CZKeyboardModifiersEvent.h>
+#include <CZ/Core/Events/CZKeyboardEnterEvent.h>
+#include <CZ/Core/Events/CZKeyboardLeaveEvent.h>
+#include <CZ/Core/Events/CZTouchDownEvent.h>
+#include <CZ/Core/Events/CZTouchMoveEvent.h>
+#include <CZ/Core/Events/CZTouchUpEvent.h>
+#include <CZ/Core/Events/CZTouchFrameEvent.h>
+#include <CZ/Core/Events/CZTouchCancelEvent.h>
+#include <CZ/Core/Events/CZTouchBatchEvent.h>
+#include <cxxabi.h>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace CZ;
+
+static constexpr size_t FlushThreshold { 64 * 1024 };
+
+static_assert(sizeof(CZInputRecorder::Header) % CZInputRecorder::Alignment == 0);
+static_assert(sizeof(CZInputRecorder::RecordHeader) % CZInputRecorder::Alignment == 0);
+
+namespace
+{
+    struct Writer
+    {
+        std::vector<UInt8> &out;
+
+        template<class T>
+        void operator()(const T &value) noexcept
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const auto *bytes { reinterpret_cast<const UInt8*>(&value) };
+            out.insert(out.end(), bytes, bytes + sizeof(T));
+        }
+
+        void operator()(const std::string &value) noexcept
+        {
+            (*this)(static_cast<UInt32>(value.size()));
+            out.insert(out.end(), value.begin(), value.end());
+        }
+
+        void operator()(const CZKeyboardKeyEvent::UTF8 &value) noexcept
+        {
+            (*this)(static_cast<UInt32>(value.size()));
+            out.insert(out.end(), value.data(), value.data() + value.size());
+        }
+    };
+
+    // Whether a raw value read from a recording is a valid enumerator
+    template<class T>
+    constexpr bool InRange(std::underlying_type_t<T> raw) noexcept
+    {
+        if constexpr (std::is_same_v<T, CZPointerScrollEvent::Source>)
+            return raw <= CZPointerScrollEvent::WheelTilt || raw == CZPointerScrollEvent::WheelLegacy;
+        else if constexpr (std::is_same_v<T, CZPointerScrollEvent::RelativeDirection>)
+            return raw <= CZPointerScrollEvent::Inverted;
+        else if constexpr (std::is_same_v<T, xkb_compose_status>)
+            return raw <= XKB_COMPOSE_CANCELLED;
+        else if constexpr (std::is_same_v<T, CZTouchBatchEvent::State>)
+            return raw <= static_cast<UInt8>(CZTouchBatchEvent::State::Up);
+        else
+            static_assert(sizeof(T) == 0, "Serialized enums must be listed here");
+    }
+
+    /*
+     * Recordings are untrusted: bools and enums are read as integers and validated before being stored,
+     * any invalid or missing value clears ok.
+     */
+    struct Reader
+    {
+        const UInt8 *data;
+        size_t size;
+        bool ok { true };
+
+        template<class T>
+        void operator()(T &value) noexcept
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+
+            if (!ok || size < sizeof(T))
+            {
+                ok = false;
+                return;
+            }
+
+            std::memcpy(&value, data, sizeof(T));
+            data += sizeof(T);
+            size -= sizeof(T);
+        }
+
+        void operator()(bool &value) noexcept
+        {
+            UInt8 raw { 0 };
+            (*this)(raw);
+            ok = ok && raw <= 1;
+            value = raw == 1;
+        }
+
+        template<class T> requires std::is_enum_v<T>
+        void operator()(T &value) noexcept
+        {
+            std::underlying_type_t<T> raw {};
+            (*this)(raw);
+            ok = ok && InRange<T>(raw);
+            value = ok ? static_cast<T>(raw) : T {};
+        }
+
+        template<class T, size_t N>
+        void operator()(std::array<T, N> &values) noexcept
+        {
+            for (auto &value : values)
+                (*this)(value);
+        }
+
+        void operator()(std::string &value) noexcept
+        {
+            const std::string_view text { string() };
+            value.assign(text.data(), text.size());
+        }
+
+        void operator()(CZKeyboardKeyEvent::UTF8 &value) noexcept
+        {
+            value.assign(string());
+        }
+
+        std::string_view string() noexcept
+        {
+            UInt32 length { 0 };
+            (*this)(length);
+
+            if (!ok || size < length)
+            {
+                ok = false;
+                return {};
+            }
+
+            const std::string_view text { reinterpret_cast<const char*>(data), length };
+            data += length;
+            size -= length;
+            return text;
+        }
+    };
+}
+
+/*
+ * Single list of serialized fields per event type, shared by record() and Decode().
+ * E is const when writing. Returns false for types that are not recorded.
+ */
+template<class IO, class Fn>
+static bool VisitFields(CZEvent::Type type, Fn &&withEvent) noexcept
+{
+    using T = CZEvent::Type;
+
+    switch (type)
+    {
+    case T::PointerMove:
+        return withEvent.template operator()<CZPointerMoveEvent>([](IO &io, auto &e) { io(e.pos); io(e.delta); io(e.deltaUnaccelerated); });
+    case T::PointerScroll:
+        return withEvent.template operator()<CZPointerScrollEvent>([](IO &io, auto &e) {
+            io(e.hasX); io(e.hasY); io(e.relativeDirectionX); io(e.relativeDirectionY); io(e.axes); io(e.axesDiscrete); io(e.source); });
+    case T::PointerButton:
+        return withEvent.template operator()<CZPointerButtonEvent>([](IO &io, auto &e) { io(e.button); io(e.pressed); });
+    case T::PointerEnter:
+        return withEvent.template operator()<CZPointerEnterEvent>([](IO &io, auto &e) { io(e.pos); });
+    case T::PointerLeave:
+        return withEvent.template operator()<CZPointerLeaveEvent>([](IO &, auto &) {});
+    case T::PointerSwipeBegin:
+        return withEvent.template operator()<CZPointerSwipeBeginEvent>([](IO &io, auto &e) { io(e.fingers); });
+    case T::PointerSwipeUpdate:
+        return withEvent.template operator()<CZPointerSwipeUpdateEvent>([](IO &io, auto &e) { io(e.fingers); io(e.delta); io(e.deltaUnaccelerated); });
+    case T::PointerSwipeEnd:
+        return withEvent.template operator()<CZPointerSwipeEndEvent>([](IO &io, auto &e) { io(e.fingers); io(e.cancelled); });
+    case T::PointerPinchBegin:
+        return withEvent.template operator()<CZPointerPinchBeginEvent>([](IO &io, auto &e) { io(e.fingers); });
+    case T::PointerPinchUpdate:
+        return withEvent.template operator()<CZPointerPinchUpdateEvent>([](IO &io, auto &e) {
+            io(e.fingers); io(e.delta); io(e.deltaUnaccelerated); io(e.scale); io(e.rotation); });
+    case T::PointerPinchEnd:
+        return withEvent.template operator()<CZPointerPinchEndEvent>([](IO &io, auto &e) { io(e.fingers); io(e.cancelled); });
+    case T::PointerHoldBegin:
+        return withEvent.template operator()<CZPointerHoldBeginEvent>([](IO &io, auto &e) { io(e.fingers); });
+    case T::PointerHoldEnd:
+        return withEvent.template operator()<CZPointerHoldEndEvent>([](IO &io, auto &e) { io(e.fingers); io(e.cancelled); });
+    case T::KeyboardKey:
+        return withEvent.template operator()<CZKeyboardKeyEvent>([](IO &io, auto &e) {
+            io(e.code); io(e.isPressed); io(e.isRepeat); io(e.symbol); io(e.composeStatus); io(e.utf8); });
+    case T::KeyboardModifiers:
+        return withEvent.template operator()<CZKeyboardModifiersEvent>([](IO &io, auto &e) { io(e.modifiers); });
+    case T::KeyboardEnter:
+        return withEvent.template operator()<CZKeyboardEnterEvent>([](IO &, auto &) {});
+    case T::KeyboardLeave:
+        return withEvent.template operator()<CZKeyboardLeaveEvent>([](IO &, auto &) {});
+    case T::TouchDown:
+        return withEvent.template operator()<CZTouchDownEvent>([](IO &io, auto &e) { io(e.id); io(e.pos); io(e.localPos); });
+    case T::TouchMove:
+        return withEvent.template operator()<CZTouchMoveEvent>([](IO &io, auto &e) { io(e.id); io(e.pos); io(e.localPos); });
+    case T::TouchUp:
+        return withEvent.template operator()<CZTouchUpEvent>([](IO &io, auto &e) { io(e.id); });
+    case T::TouchFrame:
+        return withEvent.template operator()<CZTouchFrameEvent>([](IO &, auto &) {});
+    case T::TouchCancel:
+        return withEvent.template operator()<CZTouchCancelEvent>([](IO &, auto &) {});
+    case T::TouchBatch:
+        return withEvent.template operator()<CZTouchBatchEvent>([](IO &io, auto &e) {
+            io(e.count); io(e.ids); io(e.pos); io(e.localPos); io(e.states); });
+    default:
+        return false;
+    }
+}
+
+static std::string TypeName(const CZObject &object) noexcept
+{
+    const char *name { typeid(object).name() };
+    int status;
+    char *demangled { abi::__cxa_demangle(name, nullptr, nullptr, &status) };
+
+    if (status != 0 || !demangled)
+        return name;
+
+    std::string result { demangled };
+    free(demangled);
+    return result;
+}
+
+std::shared_ptr<CZInputRecorder> CZInputRecorder::MakeFile(const std::filesystem::path &path) noexcept
+{
+    const int fd { open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) };
+
+    if (fd < 0)
+    {
+        CZLog(CZError, CZLN, "Failed to open {}: {}", path.string(), strerror(errno));
+        return {};
+    }
+
+    return std::shared_ptr<CZInputRecorder>(new CZInputRecorder(fd));
+}
+
+std::shared_ptr<CZInputRecorder> CZInputRecorder::MakeMemory() noexcept
+{
+    return std::shared_ptr<CZInputRecorder>(new CZInputRecorder(-1));
+}
+
+CZInputRecorder::CZInputRecorder(int fd) noexcept : m_fd(fd)
+{
+    const Header header { Magic, Version, sizeof(Header), CZTime::Us() };
+    Writer { m_buffer }(header);
+}
+
+CZInputRecorder::~CZInputRecorder() noexcept
+{
+    stop();
+
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+bool CZInputRecorder::start() noexcept
+{
+    if (m_recording)
+        return true;
+
+    auto core { CZCore::Get() };
+
+    if (!core)
+    {
+        CZLog(CZError, CZLN, "Missing CZCore");
+        return false;
+    }
+
+    if (core->m_inputRecorder)
+    {
+        CZLog(CZError, CZLN, "Another recorder is already started");
+        return false;
+    }
+
+    // The header is written by the constructor, stamp it when the first recording actually begins
+    if (m_eventCount == 0 && m_buffer.size() == sizeof(Header))
+    {
+        const UInt64 startUs { CZTime::Us() };
+        std::memcpy(m_buffer.data() + offsetof(Header, startUs), &startUs, sizeof(startUs));
+    }
+
+    core->m_inputRecorder = this;
+    m_recording = true;
+    return true;
+}
+
+void CZInputRecorder::stop() noexcept
+{
+    if (!m_recording)
+        return;
+
+    if (auto core = CZCore::Get())
+        if (core->m_inputRecorder == this)
+            core->m_inputRecorder = nullptr;
+
+    m_recording = false;
+    flush();
+}
+
+size_t CZInputRecorder::beginRecord(Kind kind, UInt16 type, UInt32 device, UInt32 target, UInt64 us) noexcept
+{
+    const size_t offset { m_buffer.size() };
+    const RecordHeader header { 0, kind, type, device, target, us };
+    Writer { m_buffer }(header);
+    return offset;
+}
+
+void CZInputRecorder::endRecord(size_t offset) noexcept
+{
+    const size_t padded { (m_buffer.size() - offset + Alignment - 1) & ~size_t(Alignment - 1) };
+    m_buffer.resize(offset + padded, 0);
+    const auto size { static_cast<UInt32>(padded) };
+    std::memcpy(m_buffer.data() + offset + offsetof(RecordHeader, size), &size, sizeof(size));
+}
+
+UInt32 CZInputRecorder::deviceId(const CZInputDevice *device) noexcept
+{
+    if (!device)
+        return None;
+
+    auto it { m_devices.find(device) };
+
+    // Unknown or a new device at the address of a destroyed one
+    if (it == m_devices.end() || it->second.object.get() != device)
+    {
+        const UInt32 id { m_nextDeviceId++ };
+        auto &ref { m_devices[device] };
+        ref.object.reset(const_cast<CZInputDevice*>(device));
+        ref.id = id;
+
+        const size_t offset { beginRecord(Kind::Device, 0, id, None, 0) };
+        Writer w { m_buffer };
+        w(static_cast<UInt32>(device->caps.get()));
+        w(device->vendorId);
+        w(device->productId);
+        w(device->name);
+        endRecord(offset);
+        return id;
+    }
+
+    return it->second.id;
+}
+
+UInt32 CZInputRecorder::targetId(const CZObject *target) noexcept
+{
+    if (!target)
+        return None;
+
+    auto it { m_targets.find(target) };
+
+    if (it == m_targets.end() || it->second.object.get() != target)
+    {
+        const UInt32 id { m_nextTargetId++ };
+        auto &ref { m_targets[target] };
+        ref.object.reset(const_cast<CZObject*>(target));
+        ref.id = id;
+
+        const size_t offset { beginRecord(Kind::Target, 0, None, id, 0) };
+        Writer { m_buffer }(TypeName(*target));
+        endRecord(offset);
+        return id;
+    }
+
+    return it->second.id;
+}
+
+void CZInputRecorder::record(const CZEvent &event, const CZObject *target) noexcept
+{
+    if (!event.isInputEvent())
+        return;
+
+    const auto &input { static_cast<const CZInputEvent&>(event) };
+    const UInt32 device { deviceId(input.device.get()) };
+    const UInt32 targetRef { targetId(target) };
+    const size_t offset { beginRecord(Kind::Event, static_cast<UInt16>(event.type()), device, targetRef, input.us) };
+
+    Writer writer { m_buffer };
+
+    const bool known { VisitFields<Writer>(event.type(), [&]<class E>(auto fields) {
+        fields(writer, static_cast<const E&>(event));
+        return true;
+    }) };
+
+    if (!known)
+    {
+        m_buffer.resize(offset);
+        return;
+    }
+
+    endRecord(offset);
+    m_eventCount++;
+
+    if (m_fd >= 0 && m_buffer.size() >= FlushThreshold)
+        flush();
+}
+
+void CZInputRecorder::flush() noexcept
+{
+    if (m_fd < 0)
+        return;
+
+    size_t written { 0 };
+
+    while (written < m_buffer.size())
+    {
+        const ssize_t ret { write(m_fd, m_buffer.data() + written, m_buffer.size() - written) };
+
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            CZLog(CZError, CZLN, "Failed to write the recording: {}", strerror(errno));
+            break;
+        }
+
+        written += ret;
+    }
+
+    m_buffer.clear();
+}
+
+CZEventPool::Handle CZInputRecorder::Decode(const RecordHeader &header, const UInt8 *payload, size_t size) noexcept
+{
+    CZEventPool::Handle handle;
+    Reader reader { payload, size };
+
+    VisitFields<Reader>(static_cast<CZEvent::Type>(header.type), [&]<class E>(auto fields) {
+        auto event { CZEventPool::Make<E>(header.us) };
+        fields(reader, static_cast<E&>(*event));
+
+        if constexpr (std::is_same_v<E, CZTouchBatchEvent>)
+            reader.ok = reader.ok && static_cast<E&>(*event).count <= E::MaxPoints;
+
+        if (reader.ok)
+            handle = std::move(event);
+
+        return true;
+    });
+
+    return handle;
+}
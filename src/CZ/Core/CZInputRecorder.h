@@ -0,0 +1,177 @@
+#ifndef CZ_CZINPUTRECORDER_H
+#define CZ_CZINPUTRECORDER_H
+
+#include <CZ/Core/CZObject.h>
+#include <CZ/Core/CZWeak.h>
+#include <CZ/Core/Events/CZEvent.h>
+#include <CZ/Core/Events/CZEventPool.h>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Records input events into a binary stream.
+ *
+ * While started, every CZInputEvent delivered through CZCore::sendEvent() (including the ones queued
+ * with CZCore::postEvent()) is serialized along with its timestamp, source device and target object.
+ * Events re-sent from within event handlers (e.g. when propagating them to child objects) are not
+ * recorded, only the outermost delivery is.
+ *
+ * The stream can later be fed back with CZInputReplayer to reproduce a session, for example to debug
+ * field-reported performance problems or to benchmark input-heavy code paths with identical input.
+ *
+ * ### Format
+ *
+ * The stream starts with a Header followed by 8-byte aligned records, each beginning with a RecordHeader.
+ * All values are stored in native byte order. Device and target descriptions are emitted inline the first time
+ * they are referenced, so the stream can be appended to and read sequentially or memory-mapped as is.
+ *
+ * Only one recorder can be started at a time.
+ */
+class CZ::CZInputRecorder : public CZObject
+{
+public:
+
+    /// Stream identifier, "CZIR" in little endian
+    static constexpr UInt32 Magic { 0x5249'5A43 };
+
+    /// Current format version
+    static constexpr UInt16 Version { 1 };
+
+    /// Records are aligned to this boundary
+    static constexpr UInt32 Alignment { 8 };
+
+    /// Value of RecordHeader::device and RecordHeader::target when not available
+    static constexpr UInt32 None { 0xFFFF'FFFF };
+
+    /**
+     * @brief Stream header.
+     */
+    struct Header
+    {
+        UInt32 magic;
+        UInt16 version;
+        UInt16 headerSize;
+
+        /// CZTime::Us() when start() was first called
+        UInt64 startUs;
+    };
+
+    /**
+     * @brief Record kinds.
+     */
+    enum class Kind : UInt16
+    {
+        /// A serialized CZInputEvent, RecordHeader::type holds its CZEvent::Type
+        Event,
+
+        /// Describes the device RecordHeader::device: caps, vendorId, productId (UInt32 each) and the name
+        Device,
+
+        /// Describes the object RecordHeader::target: its demangled type name
+        Target
+    };
+
+    /**
+     * @brief Header of each record.
+     */
+    struct RecordHeader
+    {
+        /// Size of the record in bytes including this header and padding, a multiple of Alignment
+        UInt32 size;
+        Kind kind;
+        UInt16 type;
+        UInt32 device;
+        UInt32 target;
+
+        /// Event timestamp in microseconds
+        UInt64 us;
+    };
+
+    /**
+     * @brief Creates a recorder that writes into a file.
+     *
+     * The file is created or truncated immediately.
+     *
+     * @return The recorder or `nullptr` if the file could not be opened.
+     */
+    static std::shared_ptr<CZInputRecorder> MakeFile(const std::filesystem::path &path) noexcept;
+
+    /**
+     * @brief Creates a recorder that keeps the stream in memory, see buffer().
+     */
+    static std::shared_ptr<CZInputRecorder> MakeMemory() noexcept;
+
+    /**
+     * @brief Starts recording.
+     *
+     * @return `false` if another recorder is already started or there is no CZCore.
+     */
+    bool start() noexcept;
+
+    /**
+     * @brief Stops recording and flushes pending data to the file.
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Whether the recorder is started.
+     */
+    bool isRecording() const noexcept { return m_recording; }
+
+    /**
+     * @brief Serializes an event.
+     *
+     * Called automatically by CZCore while recording. Can also be called manually, for example to
+     * capture raw input before it is dispatched.
+     *
+     * @param event The event to record.
+     * @param target Object the event is addressed to, or `nullptr`.
+     */
+    void record(const CZEvent &event, const CZObject *target) noexcept;
+
+    /**
+     * @brief Number of events recorded so far.
+     */
+    UInt64 eventCount() const noexcept { return m_eventCount; }
+
+    /**
+     * @brief The in-memory stream of recorders created with MakeMemory().
+     *
+     * For file recorders, holds the bytes not flushed yet.
+     */
+    const std::vector<UInt8> &buffer() const noexcept { return m_buffer; }
+
+    ~CZInputRecorder() noexcept;
+
+private:
+    friend class CZInputReplayer;
+
+    // Rebuilds the event of an Event record, empty if the type is unknown or the payload is truncated
+    static CZEventPool::Handle Decode(const RecordHeader &header, const UInt8 *payload, size_t size) noexcept;
+
+    CZInputRecorder(int fd) noexcept;
+    UInt32 deviceId(const CZInputDevice *device) noexcept;
+    UInt32 targetId(const CZObject *target) noexcept;
+    size_t beginRecord(Kind kind, UInt16 type, UInt32 device, UInt32 target, UInt64 us) noexcept;
+    void endRecord(size_t offset) noexcept;
+    void flush() noexcept;
+
+    struct Ref
+    {
+        CZWeak<CZObject> object;
+        UInt32 id;
+    };
+
+    int m_fd;
+    bool m_recording { false };
+    UInt64 m_eventCount { 0 };
+    std::vector<UInt8> m_buffer;
+    std::unordered_map<const void*, Ref> m_devices;
+    std::unordered_map<const void*, Ref> m_targets;
+    UInt32 m_nextDeviceId { 0 };
+    UInt32 m_nextTargetId { 0 };
+};
+
+#endif // CZ_CZINPUTRECORDER_H
@@ -0,0 +1,317 @@
+#include <CZ/Core/CZInputReplayer.h>
+#include <CZ/Core/CZInputDevice.h>
+#include <CZ/Core/CZCore.h>
+#include <CZ/Core/CZLog.h>
+#include <CZ/Core/Events/CZInputEvent.h>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace CZ;
+
+using Recorder = CZInputRecorder;
+
+template<class T>
+static bool Read(const UInt8 *&data, size_t &size, T &value) noexcept
+{
+    if (size < sizeof(T))
+        return false;
+
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    size -= sizeof(T);
+    return true;
+}
+
+static bool Read(const UInt8 *&data, size_t &size, std::string &value) noexcept
+{
+    UInt32 length;
+
+    if (!Read(data, size, length) || size < length)
+        return false;
+
+    value.assign(reinterpret_cast<const char*>(data), length);
+    data += length;
+    size -= length;
+    return true;
+}
+
+std::shared_ptr<CZInputReplayer> CZInputReplayer::MakeFile(const std::filesystem::path &path) noexcept
+{
+    const int fd { open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+
+    if (fd < 0)
+    {
+        CZLog(CZError, CZLN, "Failed to open {}: {}", path.string(), strerror(errno));
+        return {};
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Recorder::Header)))
+    {
+        CZLog(CZError, CZLN, "Invalid recording {}", path.string());
+        close(fd);
+        return {};
+    }
+
+    void *map { mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) };
+    close(fd);
+
+    if (map == MAP_FAILED)
+    {
+        CZLog(CZError, CZLN, "Failed to map {}: {}", path.string(), strerror(errno));
+        return {};
+    }
+
+    madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+    auto replayer { std::shared_ptr<CZInputReplayer>(new CZInputReplayer(
+        static_cast<const UInt8*>(map), st.st_size, map, {})) };
+
+    if (!replayer->validate())
+        return {};
+
+    return replayer;
+}
+
+std::shared_ptr<CZInputReplayer> CZInputReplayer::MakeMemory(std::vector<UInt8> data) noexcept
+{
+    auto replayer { std::shared_ptr<CZInputReplayer>(new CZInputReplayer(
+        data.data(), data.size(), nullptr, std::move(data))) };
+
+    if (!replayer->validate())
+        return {};
+
+    return replayer;
+}
+
+CZInputReplayer::CZInputReplayer(const UInt8 *data, size_t size, void *map, std::vector<UInt8> &&storage) noexcept :
+    m_data(data), m_size(size), m_map(map), m_mapSize(size), m_storage(std::move(storage))
+{
+    // Moving the vector keeps its buffer
+    if (!m_map)
+        m_data = m_storage.data();
+}
+
+CZInputReplayer::~CZInputReplayer() noexcept
+{
+    if (m_map)
+        munmap(m_map, m_mapSize);
+}
+
+bool CZInputReplayer::validate() noexcept
+{
+    Recorder::Header header;
+    const UInt8 *data { m_data };
+    size_t size { m_size };
+
+    if (!Read(data, size, header) || header.magic != Recorder::Magic)
+    {
+        CZLog(CZError, CZLN, "Not an input recording");
+        return false;
+    }
+
+    if (header.version != Recorder::Version || header.headerSize < sizeof(Recorder::Header) ||
+        header.headerSize % Recorder::Alignment != 0 || header.headerSize > m_size)
+    {
+        CZLog(CZError, CZLN, "Unsupported input recording version {}", header.version);
+        return false;
+    }
+
+    m_offset = header.headerSize;
+
+    // Check the record sizes once so that the rest of the code can trust them
+    for (size_t offset = m_offset; offset < m_size;)
+    {
+        RecordHeader record;
+        data = m_data + offset;
+        size = m_size - offset;
+
+        if (!Read(data, size, record) || record.size < sizeof(RecordHeader) ||
+            record.size % Recorder::Alignment != 0 || record.size > m_size - offset)
+        {
+            // Likely a recording that was not stopped cleanly
+            CZLog(CZWarning, CZLN, "Truncated input recording, ignoring the last {} bytes", m_size - offset);
+            m_size = offset;
+            break;
+        }
+
+        if (record.kind == Recorder::Kind::Device)
+            m_deviceCount++;
+        else if (record.kind == Recorder::Kind::Target)
+            m_targetCount++;
+        else if (record.kind == Recorder::Kind::Event)
+        {
+            if (m_eventCount == 0)
+                m_firstUs = record.us;
+
+            m_lastUs = record.us;
+            m_eventCount++;
+        }
+
+        offset += record.size;
+    }
+
+    m_timeUs = m_firstUs;
+    return true;
+}
+
+void CZInputReplayer::rewind() noexcept
+{
+    Recorder::Header header;
+    std::memcpy(&header, m_data, sizeof(header));
+    m_offset = header.headerSize;
+    m_timeUs = m_firstUs;
+    m_posted = 0;
+    m_skipped = 0;
+}
+
+void CZInputReplayer::process(const RecordHeader &record) noexcept
+{
+    const UInt8 *data { m_data + m_offset + sizeof(RecordHeader) };
+    size_t size { record.size - sizeof(RecordHeader) };
+
+    // Ids come from the file, those that cannot belong to a description are skipped instead of sizing the tables
+    if (record.kind == Recorder::Kind::Device)
+    {
+        if (record.device >= m_deviceCount)
+            return;
+
+        if (record.device >= m_devices.size())
+            m_devices.resize(record.device + 1);
+
+        // Kept across rewinds
+        if (m_devices[record.device])
+            return;
+
+        UInt32 caps, vendorId, productId;
+        std::string name;
+
+        if (Read(data, size, caps) && Read(data, size, vendorId) && Read(data, size, productId) && Read(data, size, name))
+            m_devices[record.device] = CZInputDevice::Make(caps, name, vendorId, productId);
+    }
+    else if (record.kind == Recorder::Kind::Target)
+    {
+        if (record.target >= m_targetCount)
+            return;
+
+        if (record.target >= m_targets.size())
+            m_targets.resize(record.target + 1);
+
+        if (m_targets[record.target].typeName.empty())
+            Read(data, size, m_targets[record.target].typeName);
+    }
+}
+
+bool CZInputReplayer::peek(RecordHeader &record) noexcept
+{
+    while (m_offset < m_size)
+    {
+        std::memcpy(&record, m_data + m_offset, sizeof(RecordHeader));
+
+        if (record.kind == Recorder::Kind::Event)
+            return true;
+
+        process(record);
+        m_offset += record.size;
+    }
+
+    return false;
+}
+
+CZObject *CZInputReplayer::resolve(UInt32 id) noexcept
+{
+    if (id >= m_targets.size())
+        return nullptr;
+
+    auto &target { m_targets[id] };
+
+    if (!target.resolved)
+    {
+        target.resolved = true;
+
+        if (m_resolver)
+            target.object.reset(m_resolver(id, target.typeName));
+    }
+
+    return target.object;
+}
+
+size_t CZInputReplayer::step(UInt64 untilUs) noexcept
+{
+    auto core { CZCore::Get() };
+
+    if (!core)
+    {
+        CZLog(CZError, CZLN, "Missing CZCore");
+        return 0;
+    }
+
+    size_t posted { 0 };
+    RecordHeader record;
+
+    while (peek(record) && record.us <= untilUs)
+    {
+        const UInt8 *payload { m_data + m_offset + sizeof(RecordHeader) };
+        const size_t payloadSize { record.size - sizeof(RecordHeader) };
+        m_offset += record.size;
+
+        CZObject *target { resolve(record.target) };
+
+        if (!target)
+        {
+            m_skipped++;
+            continue;
+        }
+
+        record.us += m_timeOffsetUs;
+        auto event { Recorder::Decode(record, payload, payloadSize) };
+
+        if (!event)
+        {
+            m_skipped++;
+            continue;
+        }
+
+        if (record.device < m_devices.size())
+            static_cast<CZInputEvent&>(*event).device = m_devices[record.device];
+
+        core->eventQueue().addEvent(std::move(event), *target);
+        posted++;
+    }
+
+    m_timeUs = std::max(m_timeUs, untilUs);
+
+    if (posted > 0)
+        core->unlockLoop();
+
+    m_posted += posted;
+    return posted;
+}
+
+size_t CZInputReplayer::runToEnd(UInt64 frameUs) noexcept
+{
+    auto core { CZCore::Get() };
+
+    if (!core)
+    {
+        CZLog(CZError, CZLN, "Missing CZCore");
+        return 0;
+    }
+
+    size_t posted { 0 };
+    RecordHeader next;
+
+    while (peek(next))
+    {
+        // Idle periods are skipped
+        const UInt64 until { frameUs > 0 ? std::max(m_timeUs + frameUs, next.us) : next.us };
+        posted += step(until);
+        core->dispatch(0);
+    }
+
+    return posted;
+}
@@ -0,0 +1,166 @@
+#ifndef CZ_CZINPUTREPLAYER_H
+#define CZ_CZINPUTREPLAYER_H
+
+#include <CZ/Core/CZInputRecorder.h>
+#include <functional>
+
+/**
+ * @brief Replays a stream produced by CZInputRecorder.
+ *
+ * Events are rebuilt in their original order and posted to CZCore as if they were coming from the
+ * input backend, so they go through the event queue and its lanes. The replayer runs on a virtual
+ * clock expressed in the timeline of the recording: step() posts every event due up to the given time,
+ * while runToEnd() alternates steps and CZCore::dispatch() calls until the stream is exhausted.
+ *
+ * Replayed events keep their recorded timestamps, shifted by setTimeOffsetUs(), which makes runs of the
+ * same stream identical across builds. Devices are recreated from their recorded descriptions.
+ *
+ * Target objects cannot be restored automatically, a TargetResolver must map each recorded target to an
+ * object of the running session. Events without a resolved target are skipped.
+ */
+class CZ::CZInputReplayer : public CZObject
+{
+public:
+
+    /**
+     * @brief Maps a recorded target to a live object.
+     *
+     * Called once per target, the first time it is referenced.
+     *
+     * @param id Identifier of the target within the stream.
+     * @param typeName Demangled type name of the recorded object.
+     * @return The object that should receive the events, or `nullptr` to skip them.
+     */
+    using TargetResolver = std::function<CZObject*(UInt32 id, const std::string &typeName)>;
+
+    /**
+     * @brief Memory-maps a recording.
+     *
+     * @return The replayer or `nullptr` if the file could not be mapped or is not a valid recording.
+     */
+    static std::shared_ptr<CZInputReplayer> MakeFile(const std::filesystem::path &path) noexcept;
+
+    /**
+     * @brief Replays a recording held in memory, e.g. CZInputRecorder::buffer().
+     *
+     * @return The replayer or `nullptr` if the data is not a valid recording.
+     */
+    static std::shared_ptr<CZInputReplayer> MakeMemory(std::vector<UInt8> data) noexcept;
+
+    /**
+     * @brief Sets the callback used to map recorded targets to live objects.
+     */
+    void setTargetResolver(const TargetResolver &resolver) noexcept { m_resolver = resolver; }
+
+    /**
+     * @brief Offset added to the timestamps of replayed events, 0 by default.
+     *
+     * For example, `core->loopTimeUs() - replayer->firstUs()` makes the replay start now.
+     */
+    void setTimeOffsetUs(Int64 offset) noexcept { m_timeOffsetUs = offset; }
+
+    /**
+     * @brief Timestamp of the first recorded event, or 0 if there are none.
+     */
+    UInt64 firstUs() const noexcept { return m_firstUs; }
+
+    /**
+     * @brief Timestamp of the last recorded event, or 0 if there are none.
+     */
+    UInt64 lastUs() const noexcept { return m_lastUs; }
+
+    /**
+     * @brief Current time of the virtual clock, in the timeline of the recording.
+     */
+    UInt64 timeUs() const noexcept { return m_timeUs; }
+
+    /**
+     * @brief Posts every event recorded up to the given time and advances the virtual clock.
+     *
+     * @param untilUs Target time in the timeline of the recording.
+     * @return Number of posted events.
+     */
+    size_t step(UInt64 untilUs) noexcept;
+
+    /**
+     * @brief Replays the rest of the stream, dispatching the CZCore loop after each step.
+     *
+     * @param frameUs Virtual time advanced per step, or 0 to step once per recorded timestamp.
+     * @return Number of posted events.
+     */
+    size_t runToEnd(UInt64 frameUs = 0) noexcept;
+
+    /**
+     * @brief Whether every record was consumed.
+     */
+    bool atEnd() const noexcept { return m_offset >= m_size; }
+
+    /**
+     * @brief Restarts the replay from the beginning.
+     *
+     * Devices and resolved targets are kept.
+     */
+    void rewind() noexcept;
+
+    /**
+     * @brief Number of event records in the stream.
+     */
+    UInt64 eventCount() const noexcept { return m_eventCount; }
+
+    /**
+     * @brief Number of events posted since creation or the last rewind().
+     */
+    UInt64 postedCount() const noexcept { return m_posted; }
+
+    /**
+     * @brief Number of events skipped since creation or the last rewind(), due to unresolved targets or unknown types.
+     */
+    UInt64 skippedCount() const noexcept { return m_skipped; }
+
+    /**
+     * @brief Devices recreated from the stream, indexed by their recorded identifier.
+     */
+    const std::vector<std::shared_ptr<CZInputDevice>> &devices() const noexcept { return m_devices; }
+
+    ~CZInputReplayer() noexcept;
+
+private:
+    using RecordHeader = CZInputRecorder::RecordHeader;
+    CZInputReplayer(const UInt8 *data, size_t size, void *map, std::vector<UInt8> &&storage) noexcept;
+    bool validate() noexcept;
+    bool peek(RecordHeader &record) noexcept;
+    void process(const RecordHeader &record) noexcept;
+    CZObject *resolve(UInt32 id) noexcept;
+
+    struct Target
+    {
+        std::string typeName;
+        CZWeak<CZObject> object;
+        bool resolved { false };
+    };
+
+    const UInt8 *m_data;
+    size_t m_size;
+    size_t m_offset { 0 };
+    void *m_map;
+    size_t m_mapSize;
+    std::vector<UInt8> m_storage;
+
+    TargetResolver m_resolver;
+    std::vector<std::shared_ptr<CZInputDevice>> m_devices;
+    std::vector<Target> m_targets;
+
+    // Number of device and target descriptions, the recorder numbers them sequentially from 0
+    UInt32 m_deviceCount { 0 };
+    UInt32 m_targetCount { 0 };
+
+    Int64 m_timeOffsetUs { 0 };
+    UInt64 m_firstUs { 0 };
+    UInt64 m_lastUs { 0 };
+    UInt64 m_timeUs { 0 };
+    UInt64 m_eventCount { 0 };
+    UInt64 m_posted { 0 };
+    UInt64 m_skipped { 0 };
+};
+
+#endif // CZ_CZINPUTREPLAYER_H
@@ -0,0 +1,157 @@
+#include <CZ/Core/CZKeyRepeater.h>
+#include <CZ/Core/CZKeymap.h>
+#include <CZ/Core/CZSignal.h>
+#include <CZ/Core/CZTime.h>
+#include <CZ/Core/CZWeak.h>
+#include <algorithm>
+
+using namespace CZ;
+
+CZKeyRepeater::CZKeyRepeater(std::shared_ptr<CZKeymap> keymap, const Callback &callback) noexcept :
+    m_callback(callback),
+    m_timer([this](CZTimer *) { update(); })
+{
+    setKeymap(keymap);
+}
+
+void CZKeyRepeater::handleEvent(const CZKeyboardKeyEvent &event) noexcept
+{
+    if (event.isRepeat)
+        return;
+
+    if (!event.isPressed)
+    {
+        if (m_active && event.code == m_event.code)
+            stop();
+
+        return;
+    }
+
+    // xkb keycodes are evdev codes + 8
+    if (!m_keymap || !xkb_keymap_key_repeats(m_keymap->keymap(), event.code + 8))
+        return;
+
+    if (!loadRepeatInfo())
+    {
+        stop();
+        return;
+    }
+
+    const UInt64 nowUs { now() };
+    m_event = event;
+    m_event.isRepeat = true;
+
+    // Measure from the kernel timestamp so that a late delivery of the press does not delay the repeats
+    m_pressUs = std::min(event.us, nowUs);
+    m_nextUs = m_pressUs + m_delayUs;
+    m_count = 0;
+    m_serial++;
+    m_active = true;
+    schedule(nowUs);
+}
+
+void CZKeyRepeater::stop() noexcept
+{
+    m_active = false;
+    m_serial++;
+    m_timer.stop();
+}
+
+UInt32 CZKeyRepeater::update() noexcept
+{
+    if (!m_active)
+        return 0;
+
+    UInt64 nowUs { now() };
+
+    if (nowUs < m_nextUs)
+    {
+        schedule(nowUs);
+        return 0;
+    }
+
+    const UInt64 due { (nowUs - m_nextUs) / m_intervalUs + 1 };
+    const UInt64 deliver { m_policy == MissedPolicy::Drop ? 1 : std::min<UInt64>(due, m_maxCatchUp) };
+
+    // Skipped repeats keep their slots, the schedule stays aligned to the press
+    m_nextUs += (due - deliver) * m_intervalUs;
+
+    const UInt32 serial { m_serial };
+    CZWeak<CZKeyRepeater> ref { this };
+    UInt32 delivered { 0 };
+
+    for (UInt64 i = 0; i < deliver; i++)
+    {
+        m_event.setTimeUs(m_nextUs);
+        m_nextUs += m_intervalUs;
+        m_count++;
+        delivered++;
+
+        if (m_callback)
+        {
+            // Copy so that the callback can neither alter the template nor be affected by a new press
+            const CZKeyboardKeyEvent event { m_event };
+            m_callback(event);
+
+            // Stopped, restarted or destroyed from the callback
+            if (!ref || serial != m_serial)
+                return delivered;
+        }
+    }
+
+    schedule(now());
+    return delivered;
+}
+
+void CZKeyRepeater::setKeymap(std::shared_ptr<CZKeymap> keymap) noexcept
+{
+    stop();
+
+    if (m_repeatInfoListener)
+    {
+        delete m_repeatInfoListener;
+        m_repeatInfoListener = nullptr;
+    }
+
+    m_keymap = keymap;
+
+    if (m_keymap)
+        m_repeatInfoListener = m_keymap->onRepeatInfoChanged.subscribe(this, [this]() { onRepeatInfoChanged(); });
+}
+
+void CZKeyRepeater::onRepeatInfoChanged() noexcept
+{
+    if (!m_active)
+        return;
+
+    if (!loadRepeatInfo())
+    {
+        stop();
+        return;
+    }
+
+    m_nextUs = m_count == 0 ? m_pressUs + m_delayUs : m_event.us + m_intervalUs;
+    schedule(now());
+}
+
+bool CZKeyRepeater::loadRepeatInfo() noexcept
+{
+    if (!m_keymap || m_keymap->repeatRateMs() <= 0)
+        return false;
+
+    m_delayUs = static_cast<UInt64>(std::max(m_keymap->repeatDelayMs(), 0)) * 1000;
+    m_intervalUs = static_cast<UInt64>(m_keymap->repeatRateMs()) * 1000;
+    return true;
+}
+
+void CZKeyRepeater::schedule(UInt64 nowUs) noexcept
+{
+    // CZTimer has millisecond granularity and never fires early, round up so the deadline is never missed
+    const UInt64 remainingUs { m_nextUs > nowUs ? m_nextUs - nowUs : 0 };
+    m_timer.start(static_cast<UInt32>((remainingUs + 999) / 1000));
+}
+
+UInt64 CZKeyRepeater::now() const noexcept
+{
+    return m_clock ? m_clock() : CZTime::Us();
+}
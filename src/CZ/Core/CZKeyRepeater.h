@@ -0,0 +1,158 @@
+#ifndef CZ_CZKEYREPEATER_H
+#define CZ_CZKEYREPEATER_H
+
+#include <CZ/Core/CZObject.h>
+#include <CZ/Core/CZTimer.h>
+#include <CZ/Core/Events/CZKeyboardKeyEvent.h>
+#include <functional>
+#include <memory>
+
+/**
+ * @brief Key repeat engine for a single seat.
+ *
+ * Feed it the key events of a seat after CZKeymap::feed() has filled their symbol and text. When a repeatable
+ * key is pressed, a copy of the event is kept and, after the repeat delay of the keymap, the callback receives
+ * it again with `isRepeat` set, once per repeat interval, until the key is released or another repeatable key
+ * is pressed. The symbol and text of the press are reused, so repeats never call into xkb.
+ *
+ * Repeats are scheduled at absolute times (press time + delay + n * rate) and each event is timestamped with
+ * its scheduled time instead of the time it was dispatched, so late wakeups do not accumulate drift. A single
+ * CZTimer is armed at a time. If the loop falls behind and several repeats are due at once, the missedPolicy()
+ * decides whether they are all delivered or collapsed into one.
+ *
+ * @code
+ * CZKeyRepeater repeater { keymap, [](const CZKeyboardKeyEvent &e) {
+ *     CZCore::Get()->sendEvent(e, *focus);
+ * }};
+ * ...
+ * keymap->feed(event);
+ * repeater.handleEvent(event);
+ * @endcode
+ */
+class CZ::CZKeyRepeater : public CZObject
+{
+public:
+
+    /**
+     * @brief Source of monotonic time in microseconds.
+     */
+    using Clock = UInt64(*)();
+
+    /**
+     * @brief Receives each synthesized repeat event.
+     */
+    using Callback = std::function<void(const CZKeyboardKeyEvent &event)>;
+
+    /**
+     * @brief What to do with repeats that were due while the loop was busy.
+     */
+    enum class MissedPolicy
+    {
+        /// Deliver only the most recent one, keeping the schedule
+        Drop,
+
+        /// Deliver all of them in a burst of up to maxCatchUp() events, each with its scheduled timestamp
+        CatchUp
+    };
+
+    /**
+     * @brief Constructs an idle repeater.
+     *
+     * @param keymap Keymap providing the repeatable keys and the repeat info, can be changed with setKeymap().
+     * @param callback Called for each repeat event.
+     */
+    CZKeyRepeater(std::shared_ptr<CZKeymap> keymap, const Callback &callback) noexcept;
+
+    /**
+     * @brief Processes a key event of the seat.
+     *
+     * Pressing a repeatable key starts repeating it, releasing it stops. Non-repeatable keys (e.g. modifiers)
+     * do not affect the current repeat. Events with `isRepeat` set are ignored.
+     */
+    void handleEvent(const CZKeyboardKeyEvent &event) noexcept;
+
+    /**
+     * @brief Stops repeating, e.g. when the keyboard focus changes.
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Delivers the repeats due at the current time of the clock and schedules the next one.
+     *
+     * Called by the internal timer. Can be called manually along with a virtual clock.
+     *
+     * @return Number of events delivered.
+     */
+    UInt32 update() noexcept;
+
+    /**
+     * @brief Whether a key is being repeated (including the initial delay).
+     */
+    bool isRepeating() const noexcept { return m_active; }
+
+    /**
+     * @brief Code of the key being repeated, only valid if isRepeating().
+     */
+    UInt32 code() const noexcept { return m_event.code; }
+
+    /**
+     * @brief Scheduled time of the next repeat in microseconds, only valid if isRepeating().
+     */
+    UInt64 nextRepeatUs() const noexcept { return m_nextUs; }
+
+    /**
+     * @brief Number of repeats delivered for the current key.
+     */
+    UInt32 repeatCount() const noexcept { return m_count; }
+
+    /**
+     * @brief Replaces the keymap, stopping the current repeat.
+     */
+    void setKeymap(std::shared_ptr<CZKeymap> keymap) noexcept;
+    std::shared_ptr<CZKeymap> keymap() const noexcept { return m_keymap; }
+
+    void setCallback(const Callback &callback) noexcept { m_callback = callback; }
+    const Callback &callback() const noexcept { return m_callback; }
+
+    /**
+     * @brief Policy for repeats that were missed under load, Drop by default.
+     */
+    void setMissedPolicy(MissedPolicy policy) noexcept { m_policy = policy; }
+    MissedPolicy missedPolicy() const noexcept { return m_policy; }
+
+    /**
+     * @brief Maximum number of events delivered per update() with the CatchUp policy, 8 by default.
+     *
+     * Older repeats beyond the limit are dropped.
+     */
+    void setMaxCatchUp(UInt32 max) noexcept { m_maxCatchUp = max > 0 ? max : 1; }
+    UInt32 maxCatchUp() const noexcept { return m_maxCatchUp; }
+
+    /**
+     * @brief Replaces the clock, nullptr restores CZTime::Us().
+     */
+    void setClock(Clock clock) noexcept { m_clock = clock; }
+
+private:
+    void onRepeatInfoChanged() noexcept;
+    bool loadRepeatInfo() noexcept;
+    void schedule(UInt64 nowUs) noexcept;
+    UInt64 now() const noexcept;
+    std::shared_ptr<CZKeymap> m_keymap;
+    CZListener *m_repeatInfoListener {};
+    Callback m_callback;
+    CZKeyboardKeyEvent m_event;
+    CZTimer m_timer;
+    Clock m_clock {};
+    UInt64 m_pressUs {};
+    UInt64 m_nextUs {};
+    UInt64 m_delayUs {};
+    UInt64 m_intervalUs {};
+    UInt32 m_count {};
+    UInt32 m_serial {};
+    UInt32 m_maxCatchUp { 8 };
+    MissedPolicy m_policy { MissedPolicy::Drop };
+    bool m_active { false };
+};
+
+#endif // CZ_CZKEYREPEATER_H
@@ -0,0 +1,194 @@
+#ifndef CZ_CZKEYSET_H
+#define CZ_CZKEYSET_H
+
+#include <CZ/Core/Cuarzo.h>
+#include <linux/input-event-codes.h>
+#include <array>
+#include <bit>
+#include <initializer_list>
+
+/**
+ * @brief Fixed-size set of Linux key codes.
+ *
+ * Stores one bit per code of `linux/input-event-codes.h` (below `KEY_CNT`) plus a running count, so testing,
+ * adding and removing a key, checking whether any key is held and counting them are all O(1). Queries
+ * against a mask (e.g. all modifier keys) are a dozen word-wise ANDs and popcounts. Iteration visits the
+ * codes in ascending order without allocating.
+ *
+ * @code
+ * if (keymap->pressedKeys().test(KEY_LEFTCTRL))
+ *     ...
+ *
+ * for (UInt32 code : keymap->pressedKeys())
+ *     ...
+ * @endcode
+ */
+class CZ::CZKeySet
+{
+public:
+
+    /// Number of representable codes, codes at or above it are ignored
+    static constexpr UInt32 Capacity { KEY_CNT };
+
+    /**
+     * @brief Constructs an empty set.
+     */
+    constexpr CZKeySet() noexcept = default;
+
+    /**
+     * @brief Constructs a set from a list of codes, e.g. `CZKeySet { KEY_LEFTCTRL, KEY_RIGHTCTRL }`.
+     */
+    CZKeySet(std::initializer_list<UInt32> codes) noexcept
+    {
+        for (UInt32 code : codes)
+            set(code);
+    }
+
+    /**
+     * @brief Forward iterator over the codes in the set, in ascending order.
+     */
+    class Iterator
+    {
+    public:
+        UInt32 operator*() const noexcept { return m_word * 64 + std::countr_zero(m_bits); }
+
+        Iterator &operator++() noexcept
+        {
+            m_bits &= m_bits - 1;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==(const Iterator &other) const noexcept { return m_word == other.m_word && m_bits == other.m_bits; }
+
+    private:
+        friend class CZKeySet;
+        Iterator(const CZKeySet *set, UInt32 word) noexcept :
+            m_set(set), m_word(word), m_bits(word < Words ? set->m_words[word] : 0) { skipEmpty(); }
+
+        void skipEmpty() noexcept
+        {
+            while (m_bits == 0 && m_word < Words)
+                if (++m_word < Words)
+                    m_bits = m_set->m_words[m_word];
+        }
+
+        const CZKeySet *m_set;
+        UInt32 m_word;
+        UInt64 m_bits;
+    };
+
+    /**
+     * @brief Whether the code is in the set.
+     */
+    bool test(UInt32 code) const noexcept
+    {
+        return code < Capacity && (m_words[code / 64] & Bit(code)) != 0;
+    }
+
+    /**
+     * @brief Adds a code.
+     *
+     * @return `false` if it was already in the set or is out of range.
+     */
+    bool set(UInt32 code) noexcept
+    {
+        if (code >= Capacity || test(code))
+            return false;
+
+        m_words[code / 64] |= Bit(code);
+        m_count++;
+        return true;
+    }
+
+    /**
+     * @brief Removes a code.
+     *
+     * @return `false` if it was not in the set.
+     */
+    bool reset(UInt32 code) noexcept
+    {
+        if (!test(code))
+            return false;
+
+        m_words[code / 64] &= ~Bit(code);
+        m_count--;
+        return true;
+    }
+
+    /**
+     * @brief Removes all codes.
+     */
+    void reset() noexcept
+    {
+        m_words = {};
+        m_count = 0;
+    }
+
+    /**
+     * @brief Whether at least one code is in the set.
+     */
+    bool any() const noexcept { return m_count > 0; }
+
+    /**
+     * @brief Whether at least one code of the mask is in the set, e.g. any modifier key.
+     */
+    bool any(const CZKeySet &mask) const noexcept
+    {
+        for (UInt32 i = 0; i < Words; i++)
+            if (m_words[i] & mask.m_words[i])
+                return true;
+
+        return false;
+    }
+
+    /**
+     * @brief Whether the set is empty.
+     */
+    bool none() const noexcept { return m_count == 0; }
+
+    /**
+     * @brief Number of codes in the set.
+     */
+    UInt32 count() const noexcept { return m_count; }
+
+    /**
+     * @brief Number of codes of the mask in the set, e.g. to count held modifiers.
+     */
+    UInt32 count(const CZKeySet &mask) const noexcept
+    {
+        UInt32 n { 0 };
+
+        // Most words are empty, skip them in case popcount is not a single instruction on the target
+        for (UInt32 i = 0; i < Words; i++)
+            if (const UInt64 word { m_words[i] & mask.m_words[i] })
+                n += std::popcount(word);
+
+        return n;
+    }
+
+    /**
+     * @brief Whether every code of the mask is in the set.
+     */
+    bool contains(const CZKeySet &mask) const noexcept
+    {
+        for (UInt32 i = 0; i < Words; i++)
+            if ((m_words[i] & mask.m_words[i]) != mask.m_words[i])
+                return false;
+
+        return true;
+    }
+
+    Iterator begin() const noexcept { return { this, 0 }; }
+    Iterator end() const noexcept { return { this, Words }; }
+
+    bool operator==(const CZKeySet &other) const noexcept = default;
+
+private:
+    static constexpr UInt32 Words { (Capacity + 63) / 64 };
+    static constexpr UInt64 Bit(UInt32 code) noexcept { return UInt64(1) << (code % 64); }
+    std::array<UInt64, Words> m_words {};
+    UInt32 m_count { 0 };
+};
+
+#endif // CZ_CZKEYSET_H
@@ -2,10 +2,192 @@
 #include <CZ/Core/CZSharedMemory.h>
 #include <CZ/Core/CZKeymap.h>
 #include <CZ/Core/CZLog.h>
+#include <algorithm>
 #include <cstring>
+#include <filesystem>
+#include <format>
+#include <mutex>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace CZ;
 
+/*
+ * Persistent cache of serialized keymaps, see CZ_CORE_KEYMAP_CACHE.
+ *
+ * Compiling a keymap from RMLVO names resolves the rules and parses dozens of xkeyboard-config files,
+ * while the serialized result loads much faster. Files are named after a hash of the key and start
+ * with the key itself followed by a newline, which is verified on load.
+ */
+namespace KeymapCache
+{
+    static constexpr size_t MaxFiles { 8 };
+
+    static bool Enabled() noexcept
+    {
+        const char *env { getenv("CZ_CORE_KEYMAP_CACHE") };
+        return !env || atoi(env) != 0;
+    }
+
+    static std::filesystem::path Dir() noexcept
+    {
+        if (const char *cache { getenv("XDG_CACHE_HOME") }; cache && *cache)
+            return std::filesystem::path(cache) / "cuarzo" / "keymaps";
+
+        if (const char *home { getenv("HOME") }; home && *home)
+            return std::filesystem::path(home) / ".cache" / "cuarzo" / "keymaps";
+
+        return {};
+    }
+
+    // Everything the compiled keymap depends on: the names, the env defaults and the xkb data directories
+    static std::string Key(const xkb_rule_names &names) noexcept
+    {
+        std::string key { "CZKeymap 1" };
+
+        const auto add = [&key](const char *value) {
+            key += '|';
+
+            for (; value && *value; value++)
+                key += *value == '\n' ? ' ' : *value;
+        };
+
+        const auto addMTime = [&key](const std::filesystem::path &path) {
+            struct stat st;
+
+            if (stat(path.c_str(), &st) == 0)
+                key += std::format("|{}.{}", st.st_mtim.tv_sec, st.st_mtim.tv_nsec);
+            else
+                key += "|-";
+        };
+
+        add(names.rules);
+        add(names.model);
+        add(names.layout);
+        add(names.variant);
+        add(names.options);
+
+        for (const char *env : { "XKB_DEFAULT_RULES", "XKB_DEFAULT_MODEL", "XKB_DEFAULT_LAYOUT", "XKB_DEFAULT_VARIANT",
+                                 "XKB_DEFAULT_OPTIONS", "XKB_CONFIG_ROOT", "XKB_CONFIG_EXTRA_PATH", "HOME", "XDG_CONFIG_HOME" })
+            add(getenv(env));
+
+        // Package updates replace files, which touches their directories
+        const char *rootEnv { getenv("XKB_CONFIG_ROOT") };
+        const std::filesystem::path root { rootEnv && *rootEnv ? rootEnv : "/usr/share/X11/xkb" };
+
+        for (const char *dir : { "", "rules", "keycodes", "types", "compat", "symbols" })
+            addMTime(root / dir);
+
+        addMTime("/etc/xkb");
+
+        if (const char *config { getenv("XDG_CONFIG_HOME") }; config && *config)
+            addMTime(std::filesystem::path(config) / "xkb");
+        else if (const char *home { getenv("HOME") }; home && *home)
+            addMTime(std::filesystem::path(home) / ".config" / "xkb");
+
+        if (const char *home { getenv("HOME") }; home && *home)
+            addMTime(std::filesystem::path(home) / ".xkb");
+
+        return key;
+    }
+
+    static std::filesystem::path File(const std::filesystem::path &dir, const std::string &key) noexcept
+    {
+        // FNV-1a, stable across builds
+        UInt64 hash { 0xcbf29ce484222325 };
+
+        for (char c : key)
+            hash = (hash ^ static_cast<UInt8>(c)) * 0x100000001b3;
+
+        return dir / std::format("{:016x}.xkb", hash);
+    }
+
+    // Returns the offset of the keymap within data, or 0 on a miss
+    static size_t Load(const std::filesystem::path &file, const std::string &key, std::string &data) noexcept
+    {
+        const int fd { open(file.c_str(), O_RDONLY | O_CLOEXEC) };
+
+        if (fd < 0)
+            return 0;
+
+        struct stat st;
+        size_t read { 0 };
+
+        if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) > key.size() + 1)
+        {
+            data.resize(st.st_size);
+
+            while (read < data.size())
+            {
+                const ssize_t n { ::read(fd, data.data() + read, data.size() - read) };
+
+                if (n <= 0)
+                    break;
+
+                read += n;
+            }
+        }
+
+        close(fd);
+
+        if (read != data.size() || read == 0 || data.compare(0, key.size(), key) != 0 || data[key.size()] != '\n')
+            return 0;
+
+        return key.size() + 1;
+    }
+
+    static void Store(const std::filesystem::path &dir, const std::filesystem::path &file, const std::string &key, const char *keymap, size_t size) noexcept
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+
+        if (ec)
+        {
+            CZLog(CZWarning, CZLN, "Failed to create the keymap cache directory {}: {}", dir.string(), ec.message());
+            return;
+        }
+
+        // Written aside and renamed so concurrent readers never see partial files
+        const std::filesystem::path tmp { file.string() + std::format(".{}.tmp", getpid()) };
+        const int fd { open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) };
+
+        if (fd < 0)
+        {
+            CZLog(CZWarning, CZLN, "Failed to write the keymap cache file {}", tmp.string());
+            return;
+        }
+
+        const std::string header { key + '\n' };
+        const bool ok { write(fd, header.data(), header.size()) == static_cast<ssize_t>(header.size()) &&
+                        write(fd, keymap, size) == static_cast<ssize_t>(size) };
+        close(fd);
+
+        if (!ok || rename(tmp.c_str(), file.c_str()) != 0)
+        {
+            CZLog(CZWarning, CZLN, "Failed to write the keymap cache file {}", file.string());
+            unlink(tmp.c_str());
+            return;
+        }
+
+        // Keys change with every xkeyboard-config update, drop the oldest entries
+        std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entries;
+
+        for (const auto &entry : std::filesystem::directory_iterator(dir, ec))
+            if (entry.path().extension() == ".xkb")
+                entries.emplace_back(entry.last_write_time(ec), entry.path());
+
+        if (entries.size() <= MaxFiles)
+            return;
+
+        std::sort(entries.begin(), entries.end());
+
+        for (size_t i = 0; i < entries.size() - MaxFiles; i++)
+            std::filesystem::remove(entries[i].second, ec);
+    }
+}
+
 std::shared_ptr<CZKeymap> CZKeymap::MakeServer(const xkb_rule_names &names) noexcept
 {
     auto *context { xkb_context_new(XKB_CONTEXT_NO_FLAGS) };
@@ -16,7 +198,40 @@ std::shared_ptr<CZKeymap> CZKeymap::MakeServer(const xkb_rule_names &names) noex
         return {};
     }
 
-    auto *keymap { xkb_keymap_new_from_names(context, &names, XKB_KEYMAP_COMPILE_NO_FLAGS) };
+    const bool useCache { KeymapCache::Enabled() };
+    std::filesystem::path cacheDir, cacheFile;
+    std::string cacheKey, cached;
+    size_t cachedOffset { 0 };
+    xkb_keymap *keymap {};
+
+    if (useCache)
+    {
+        cacheDir = KeymapCache::Dir();
+
+        if (!cacheDir.empty())
+        {
+            cacheKey = KeymapCache::Key(names);
+            cacheFile = KeymapCache::File(cacheDir, cacheKey);
+            cachedOffset = KeymapCache::Load(cacheFile, cacheKey, cached);
+        }
+    }
+
+    if (cachedOffset > 0)
+    {
+        keymap = xkb_keymap_new_from_buffer(context, cached.data() + cachedOffset, cached.size() - cachedOffset,
+                                            XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
+
+        if (keymap)
+            CZLog(CZDebug, CZLN, "Keymap loaded from cache {}", cacheFile.string());
+        else
+        {
+            CZLog(CZWarning, CZLN, "Invalid keymap cache file {}. Recompiling...", cacheFile.string());
+            cachedOffset = 0;
+        }
+    }
+
+    if (!keymap)
+        keymap = xkb_keymap_new_from_names(context, &names, XKB_KEYMAP_COMPILE_NO_FLAGS);
 
     if (!keymap)
     {
@@ -35,19 +250,37 @@ std::shared_ptr<CZKeymap> CZKeymap::MakeServer(const xkb_rule_names &names) noex
         return {};
     }
 
-    auto *str { xkb_keymap_get_as_string(keymap, XKB_KEYMAP_FORMAT_TEXT_V1) };
+    // The cached text is the output of xkb_keymap_get_as_string()
+    char *str { nullptr };
+    const char *text;
+    size_t strSize;
 
-    if (!str)
+    if (cachedOffset > 0)
     {
-        CZLog(CZError, CZLN, "Failed to get xkb_keymap as string");
-        xkb_state_unref(state);
-        xkb_keymap_unref(keymap);
-        xkb_context_unref(context);
-        return {};
+        text = cached.data() + cachedOffset;
+        strSize = cached.size() - cachedOffset;
+    }
+    else
+    {
+        str = xkb_keymap_get_as_string(keymap, XKB_KEYMAP_FORMAT_TEXT_V1);
+
+        if (!str)
+        {
+            CZLog(CZError, CZLN, "Failed to get xkb_keymap as string");
+            xkb_state_unref(state);
+            xkb_keymap_unref(keymap);
+            xkb_context_unref(context);
+            return {};
+        }
+
+        text = str;
+        strSize = strlen(str);
+
+        if (!cacheFile.empty())
+            KeymapCache::Store(cacheDir, cacheFile, cacheKey, str, strSize);
     }
 
-    const auto strSize { strlen(str) };
-    auto shm { CZSharedMemory::Make(strSize, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600) };
+    auto shm { CZSharedMemory::MakeMemfd(strSize, "cz-keymap") };
 
     if (!shm)
     {
@@ -59,14 +292,16 @@ std::shared_ptr<CZKeymap> CZKeymap::MakeServer(const xkb_rule_names &names) noex
         return {};
     }
 
-    memcpy(shm->map(), str, strSize);
+    memcpy(shm->map(), text, strSize);
+    free(str);
 
-    auto roFd { shm_open(shm->name().c_str(), O_RDONLY | O_CLOEXEC, 0600) };
+    // Clients can map the sealed keymap but neither modify nor truncate it
+    shm->seal();
+    auto roFd { shm->openReadOnly() };
 
     if (roFd < 0)
     {
         CZLog(CZError, CZLN, "Failed to create read only fd");
-        free(str);
         xkb_state_unref(state);
         xkb_keymap_unref(keymap);
         xkb_context_unref(context);
@@ -76,6 +311,110 @@ std::shared_ptr<CZKeymap> CZKeymap::MakeServer(const xkb_rule_names &names) noex
     return std::shared_ptr<CZKeymap>(new CZKeymap(context, keymap, state, roFd, strSize, false));
 }
 
+namespace
+{
+    /*
+     * Process-wide cache of client keymaps.
+     *
+     * Clients usually receive the same keymap many times (reconnects, new seats, toolkits creating one per
+     * surface), so compiled keymaps are kept in a small LRU keyed by a hash of their text, and compose
+     * tables are kept per locale. Every client keymap shares a single xkb_context and only gets its own
+     * xkb_state and xkb_compose_state.
+     *
+     * xkbcommon reference counts are not atomic, so every ref/unref of the shared objects happens with
+     * the mutex held.
+     */
+    struct ClientCache
+    {
+        static constexpr size_t Capacity { 4 };
+
+        struct Keymap
+        {
+            size_t hash;
+            std::string text;
+            xkb_keymap *keymap;
+        };
+
+        struct ComposeTable
+        {
+            std::string locale;
+            xkb_compose_table *table; // nullptr if the locale has none
+        };
+
+        std::mutex mutex;
+        xkb_context *sharedContext {};
+        std::vector<Keymap> keymaps; // Most recently used first
+        std::vector<ComposeTable> composeTables;
+
+        // Never destroyed, keymaps may outlive static storage
+        static ClientCache &Get() noexcept
+        {
+            static ClientCache *cache { new ClientCache() };
+            return *cache;
+        }
+
+        // The following return new references, the mutex must be held
+
+        xkb_context *context() noexcept
+        {
+            if (!sharedContext)
+                sharedContext = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+
+            return sharedContext ? xkb_context_ref(sharedContext) : nullptr;
+        }
+
+        xkb_keymap *keymap(std::string_view text, size_t hash) noexcept
+        {
+            for (auto it = keymaps.begin(); it != keymaps.end(); it++)
+            {
+                if (it->hash == hash && it->text == text)
+                {
+                    std::rotate(keymaps.begin(), it, it + 1);
+                    return xkb_keymap_ref(keymaps.front().keymap);
+                }
+            }
+
+            auto *keymap { xkb_keymap_new_from_buffer(sharedContext, text.data(), text.size(), XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS) };
+
+            if (!keymap)
+                return nullptr;
+
+            if (keymaps.size() == Capacity)
+            {
+                xkb_keymap_unref(keymaps.back().keymap);
+                keymaps.pop_back();
+            }
+
+            keymaps.insert(keymaps.begin(), { hash, std::string(text), keymap });
+            return xkb_keymap_ref(keymap);
+        }
+
+        xkb_compose_table *composeTable(const char *locale) noexcept
+        {
+            for (const auto &entry : composeTables)
+                if (entry.locale == locale)
+                    return entry.table ? xkb_compose_table_ref(entry.table) : nullptr;
+
+            auto *table { xkb_compose_table_new_from_locale(sharedContext, locale, XKB_COMPOSE_COMPILE_NO_FLAGS) };
+            composeTables.push_back({ locale, table });
+            return table ? xkb_compose_table_ref(table) : nullptr;
+        }
+
+        void clear() noexcept
+        {
+            for (const auto &entry : keymaps)
+                xkb_keymap_unref(entry.keymap);
+
+            for (const auto &entry : composeTables)
+                if (entry.table)
+                    xkb_compose_table_unref(entry.table);
+
+            keymaps.clear();
+            composeTables.clear();
+        }
+    };
+}
+
 std::shared_ptr<CZ::CZKeymap> CZKeymap::MakeClient(int fd, size_t size) noexcept
 {
     const char *map { (const char*)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0) };
@@ -86,22 +425,30 @@ std::shared_ptr<CZ::CZKeymap> CZKeymap::MakeClient(int fd, size_t size) noexcept
         return {};
     }
 
-    auto *context { xkb_context_new(XKB_CONTEXT_NO_FLAGS) };
+    // The size sent by servers usually includes the null terminator
+    const std::string_view text { map, strnlen(map, size) };
+    const size_t hash { std::hash<std::string_view>{}(text) };
+
+    auto &cache { ClientCache::Get() };
+    std::unique_lock lock { cache.mutex };
+    auto *context { cache.context() };
 
     if (!context)
     {
+        lock.unlock();
         CZLog(CZError, CZLN, "Failed to create xkb_context");
         munmap((void*)map, size);
         return {};
     }
 
-    auto *keymap { xkb_keymap_new_from_string(context, map, XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS) };
-    munmap((void*)map, size);
+    auto *keymap { cache.keymap(text, hash) };
 
     if (!keymap)
     {
-        CZLog(CZError, CZLN, "Failed to create xkb_keymap");
         xkb_context_unref(context);
+        lock.unlock();
+        CZLog(CZError, CZLN, "Failed to create xkb_keymap");
+        munmap((void*)map, size);
         return {};
     }
 
@@ -109,20 +456,37 @@ std::shared_ptr<CZ::CZKeymap> CZKeymap::MakeClient(int fd, size_t size) noexcept
 
     if (!state)
     {
-        CZLog(CZError, CZLN, "Failed to create xkb_state");
         xkb_keymap_unref(keymap);
         xkb_context_unref(context);
+        lock.unlock();
+        CZLog(CZError, CZLN, "Failed to create xkb_state");
+        munmap((void*)map, size);
         return {};
     }
 
+    lock.unlock();
+    munmap((void*)map, size);
     return std::shared_ptr<CZKeymap>(new CZKeymap(context, keymap, state, -1, 0, true));
 }
 
+void CZKeymap::ClearClientCache() noexcept
+{
+    auto &cache { ClientCache::Get() };
+    std::lock_guard lock { cache.mutex };
+    cache.clear();
+}
+
 CZKeymap::~CZKeymap() noexcept
 {
     if (m_fd >= 0)
         close(m_fd);
 
+    // Client keymaps share their context, keymap and compose table
+    std::unique_lock<std::mutex> lock;
+
+    if (m_isClient)
+        lock = std::unique_lock { ClientCache::Get().mutex };
+
     if (m_composeState)
         xkb_compose_state_unref(m_composeState);
 
@@ -156,14 +520,17 @@ xkb_compose_status CZKeymap::composeStatus() const noexcept
 
 void CZKeymap::feed(const CZKeyboardKeyEvent &e) noexcept
 {
-    static char buffer[128];
     const auto code { e.code + 8 };
 
-    if (e.isPressed)
+    if (e.code >= CZKeySet::Capacity)
     {
-        const auto res { m_pressedKeys.insert(e.code) };
+        CZLog(CZWarning, CZLN, "Invalid key code {}. Ignoring event...", e.code);
+        return;
+    }
 
-        if (!res.second)
+    if (e.isPressed)
+    {
+        if (!m_pressedKeys.set(e.code))
         {
             CZLog(CZWarning, CZLN, "Key code {} already pressed. Ignoring event...", e.code);
             return;
@@ -184,38 +551,37 @@ void CZKeymap::feed(const CZKeyboardKeyEvent &e) noexcept
         switch (e.composeStatus)
         {
         case XKB_COMPOSE_NOTHING:
-            xkb_state_key_get_utf8(m_state, code, buffer, sizeof(buffer));
-            e.utf8 = buffer;
+            e.utf8.write([this, code](char *buffer, size_t size) {
+                return xkb_state_key_get_utf8(m_state, code, buffer, size);
+            });
             break;
         case XKB_COMPOSE_COMPOSED:
-            xkb_compose_state_get_utf8(m_composeState, buffer, sizeof(buffer));
+            e.utf8.write([this](char *buffer, size_t size) {
+                return xkb_compose_state_get_utf8(m_composeState, buffer, size);
+            });
             xkb_compose_state_reset(m_composeState);
-            e.utf8 = buffer;
             break;
         case XKB_COMPOSE_COMPOSING:
         case XKB_COMPOSE_CANCELLED:
-            e.utf8 = "";
+            e.utf8.clear();
         }
     }
     else
     {
-        auto it { m_pressedKeys.find(e.code) };
-
-        if (it == m_pressedKeys.end())
+        if (!m_pressedKeys.reset(e.code))
         {
             CZLog(CZWarning, CZLN, "Key code {} already released. Ignoring event...", e.code);
             return;
         }
 
-        m_pressedKeys.erase(it);
-
         if (!isClient())
             xkb_state_update_key(m_state, code, XKB_KEY_UP);
 
         e.symbol = xkb_state_key_get_one_sym(m_state, code);
         e.composeStatus = composeStatus();
-        xkb_state_key_get_utf8(m_state, code, buffer, sizeof(buffer));
-        e.utf8 = buffer;
+        e.utf8.write([this, code](char *buffer, size_t size) {
+            return xkb_state_key_get_utf8(m_state, code, buffer, size);
+        });
     }
 
     m_modifiers.depressed = xkb_state_serialize_mods(state(), XKB_STATE_MODS_DEPRESSED);
@@ -223,7 +589,7 @@ void CZKeymap::feed(const CZKeyboardKeyEvent &e) noexcept
     m_modifiers.locked = xkb_state_serialize_mods(state(), XKB_STATE_MODS_LOCKED);
     m_modifiers.group = xkb_state_serialize_layout(state(), XKB_STATE_LAYOUT_EFFECTIVE);
 
-    CZLog(CZTrace, "Key Code: {}, UTF8: {}, State: {}", e.code, e.utf8, e.isPressed ? "Pressed" : "Released");
+    CZLog(CZTrace, "Key Code: {}, UTF8: {}, State: {}", e.code, e.utf8.view(), e.isPressed ? "Pressed" : "Released");
 }
 
 void CZKeymap::setRepeatInfo(Int32 delayMs, Int32 rateMs) noexcept
@@ -257,6 +623,11 @@ static std::string localePostDotToUpper(const std::string &locale)
 
 void CZKeymap::loadComposeTable(const char *locale) noexcept
 {
+    std::unique_lock<std::mutex> lock;
+
+    if (m_isClient)
+        lock = std::unique_lock { ClientCache::Get().mutex };
+
     if (m_composeState)
     {
         xkb_compose_state_unref(m_composeState);
@@ -278,7 +649,10 @@ void CZKeymap::loadComposeTable(const char *locale) noexcept
     if (!locale || !*locale)
         locale = "C";
 
-    m_composeTable = xkb_compose_table_new_from_locale(m_context, locale, XKB_COMPOSE_COMPILE_NO_FLAGS);
+    if (m_isClient)
+        m_composeTable = ClientCache::Get().composeTable(locale);
+    else
+        m_composeTable = xkb_compose_table_new_from_locale(m_context, locale, XKB_COMPOSE_COMPILE_NO_FLAGS);
 
     if (!m_composeTable)
         goto fail;
@@ -294,6 +668,9 @@ void CZKeymap::loadComposeTable(const char *locale) noexcept
     CZLog(CZInfo, CZLN, "Using locale {}", locale);
     return;
 fail:
+    if (lock.owns_lock())
+        lock.unlock();
+
     // Try with uppercase
     if (locale)
     {
@@ -3,7 +3,7 @@
 
 #include <CZ/Core/CZObject.h>
 #include <CZ/Core/CZKeyModifiers.h>
-#include <unordered_set>
+#include <CZ/Core/CZKeySet.h>
 #include <xkbcommon/xkbcommon.h>
 #include <xkbcommon/xkbcommon-compose.h>
 #include <memory>
@@ -13,10 +13,19 @@ class CZ::CZKeymap : public CZObject
 public:
     static std::shared_ptr<CZKeymap> MakeServer(const xkb_rule_names &names) noexcept;
     static std::shared_ptr<CZKeymap> MakeClient(int fd, size_t size) noexcept; // Does not take ownership
+
+    /**
+     * @brief Releases the keymaps and compose tables cached for MakeClient().
+     *
+     * Client keymaps with the same text share a single compiled xkb_keymap. The few most recently used ones
+     * are kept alive even when no client keymap references them, so that reconnections do not recompile them.
+     * Keymaps still in use are not affected.
+     */
+    static void ClearClientCache() noexcept;
     bool isClient() const noexcept { return m_isClient; }
     ~CZKeymap() noexcept;
 
-    const std::unordered_set<UInt32> &pressedKeys() const noexcept { return m_pressedKeys; }
+    const CZKeySet &pressedKeys() const noexcept { return m_pressedKeys; }
 
     // These always exist
     xkb_context *context() const noexcept { return m_context; }
@@ -57,7 +66,7 @@ private:
         loadComposeTable();
     }
     void loadComposeTable(const char *locale = nullptr) noexcept;
-    std::unordered_set<UInt32> m_pressedKeys;
+    CZKeySet m_pressedKeys;
     xkb_context *m_context;
     xkb_keymap *m_keymap;
     xkb_state *m_state;
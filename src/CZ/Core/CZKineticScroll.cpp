@@ -0,0 +1,197 @@
+#include <CZ/Core/CZKineticScroll.h>
+#include <CZ/Core/CZTime.h>
+#include <CZ/Core/Events/CZPointerScrollEvent.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace CZ;
+
+// Longest step of the simulation, keeps bounds crossings accurate after long frames
+static constexpr Float64 MaxStepS { 0.004 };
+
+// Distance to the bounds below which the spring is considered settled
+static constexpr Float64 SpringRestDistance { 0.5 };
+
+CZKineticScroll::CZKineticScroll(Callback onUpdate, Callback onFinish) noexcept :
+    CZAnimation(onUpdate, onFinish, false),
+    m_bounds(SkRect::MakeLTRB(-SK_ScalarInfinity, -SK_ScalarInfinity, SK_ScalarInfinity, SK_ScalarInfinity))
+{
+    setStiffness(m_stiffness);
+}
+
+bool CZKineticScroll::handleEvent(const CZPointerScrollEvent &event) noexcept
+{
+    if (event.source != CZPointerScrollEvent::Finger && event.source != CZPointerScrollEvent::Continuous)
+    {
+        if (m_phase != Phase::Idle)
+            cancel();
+
+        return false;
+    }
+
+    // Each axis stops on its own, the fingers may keep scrolling the other one
+    const bool stopX { event.hasX && event.axes.x() == 0.f && m_x.tracking };
+    const bool stopY { event.hasY && event.axes.y() == 0.f && m_y.tracking };
+
+    if (stopX || stopY)
+    {
+        const SkPoint velocity { m_tracker.velocity(event.us) };
+
+        if (stopX)
+            release(m_x, velocity.x(), m_bounds.left(), m_bounds.right());
+
+        if (stopY)
+            release(m_y, velocity.y(), m_bounds.top(), m_bounds.bottom());
+
+        if (!m_x.tracking && !m_y.tracking)
+            m_tracker.reset();
+
+        if (!m_x.atRest || !m_y.atRest)
+            start();
+    }
+
+    // Locked axes do not move
+    const bool moveX { event.hasX && event.axes.x() != 0.f && !locked(m_bounds.left(), m_bounds.right()) };
+    const bool moveY { event.hasY && event.axes.y() != 0.f && !locked(m_bounds.top(), m_bounds.bottom()) };
+
+    if (moveX || moveY)
+    {
+        // A new gesture, motion from a previous one would skew the velocity
+        if (!m_x.tracking && !m_y.tracking)
+            m_tracker.reset();
+
+        if (moveX)
+            m_x = { m_x.pos + event.axes.x(), 0.0, true, true };
+
+        if (moveY)
+            m_y = { m_y.pos + event.axes.y(), 0.0, true, true };
+
+        // The other axis may still be flinging
+        if (m_x.atRest && m_y.atRest)
+            CZAnimation::stop();
+
+        m_tracker.addSample(event.us, offset());
+    }
+
+    updatePhase();
+    return true;
+}
+
+void CZKineticScroll::fling(SkPoint velocity) noexcept
+{
+    CZAnimation::stop();
+    m_tracker.reset();
+
+    const bool slow { std::hypot(velocity.x(), velocity.y()) < m_minVelocity };
+    release(m_x, slow ? 0.0 : velocity.x(), m_bounds.left(), m_bounds.right());
+    release(m_y, slow ? 0.0 : velocity.y(), m_bounds.top(), m_bounds.bottom());
+    updatePhase();
+
+    if (m_phase == Phase::Flinging)
+        start();
+}
+
+void CZKineticScroll::cancel() noexcept
+{
+    CZAnimation::stop();
+    m_tracker.reset();
+    m_x = { m_x.pos, 0.0, true, false };
+    m_y = { m_y.pos, 0.0, true, false };
+    m_phase = Phase::Idle;
+}
+
+void CZKineticScroll::setOffset(SkPoint offset) noexcept
+{
+    m_x.pos = offset.x();
+    m_y.pos = offset.y();
+
+    // Avoid reading the jump as motion
+    m_tracker.reset();
+}
+
+SkPoint CZKineticScroll::velocity() const noexcept
+{
+    const SkPoint tracked { m_phase == Phase::Scrolling ? m_tracker.velocity() : SkPoint() };
+    return { m_x.tracking ? tracked.x() : static_cast<SkScalar>(m_x.vel),
+             m_y.tracking ? tracked.y() : static_cast<SkScalar>(m_y.vel) };
+}
+
+void CZKineticScroll::setStiffness(Float64 stiffness) noexcept
+{
+    m_stiffness = stiffness;
+    m_naturalFreq = CZSpringAnimation::NaturalFrequency(stiffness);
+}
+
+void CZKineticScroll::onStart() noexcept
+{
+    m_lastStepUs = now();
+}
+
+void CZKineticScroll::onUpdate() noexcept
+{
+    const UInt64 us { now() };
+    Float64 dt { us > m_lastStepUs ? static_cast<Float64>(us - m_lastStepUs) * 1e-6 : 0.0 };
+    m_lastStepUs = us;
+
+    while (dt > 0.0)
+    {
+        const Float64 h { std::min(dt, MaxStepS) };
+        step(m_x, m_bounds.left(), m_bounds.right(), h);
+        step(m_y, m_bounds.top(), m_bounds.bottom(), h);
+        dt -= h;
+    }
+
+    if (m_x.atRest && m_y.atRest)
+    {
+        updatePhase();
+        m_isRunning = false;
+    }
+}
+
+UInt64 CZKineticScroll::now() const noexcept
+{
+    return m_clock ? m_clock() : CZTime::Us();
+}
+
+void CZKineticScroll::step(Axis &axis, Float64 min, Float64 max, Float64 dt) noexcept
+{
+    if (axis.atRest)
+        return;
+
+    if (axis.pos < min || axis.pos > max)
+    {
+        const Float64 target { std::clamp(axis.pos, min, max) };
+        CZSpringAnimation::Step(axis.pos, axis.vel, target, m_naturalFreq, m_dampingRatio, dt);
+
+        if (std::abs(axis.pos - target) < SpringRestDistance && std::abs(axis.vel) < m_minVelocity)
+            axis = { target, 0.0, true, false };
+
+        return;
+    }
+
+    const Float64 decay { std::exp(-m_friction * dt) };
+    axis.pos += axis.vel * (1.0 - decay) / m_friction;
+    axis.vel *= decay;
+
+    if (std::abs(axis.vel) < m_minVelocity && axis.pos >= min && axis.pos <= max)
+        axis = { axis.pos, 0.0, true, false };
+}
+
+void CZKineticScroll::release(Axis &axis, Float64 velocity, Float64 min, Float64 max) noexcept
+{
+    if (locked(min, max))
+        velocity = 0.0;
+
+    const bool rest { std::abs(velocity) < m_minVelocity && axis.pos >= min && axis.pos <= max };
+    axis = { axis.pos, rest ? 0.0 : velocity, rest, false };
+}
+
+void CZKineticScroll::updatePhase() noexcept
+{
+    if (m_x.tracking || m_y.tracking)
+        m_phase = Phase::Scrolling;
+    else if (!m_x.atRest || !m_y.atRest)
+        m_phase = Phase::Flinging;
+    else
+        m_phase = Phase::Idle;
+}
@@ -0,0 +1,198 @@
+#ifndef CZ_CZKINETICSCROLL_H
+#define CZ_CZKINETICSCROLL_H
+
+#include <CZ/Core/CZAnimation.h>
+#include <CZ/Core/CZSpringAnimation.h>
+#include <CZ/Core/CZVelocityTracker.h>
+#include <CZ/skia/core/SkRect.h>
+
+/**
+ * @brief Shared scroll physics for CZPointerScrollEvent.
+ *
+ * Finger and continuous scroll deltas are accumulated into offset() while their velocity is tracked.
+ * When the fingers are lifted, signaled by an axis stop (a zero value on an axis), the animation starts
+ * and keeps moving that axis with its release velocity, decaying exponentially according to friction().
+ * Each axis stops on its own, so one can fling while the fingers keep scrolling the other.
+ *
+ * If bounds are set and the offset leaves them, either while scrolling or during the fling, it is pulled
+ * back to the nearest edge by a spring whose stiffness and damping ratio follow the same conventions as
+ * CZSpringAnimation.
+ *
+ * The simulation is stepped by the animation loop of CZCore using the clock set with setClock(), which
+ * defaults to CZTime::Us(). Replacing it with a virtual clock and calling CZCore::updateAnimations()
+ * manually makes runs deterministic. Handling events allocates nothing.
+ *
+ * @code
+ * CZKineticScroll scroll { [](CZAnimation *a) {
+ *     view->setScrollOffset(static_cast<CZKineticScroll*>(a)->offset());
+ * }};
+ * ...
+ * if (scroll.handleEvent(event))
+ *     view->setScrollOffset(scroll.offset());
+ * @endcode
+ */
+class CZ::CZKineticScroll : public CZAnimation
+{
+public:
+
+    /**
+     * @brief Source of monotonic time in microseconds.
+     */
+    using Clock = UInt64(*)();
+
+    /**
+     * @brief Scrolling phase.
+     */
+    enum class Phase
+    {
+        /// Not moving
+        Idle,
+
+        /// Following the fingers
+        Scrolling,
+
+        /// Decelerating or springing back after the fingers were lifted
+        Flinging
+    };
+
+    /**
+     * @brief Constructs an idle kinetic scroll at offset (0, 0).
+     *
+     * @param onUpdate Callback executed on every animation step, read offset() from it.
+     * @param onFinish Callback executed when the fling comes to rest.
+     */
+    CZKineticScroll(Callback onUpdate = nullptr, Callback onFinish = nullptr) noexcept;
+
+    /**
+     * @brief Processes a scroll event.
+     *
+     * Finger and continuous deltas stop the fling of their axis and are added to offset(), unless the axis is
+     * locked. An axis stop starts the fling of that axis. Other sources (e.g. mouse wheels) are not kinetic: they stop the fling and are left to the caller.
+     *
+     * @return `true` if the event was consumed and offset() may have changed.
+     */
+    bool handleEvent(const CZPointerScrollEvent &event) noexcept;
+
+    /**
+     * @brief Starts a fling with the given velocity, as if the fingers were lifted.
+     *
+     * @param velocity Initial velocity in units per second.
+     */
+    void fling(SkPoint velocity) noexcept;
+
+    /**
+     * @brief Stops the fling and discards the tracked motion.
+     *
+     * The offset is kept as is, even if outside the bounds.
+     */
+    void cancel() noexcept;
+
+    /**
+     * @brief The current phase.
+     */
+    Phase phase() const noexcept { return m_phase; }
+
+    /**
+     * @brief The accumulated scroll offset.
+     */
+    SkPoint offset() const noexcept { return { static_cast<SkScalar>(m_x.pos), static_cast<SkScalar>(m_y.pos) }; }
+
+    /**
+     * @brief Moves the offset, e.g. when the content is scrolled programmatically.
+     */
+    void setOffset(SkPoint offset) noexcept;
+
+    /**
+     * @brief The current velocity in units per second.
+     *
+     * While scrolling, the velocity estimated from the tracked motion.
+     */
+    SkPoint velocity() const noexcept;
+
+    /**
+     * @brief Range the offset is kept within, unbounded by default.
+     *
+     * Use an empty range on an axis (e.g. left equal to right) to lock it: its deltas and velocity are dropped.
+     */
+    const SkRect &bounds() const noexcept { return m_bounds; }
+    void setBounds(const SkRect &bounds) noexcept { m_bounds = bounds; }
+
+    /**
+     * @brief Exponential decay rate of the fling velocity per second, 2.0 by default.
+     *
+     * A fling released at velocity v travels v / friction units in total.
+     */
+    Float64 friction() const noexcept { return m_friction; }
+    void setFriction(Float64 friction) noexcept { m_friction = friction > 0.0 ? friction : 0.001; }
+
+    /**
+     * @brief Speed in units per second below which the fling stops, 20 by default.
+     *
+     * Releases slower than this do not start a fling.
+     */
+    Float64 minVelocity() const noexcept { return m_minVelocity; }
+    void setMinVelocity(Float64 velocity) noexcept { m_minVelocity = velocity; }
+
+    /**
+     * @brief Stiffness of the spring pulling the offset back within the bounds.
+     *
+     * Uses the same scale as CZSpringAnimation, CZSpringAnimation::StiffnessHigh by default.
+     */
+    Float64 stiffness() const noexcept { return m_stiffness; }
+    void setStiffness(Float64 stiffness) noexcept;
+
+    /**
+     * @brief Damping ratio of the bounds spring, CZSpringAnimation::DampingRatioNoBouncy by default.
+     */
+    Float64 dampingRatio() const noexcept { return m_dampingRatio; }
+    void setDampingRatio(Float64 ratio) noexcept { m_dampingRatio = ratio; }
+
+    /**
+     * @brief Sets the clock used to step the fling, or `nullptr` to restore CZTime::Us().
+     *
+     * Event timestamps should come from the same clock.
+     */
+    void setClock(Clock clock) noexcept { m_clock = clock; }
+
+    /**
+     * @brief The velocity tracker fed by finger deltas, e.g. to adjust its horizon.
+     */
+    CZVelocityTracker &tracker() noexcept { return m_tracker; }
+
+protected:
+    void onStart() noexcept override;
+    void onUpdate() noexcept override;
+
+private:
+    struct Axis
+    {
+        Float64 pos, vel;
+        bool atRest;
+
+        // Following the fingers
+        bool tracking;
+    };
+
+    // Whether the range of an axis is empty (NaN-safe)
+    static bool locked(Float64 min, Float64 max) noexcept { return !(max > min); }
+
+    UInt64 now() const noexcept;
+    void step(Axis &axis, Float64 min, Float64 max, Float64 dt) noexcept;
+    void release(Axis &axis, Float64 velocity, Float64 min, Float64 max) noexcept;
+    void updatePhase() noexcept;
+
+    Axis m_x { 0.0, 0.0, true, false };
+    Axis m_y { 0.0, 0.0, true, false };
+    Phase m_phase { Phase::Idle };
+    UInt64 m_lastStepUs { 0 };
+    Clock m_clock { nullptr };
+    CZVelocityTracker m_tracker;
+    SkRect m_bounds;
+    Float64 m_friction { 2.0 };
+    Float64 m_minVelocity { 20.0 };
+    Float64 m_stiffness { CZSpringAnimation::StiffnessHigh };
+    Float64 m_naturalFreq;
+    Float64 m_dampingRatio { CZSpringAnimation::DampingRatioNoBouncy };
+};
+
+#endif // CZ_CZKINETICSCROLL_H
@@ -1,5 +1,6 @@
 #include <CZ/Core/CZSignal.h>
 #include <CZ/Core/CZObject.h>
+#include <CZ/Core/CZObjectCensus.h>
 
 using namespace CZ;
 
@@ -12,6 +13,9 @@ CZListener::~CZListener()
     object->m_listeners[objectLink] = object->m_listeners.back();
     object->m_listeners[objectLink]->objectLink = objectLink;
     object->m_listeners.pop_back();
+
+    if (CZObjectCensus::IsEnabled())
+        CZObjectCensus::Unregister(this);
 }
 
 CZListener::CZListener(CZObject *object, CZSignalBase *signal) noexcept :
@@ -22,3 +26,9 @@ CZListener::CZListener(CZObject *object, CZSignalBase *signal) noexcept :
     objectLink = object->m_listeners.size() - 1;
     signalLink = signal->listeners.size();
 }
+
+void CZListener::registerInCensus(std::size_t size) const noexcept
+{
+    if (CZObjectCensus::IsEnabled())
+        CZObjectCensus::Register(this, size);
+}
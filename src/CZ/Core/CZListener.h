@@ -21,6 +21,7 @@ public:
 
 protected:
     CZListener(CZObject *object, CZSignalBase *signal) noexcept;
+    void registerInCensus(std::size_t size) const noexcept;
 
     friend class CZSignalBase;
 
@@ -37,7 +38,9 @@ public:
     CZListenerTemplate(CZObject *object, CZSignalBase *signal, F&& callback) noexcept
         : CZListener(object, signal)
         , m_callback(std::forward<F>(callback))
-    {}
+    {
+        registerInCensus(sizeof(*this));
+    }
 
     void invoke(void *argsTuple) override
     {
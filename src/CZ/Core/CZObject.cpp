@@ -1,5 +1,6 @@
 #include <CZ/Core/CZObject.h>
 #include <CZ/Core/CZWeak.h>
+#include <CZ/Core/CZObjectCensus.h>
 
 using namespace CZ;
 
@@ -37,6 +38,12 @@ void CZObject::destroyLater() noexcept
     //TODO: akApp()->postEvent(AKDestroyEvent(), *this);
 }
 
+CZObject::CZObject() noexcept
+{
+    if (CZObjectCensus::IsEnabled())
+        CZObjectCensus::Register(this);
+}
+
 CZObject::~CZObject() noexcept
 {
     notifyDestruction();
@@ -46,6 +53,74 @@ CZObject::~CZObject() noexcept
 
     while (!m_installedEventFilters.empty())
         removeEventFilter(m_installedEventFilters.back());
+
+    if (CZObjectCensus::IsEnabled())
+        CZObjectCensus::Unregister(this);
+}
+
+void *CZObject::operator new(std::size_t size)
+{
+    void *ptr { ::operator new(size) };
+
+    if (CZObjectCensus::IsEnabled())
+        CZObjectCensus::RecordAllocation(ptr, size);
+
+    return ptr;
+}
+
+void *CZObject::operator new(std::size_t size, const std::nothrow_t &tag) noexcept
+{
+    void *ptr { ::operator new(size, tag) };
+
+    if (ptr && CZObjectCensus::IsEnabled())
+        CZObjectCensus::RecordAllocation(ptr, size);
+
+    return ptr;
+}
+
+void *CZObject::operator new(std::size_t size, std::align_val_t align)
+{
+    void *ptr { ::operator new(size, align) };
+
+    if (CZObjectCensus::IsEnabled())
+        CZObjectCensus::RecordAllocation(ptr, size);
+
+    return ptr;
+}
+
+void *CZObject::operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &tag) noexcept
+{
+    void *ptr { ::operator new(size, align, tag) };
+
+    if (ptr && CZObjectCensus::IsEnabled())
+        CZObjectCensus::RecordAllocation(ptr, size);
+
+    return ptr;
+}
+
+void CZObject::operator delete(void *ptr) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void CZObject::operator delete(void *ptr, const std::nothrow_t &tag) noexcept
+{
+    ::operator delete(ptr, tag);
+}
+
+void CZObject::operator delete(void *ptr, std::align_val_t align) noexcept
+{
+    ::operator delete(ptr, align);
+}
+
+void CZObject::operator delete(void *ptr, std::size_t size, std::align_val_t align) noexcept
+{
+    ::operator delete(ptr, size, align);
+}
+
+void CZObject::operator delete(void *ptr, std::align_val_t align, const std::nothrow_t &tag) noexcept
+{
+    ::operator delete(ptr, align, tag);
 }
 
 void CZObject::notifyDestruction() noexcept
@@ -4,6 +4,7 @@
 #include <CZ/Core/CZSignal.h>
 #include <unordered_map>
 #include <list>
+#include <new>
 
 class CZ::CZObjectBase
 {
@@ -32,13 +33,32 @@ public:
     /**
      * @brief Constructor of the CZObject class.
      */
-    CZObject() noexcept = default;
+    CZObject() noexcept;
 
     /**
      * @brief Destructor of the CZObject class.
      */
     ~CZObject() noexcept;
 
+    /**
+     * @brief Allocation functions.
+     *
+     * Forward to the global ones, letting CZObjectCensus account the size of the concrete type when enabled.
+     * The `std::align_val_t` forms are declared too, since class-level overloads hide the global ones and
+     * over-aligned subclasses (e.g. `alignas(64)`) would otherwise get under-aligned memory.
+     */
+    static void *operator new(std::size_t size);
+    static void *operator new(std::size_t size, const std::nothrow_t &tag) noexcept;
+    static void *operator new(std::size_t size, std::align_val_t align);
+    static void *operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &tag) noexcept;
+    static void *operator new(std::size_t size, void *ptr) noexcept { CZ_UNUSED(size) return ptr; }
+    static void operator delete(void *ptr) noexcept;
+    static void operator delete(void *ptr, const std::nothrow_t &tag) noexcept;
+    static void operator delete(void *ptr, std::align_val_t align) noexcept;
+    static void operator delete(void *ptr, std::size_t size, std::align_val_t align) noexcept;
+    static void operator delete(void *ptr, std::align_val_t align, const std::nothrow_t &tag) noexcept;
+    static void operator delete(void *ptr, void *place) noexcept { CZ_UNUSED(ptr) CZ_UNUSED(place) }
+
 protected:
 
     /**
@@ -0,0 +1,251 @@
+#include <CZ/Core/CZObjectCensus.h>
+#include <CZ/Core/CZObject.h>
+#include <CZ/Core/CZLog.h>
+#include <cxxabi.h>
+#include <mutex>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+
+using namespace CZ;
+
+namespace
+{
+    struct TypeStats
+    {
+        std::string name;
+        UInt64 count {};
+        UInt64 bytes {};
+        UInt64 peakCount {};
+        UInt64 peakBytes {};
+
+        void add(UInt64 size) noexcept
+        {
+            count++;
+            bytes += size;
+            peakCount = std::max(peakCount, count);
+            peakBytes = std::max(peakBytes, bytes);
+        }
+
+        void remove(UInt64 size) noexcept
+        {
+            count--;
+            bytes -= size;
+        }
+    };
+
+    struct Record
+    {
+        TypeStats *type; // nullptr until classified
+        UInt64 bytes;
+
+        // Thread that constructed the object, the only one that can safely query its dynamic type
+        std::thread::id owner;
+    };
+
+    struct Allocation
+    {
+        const void *ptr;
+        std::size_t size;
+    };
+
+    struct State
+    {
+        std::mutex mutex;
+        std::unordered_map<const void*, Record> live;
+        std::vector<const CZObject*> pending;
+        std::unordered_map<std::type_index, TypeStats> types;
+        TypeStats listeners { "CZ::CZListener" };
+        TypeStats total;
+    };
+}
+
+// Never destroyed, objects may outlive static storage
+static State &S() noexcept
+{
+    static State *state { new State() };
+    return *state;
+}
+
+static bool EnvEnabled() noexcept
+{
+    const char *env { getenv("CZ_CORE_CENSUS") };
+    return (env && atoi(env) > 0) || CZObjectCensus::DumpIntervalMs() > 0;
+}
+
+static std::string Demangle(const char *name) noexcept
+{
+    int status;
+    char *demangled { abi::__cxa_demangle(name, nullptr, nullptr, &status) };
+
+    if (status != 0 || !demangled)
+        return name;
+
+    std::string result { demangled };
+    free(demangled);
+    return result;
+}
+
+static thread_local Allocation t_lastAllocation {};
+
+std::atomic<bool> CZObjectCensus::s_enabled { EnvEnabled() };
+
+void CZObjectCensus::SetEnabled(bool enabled) noexcept
+{
+    auto &s { S() };
+    std::lock_guard lock { s.mutex };
+
+    if (s_enabled.load(std::memory_order_relaxed) == enabled)
+        return;
+
+    s_enabled.store(enabled, std::memory_order_relaxed);
+    s.live.clear();
+    s.pending.clear();
+    s.types.clear();
+    s.listeners = { "CZ::CZListener" };
+    s.total = {};
+}
+
+UInt32 CZObjectCensus::DumpIntervalMs() noexcept
+{
+    static const UInt32 interval { []() -> UInt32 {
+        const char *env { getenv("CZ_CORE_CENSUS_DUMP_MS") };
+        return env ? std::max(atoi(env), 0) : 0;
+    }() };
+
+    return interval;
+}
+
+void CZObjectCensus::RecordAllocation(void *ptr, std::size_t size) noexcept
+{
+    t_lastAllocation = { ptr, size };
+}
+
+void CZObjectCensus::Register(const CZObject *object) noexcept
+{
+    UInt64 bytes { 0 };
+
+    if (t_lastAllocation.ptr == object)
+    {
+        bytes = t_lastAllocation.size;
+        t_lastAllocation = {};
+    }
+
+    auto &s { S() };
+    std::lock_guard lock { s.mutex };
+    s.live[object] = { nullptr, bytes, std::this_thread::get_id() };
+    s.pending.emplace_back(object);
+    s.total.add(bytes);
+}
+
+void CZObjectCensus::Register(const CZListener *listener, std::size_t size) noexcept
+{
+    auto &s { S() };
+    std::lock_guard lock { s.mutex };
+    s.live[listener] = { &s.listeners, size, {} };
+    s.listeners.add(size);
+    s.total.add(size);
+}
+
+void CZObjectCensus::Unregister(const void *instance) noexcept
+{
+    auto &s { S() };
+    std::lock_guard lock { s.mutex };
+    auto it { s.live.find(instance) };
+
+    // Created while disabled
+    if (it == s.live.end())
+        return;
+
+    if (it->second.type)
+        it->second.type->remove(it->second.bytes);
+
+    s.total.remove(it->second.bytes);
+    s.live.erase(it);
+}
+
+void CZObjectCensus::Collect() noexcept
+{
+    auto &s { S() };
+    std::lock_guard lock { s.mutex };
+    const auto thread { std::this_thread::get_id() };
+    size_t kept { 0 };
+
+    for (const CZObject *object : s.pending)
+    {
+        auto it { s.live.find(object) };
+
+        // Already destroyed or classified (address reused)
+        if (it == s.live.end() || it->second.type)
+            continue;
+
+        // Objects of other threads may still be under construction, their vptr is not stable yet
+        if (it->second.owner != thread)
+        {
+            s.pending[kept++] = object;
+            continue;
+        }
+
+        const std::type_info &info { typeid(*object) };
+        auto type { s.types.find(info) };
+
+        if (type == s.types.end())
+            type = s.types.emplace(info, TypeStats { Demangle(info.name()) }).first;
+
+        it->second.type = &type->second;
+        type->second.add(it->second.bytes);
+    }
+
+    s.pending.resize(kept);
+}
+
+CZObjectCensus::Snapshot CZObjectCensus::Take() noexcept
+{
+    if (!IsEnabled())
+        return {};
+
+    Collect();
+
+    auto &s { S() };
+    std::lock_guard lock { s.mutex };
+    Snapshot snapshot {};
+    snapshot.entries.reserve(s.types.size() + 1);
+
+    const auto addEntry = [&snapshot](const TypeStats &stats) {
+        if (stats.peakCount > 0)
+            snapshot.entries.emplace_back(stats.name, stats.count, stats.bytes, stats.peakCount, stats.peakBytes);
+    };
+
+    for (const auto &type : s.types)
+        addEntry(type.second);
+
+    addEntry(s.listeners);
+
+    std::sort(snapshot.entries.begin(), snapshot.entries.end(), [](const Entry &a, const Entry &b) {
+        return a.bytes != b.bytes ? a.bytes > b.bytes : a.count > b.count;
+    });
+
+    snapshot.count = s.total.count;
+    snapshot.bytes = s.total.bytes;
+    snapshot.peakCount = s.total.peakCount;
+    snapshot.peakBytes = s.total.peakBytes;
+    return snapshot;
+}
+
+void CZObjectCensus::Dump(CZLogLevel level) noexcept
+{
+    if (!IsEnabled())
+    {
+        CZLog(CZWarning, CZLN, "The object census is disabled");
+        return;
+    }
+
+    const auto snapshot { Take() };
+
+    CZLog(level, "[Census] Live: {} objects, {} bytes. Peak: {} objects, {} bytes",
+          snapshot.count, snapshot.bytes, snapshot.peakCount, snapshot.peakBytes);
+
+    for (const auto &entry : snapshot.entries)
+        CZLog(level, "[Census]   {}: {} ({} bytes). Peak: {} ({} bytes)",
+              entry.type, entry.count, entry.bytes, entry.peakCount, entry.peakBytes);
+}
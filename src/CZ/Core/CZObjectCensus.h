@@ -0,0 +1,127 @@
+#ifndef CZ_CZOBJECTCENSUS_H
+#define CZ_CZOBJECTCENSUS_H
+
+#include <CZ/Core/CZLogger.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Live object census.
+ *
+ * Opt-in registry that counts live CZObject and CZListener instances per concrete type,
+ * along with the bytes they occupy and their high-water marks. Useful for chasing leaks
+ * and memory growth in long-running sessions.
+ *
+ * The census is disabled by default and costs a single branch per construction/destruction
+ * in that state. It can be enabled with the `CZ_CORE_CENSUS=1` environment variable or by
+ * calling SetEnabled() before the objects of interest are created.
+ * If `CZ_CORE_CENSUS_DUMP_MS` is set to a value greater than 0, the census is enabled as well
+ * and CZCore logs a Dump() at that interval.
+ *
+ * Instances are classified lazily: the concrete type of an object can only be queried once its
+ * constructor has finished, so new objects are grouped by type on the next loop iteration or
+ * Take() call of the thread that created them. Objects destroyed before that, or created by threads
+ * that never call Take(), are only reflected in the totals.
+ *
+ * @note Bytes account for the shallow size of the concrete type and are only known for instances
+ *       allocated with `new`. Objects living on the stack or embedded in other objects count as 0 bytes.
+ */
+class CZ::CZObjectCensus
+{
+public:
+
+    /**
+     * @brief Per type statistics.
+     */
+    struct Entry
+    {
+        /// Demangled name of the concrete type
+        std::string type;
+
+        /// Live instances
+        UInt64 count;
+
+        /// Bytes occupied by the live instances
+        UInt64 bytes;
+
+        /// Highest number of simultaneously live instances observed
+        UInt64 peakCount;
+
+        /// Highest number of simultaneously occupied bytes observed
+        UInt64 peakBytes;
+    };
+
+    /**
+     * @brief Point-in-time copy of the census.
+     */
+    struct Snapshot
+    {
+        /// Per type statistics, sorted by bytes and then by count in descending order
+        std::vector<Entry> entries;
+
+        /// Live instances of all types, including the ones not classified yet
+        UInt64 count;
+
+        /// Bytes occupied by all live instances
+        UInt64 bytes;
+
+        /// Highest number of simultaneously live instances observed
+        UInt64 peakCount;
+
+        /// Highest number of simultaneously occupied bytes observed
+        UInt64 peakBytes;
+    };
+
+    CZObjectCensus() = delete;
+
+    /**
+     * @brief Whether instances are being tracked.
+     */
+    static bool IsEnabled() noexcept { return s_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Enables or disables the census.
+     *
+     * Disabling it discards all the collected data.
+     *
+     * @note Instances created while the census was disabled are never counted.
+     */
+    static void SetEnabled(bool enabled) noexcept;
+
+    /**
+     * @brief Classifies the pending instances created by the calling thread and returns a copy of the current statistics.
+     *
+     * Returns an empty snapshot if the census is disabled.
+     */
+    static Snapshot Take() noexcept;
+
+    /**
+     * @brief Logs the current statistics.
+     *
+     * @param level Log level used for each line.
+     */
+    static void Dump(CZLogLevel level = CZInfo) noexcept;
+
+    /**
+     * @brief Interval in milliseconds of the periodic dump driven by `CZ_CORE_CENSUS_DUMP_MS`.
+     *
+     * @return The interval or 0 if periodic dumps are disabled.
+     */
+    static UInt32 DumpIntervalMs() noexcept;
+
+private:
+    friend class CZObject;
+    friend class CZListener;
+    friend class CZCore;
+    static void RecordAllocation(void *ptr, std::size_t size) noexcept;
+    static void Register(const CZObject *object) noexcept;
+    static void Register(const CZListener *listener, std::size_t size) noexcept;
+    static void Unregister(const void *instance) noexcept;
+    static void Collect() noexcept;
+
+    // Read without locking on every construction and destruction, from any thread
+    static std::atomic<bool> s_enabled;
+};
+
+#endif // CZ_CZOBJECTCENSUS_H
@@ -26,6 +26,42 @@ public:
             fRadTR + fRadBR <= height();
     }
 
+    /**
+     * @brief Whether the point is within the rounded rectangle (left and top edges included).
+     *
+     * Points within the square of a rounded corner are tested against the corner circle. Assumes isValid().
+     */
+    bool containsPoint(SkScalar x, SkScalar y) const noexcept
+    {
+        if (x < SkScalar(fLeft) || y < SkScalar(fTop) || x >= SkScalar(fRight) || y >= SkScalar(fBottom))
+            return false;
+
+        const auto inCircle = [x, y](SkScalar centerX, SkScalar centerY, SkScalar radius) {
+            const SkScalar dx { x - centerX };
+            const SkScalar dy { y - centerY };
+            return dx * dx + dy * dy <= radius * radius;
+        };
+
+        if (y < SkScalar(fTop + fRadTL) && x < SkScalar(fLeft + fRadTL))
+            return inCircle(SkScalar(fLeft + fRadTL), SkScalar(fTop + fRadTL), SkScalar(fRadTL));
+
+        if (y < SkScalar(fTop + fRadTR) && x >= SkScalar(fRight - fRadTR))
+            return inCircle(SkScalar(fRight - fRadTR), SkScalar(fTop + fRadTR), SkScalar(fRadTR));
+
+        if (y >= SkScalar(fBottom - fRadBR) && x >= SkScalar(fRight - fRadBR))
+            return inCircle(SkScalar(fRight - fRadBR), SkScalar(fBottom - fRadBR), SkScalar(fRadBR));
+
+        if (y >= SkScalar(fBottom - fRadBL) && x < SkScalar(fLeft + fRadBL))
+            return inCircle(SkScalar(fLeft + fRadBL), SkScalar(fBottom - fRadBL), SkScalar(fRadBL));
+
+        return true;
+    }
+
+    /**
+     * @brief Whether the point is within the rounded rectangle, see containsPoint(SkScalar, SkScalar).
+     */
+    bool containsPoint(SkPoint point) const noexcept { return containsPoint(point.x(), point.y()); }
+
     constexpr bool operator==(const CZRRect& other) const
     {
         return fLeft == other.fLeft  &&
@@ -0,0 +1,265 @@
+#include <CZ/Core/CZRRectIndex.h>
+#include <algorithm>
+
+using namespace CZ;
+
+// Rounds towards negative infinity, so that cells have the same size on both sides of 0
+static Int64 FloorDiv(Int64 value, Int64 divisor) noexcept
+{
+    const Int64 quotient { value / divisor };
+    return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+}
+
+static Int64 CellCount(const SkIRect &cells) noexcept
+{
+    return (Int64(cells.fRight) - cells.fLeft) * (Int64(cells.fBottom) - cells.fTop);
+}
+
+CZRRectIndex::CZRRectIndex(Int32 cellSize) noexcept :
+    m_cellSize(std::max(cellSize, 1))
+{}
+
+CZRRectIndex::Id CZRRectIndex::insert(const CZRRect &rect, Int32 z) noexcept
+{
+    Id id;
+
+    if (m_freeIds.empty())
+    {
+        m_entries.emplace_back();
+        id = static_cast<Id>(m_entries.size());
+    }
+    else
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+
+    Entry &e { entry(id) };
+    e.rect = rect;
+    e.z = z;
+    e.stamp = m_stamp++;
+    e.cells.setEmpty();
+    e.large = false;
+    e.used = true;
+    m_size++;
+    addToCells(id);
+    return id;
+}
+
+bool CZRRectIndex::remove(Id id) noexcept
+{
+    if (!exists(id))
+        return false;
+
+    removeFromCells(id);
+    entry(id).used = false;
+    m_freeIds.push_back(id);
+    m_size--;
+    return true;
+}
+
+bool CZRRectIndex::move(Id id, const CZRRect &rect) noexcept
+{
+    if (!exists(id))
+        return false;
+
+    Entry &e { entry(id) };
+    const SkIRect cells { cellsOf(rect) };
+
+    if (e.large || CellCount(cells) > MaxCells)
+    {
+        removeFromCells(id);
+        e.rect = rect;
+        addToCells(id);
+        return true;
+    }
+
+    // The stack order is unchanged, so only the cells entered and left need to be updated
+    for (Int32 y = e.cells.fTop; y < e.cells.fBottom; y++)
+        for (Int32 x = e.cells.fLeft; x < e.cells.fRight; x++)
+            if (!cells.contains(x, y))
+                removeFromCell(x, y, id);
+
+    for (Int32 y = cells.fTop; y < cells.fBottom; y++)
+        for (Int32 x = cells.fLeft; x < cells.fRight; x++)
+            if (!e.cells.contains(x, y))
+                addToCell(x, y, id);
+
+    e.rect = rect;
+    e.cells = cells;
+    return true;
+}
+
+bool CZRRectIndex::setZ(Id id, Int32 z) noexcept
+{
+    if (!exists(id))
+        return false;
+
+    removeFromCells(id);
+    entry(id).z = z;
+    entry(id).stamp = m_stamp++;
+    addToCells(id);
+    return true;
+}
+
+void CZRRectIndex::clear() noexcept
+{
+    m_size = 0;
+    m_entries.clear();
+    m_freeIds.clear();
+    m_cells.clear();
+    m_large.clear();
+}
+
+CZRRectIndex::Id CZRRectIndex::hitTest(SkPoint point) const noexcept
+{
+    Id cellHit { InvalidId };
+
+    if (const auto *cell = cellAt(point))
+    {
+        for (Id id : *cell)
+        {
+            if (entry(id).rect.containsPoint(point))
+            {
+                cellHit = id;
+                break;
+            }
+        }
+    }
+
+    for (Id id : m_large)
+    {
+        if (cellHit != InvalidId && above(cellHit, id))
+            break;
+
+        if (entry(id).rect.containsPoint(point))
+            return id;
+    }
+
+    return cellHit;
+}
+
+void CZRRectIndex::hitTestAll(SkPoint point, std::vector<Id> &ids) const noexcept
+{
+    ids.clear();
+
+    if (const auto *cell = cellAt(point))
+        for (Id id : *cell)
+            if (entry(id).rect.containsPoint(point))
+                ids.push_back(id);
+
+    for (Id id : m_large)
+        if (entry(id).rect.containsPoint(point))
+            addSorted(ids, id);
+}
+
+const CZRRect *CZRRectIndex::rect(Id id) const noexcept
+{
+    return exists(id) ? &entry(id).rect : nullptr;
+}
+
+Int32 CZRRectIndex::z(Id id) const noexcept
+{
+    return exists(id) ? entry(id).z : 0;
+}
+
+bool CZRRectIndex::above(Id a, Id b) const noexcept
+{
+    const Entry &ea { entry(a) };
+    const Entry &eb { entry(b) };
+    return ea.z > eb.z || (ea.z == eb.z && ea.stamp > eb.stamp);
+}
+
+SkIRect CZRRectIndex::cellsOf(const SkIRect &rect) const noexcept
+{
+    if (rect.isEmpty())
+        return SkIRect::MakeEmpty();
+
+    return SkIRect::MakeLTRB(
+        static_cast<Int32>(FloorDiv(rect.fLeft, m_cellSize)),
+        static_cast<Int32>(FloorDiv(rect.fTop, m_cellSize)),
+        static_cast<Int32>(FloorDiv(Int64(rect.fRight) - 1, m_cellSize) + 1),
+        static_cast<Int32>(FloorDiv(Int64(rect.fBottom) - 1, m_cellSize) + 1));
+}
+
+UInt64 CZRRectIndex::CellKey(Int32 x, Int32 y) noexcept
+{
+    return (static_cast<UInt64>(static_cast<UInt32>(x)) << 32) | static_cast<UInt32>(y);
+}
+
+void CZRRectIndex::addSorted(std::vector<Id> &ids, Id id) const noexcept
+{
+    const auto it { std::partition_point(ids.begin(), ids.end(), [this, id](Id other) { return above(other, id); }) };
+    ids.insert(it, id);
+}
+
+void CZRRectIndex::removeSorted(std::vector<Id> &ids, Id id) const noexcept
+{
+    const auto it { std::partition_point(ids.begin(), ids.end(), [this, id](Id other) { return above(other, id); }) };
+
+    if (it != ids.end() && *it == id)
+        ids.erase(it);
+}
+
+void CZRRectIndex::addToCell(Int32 x, Int32 y, Id id) noexcept
+{
+    addSorted(m_cells[CellKey(x, y)], id);
+}
+
+void CZRRectIndex::removeFromCell(Int32 x, Int32 y, Id id) noexcept
+{
+    const auto it { m_cells.find(CellKey(x, y)) };
+
+    if (it == m_cells.end())
+        return;
+
+    removeSorted(it->second, id);
+
+    if (it->second.empty())
+        m_cells.erase(it);
+}
+
+void CZRRectIndex::addToCells(Id id) noexcept
+{
+    Entry &e { entry(id) };
+    e.cells = cellsOf(e.rect);
+    e.large = CellCount(e.cells) > MaxCells;
+
+    if (e.large)
+    {
+        e.cells.setEmpty();
+        addSorted(m_large, id);
+        return;
+    }
+
+    for (Int32 y = e.cells.fTop; y < e.cells.fBottom; y++)
+        for (Int32 x = e.cells.fLeft; x < e.cells.fRight; x++)
+            addToCell(x, y, id);
+}
+
+void CZRRectIndex::removeFromCells(Id id) noexcept
+{
+    Entry &e { entry(id) };
+
+    if (e.large)
+        removeSorted(m_large, id);
+    else
+        for (Int32 y = e.cells.fTop; y < e.cells.fBottom; y++)
+            for (Int32 x = e.cells.fLeft; x < e.cells.fRight; x++)
+                removeFromCell(x, y, id);
+
+    e.cells.setEmpty();
+    e.large = false;
+}
+
+const std::vector<CZRRectIndex::Id> *CZRRectIndex::cellAt(SkPoint point) const noexcept
+{
+    if (m_cells.empty())
+        return nullptr;
+
+    const auto it { m_cells.find(CellKey(
+        static_cast<Int32>(FloorDiv(SkScalarFloorToInt(point.x()), m_cellSize)),
+        static_cast<Int32>(FloorDiv(SkScalarFloorToInt(point.y()), m_cellSize)))) };
+
+    return it == m_cells.end() ? nullptr : &it->second;
+}
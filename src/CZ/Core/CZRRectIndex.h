@@ -0,0 +1,171 @@
+#ifndef CZ_CZRRECTINDEX_H
+#define CZ_CZRRECTINDEX_H
+
+#include <CZ/Core/CZRRect.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Hit-testing index over stacked rounded rectangles.
+ *
+ * Finds the topmost of many CZRRect entries (windows, widgets, input regions) under a point without testing each one.
+ * Space is divided into a uniform grid of square cells, and each cell lists the entries overlapping it sorted from
+ * top to bottom, so a hit test looks up the cell of the point and returns the first entry that contains it, using
+ * CZRRect::containsPoint().
+ *
+ * Entries are stacked by their z value (higher above), and entries with the same z by insertion order, the latest
+ * above. Changing the z of an entry with setZ() also places it above the others with the same z.
+ *
+ * move() only updates the cells entered and left by the entry, so small moves within the same cells cost a few
+ * comparisons. The cell size should be around the size of a typical entry: larger entries are added to many cells,
+ * smaller cells hold many entries. Entries overlapping more than 1024 cells (e.g. a fullscreen background) are kept
+ * in a separate list tested on every query instead.
+ *
+ * @code
+ * CZRRectIndex index;
+ * const auto id { index.insert(CZRRect(SkIRect::MakeXYWH(0, 0, 800, 600), 12, 12, 12, 12), 1) };
+ * ...
+ * index.move(id, CZRRect(SkIRect::MakeXYWH(20, 0, 800, 600), 12, 12, 12, 12));
+ *
+ * if (index.hitTest(pointerPos) == id)
+ *     ...
+ * @endcode
+ */
+class CZ::CZRRectIndex
+{
+public:
+
+    /**
+     * @brief Entry identifier, never 0.
+     *
+     * Identifiers of removed entries are reused.
+     */
+    using Id = UInt32;
+
+    /**
+     * @brief Value returned when no entry is found.
+     */
+    static constexpr Id InvalidId { 0 };
+
+    /**
+     * @brief Constructs an empty index.
+     *
+     * @param cellSize Width and height of the grid cells, at least 1.
+     */
+    explicit CZRRectIndex(Int32 cellSize = 128) noexcept;
+
+    /**
+     * @brief Adds an entry above the others with the same z.
+     *
+     * @return The identifier of the new entry.
+     */
+    Id insert(const CZRRect &rect, Int32 z = 0) noexcept;
+
+    /**
+     * @brief Removes an entry.
+     *
+     * @return `false` if the entry does not exist.
+     */
+    bool remove(Id id) noexcept;
+
+    /**
+     * @brief Replaces the rectangle of an entry, keeping its position in the stack.
+     *
+     * @return `false` if the entry does not exist.
+     */
+    bool move(Id id, const CZRRect &rect) noexcept;
+
+    /**
+     * @brief Changes the z of an entry, placing it above the others with the same z.
+     *
+     * @return `false` if the entry does not exist.
+     */
+    bool setZ(Id id, Int32 z) noexcept;
+
+    /**
+     * @brief Removes all entries.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief The topmost entry containing the point.
+     *
+     * @return The entry identifier or InvalidId if no entry contains the point.
+     */
+    Id hitTest(SkPoint point) const noexcept;
+
+    /**
+     * @brief All entries containing the point, from top to bottom.
+     *
+     * @param ids Replaced with the entry identifiers.
+     */
+    void hitTestAll(SkPoint point, std::vector<Id> &ids) const noexcept;
+
+    /**
+     * @brief The rectangle of an entry or `nullptr` if it does not exist.
+     */
+    const CZRRect *rect(Id id) const noexcept;
+
+    /**
+     * @brief The z of an entry, 0 if it does not exist.
+     */
+    Int32 z(Id id) const noexcept;
+
+    /**
+     * @brief Number of entries.
+     */
+    size_t size() const noexcept { return m_size; }
+
+    /**
+     * @brief Width and height of the grid cells.
+     */
+    Int32 cellSize() const noexcept { return m_cellSize; }
+
+private:
+    struct Entry
+    {
+        CZRRect rect;
+        Int32 z;
+
+        // Insertion order, for entries with the same z
+        UInt64 stamp;
+
+        // Range of cells overlapped [left, right) x [top, bottom), empty if not in any cell
+        SkIRect cells;
+        bool large;
+        bool used;
+    };
+
+    static constexpr Int64 MaxCells { 1024 };
+
+    bool exists(Id id) const noexcept { return id != InvalidId && id <= m_entries.size() && m_entries[id - 1].used; }
+    Entry &entry(Id id) noexcept { return m_entries[id - 1]; }
+    const Entry &entry(Id id) const noexcept { return m_entries[id - 1]; }
+
+    // Whether a is stacked above b
+    bool above(Id a, Id b) const noexcept;
+
+    SkIRect cellsOf(const SkIRect &rect) const noexcept;
+    static UInt64 CellKey(Int32 x, Int32 y) noexcept;
+    void addSorted(std::vector<Id> &ids, Id id) const noexcept;
+    void removeSorted(std::vector<Id> &ids, Id id) const noexcept;
+    void addToCell(Int32 x, Int32 y, Id id) noexcept;
+    void removeFromCell(Int32 x, Int32 y, Id id) noexcept;
+    void addToCells(Id id) noexcept;
+    void removeFromCells(Id id) noexcept;
+    const std::vector<Id> *cellAt(SkPoint point) const noexcept;
+
+    Int32 m_cellSize;
+    size_t m_size { 0 };
+    UInt64 m_stamp { 0 };
+    std::vector<Entry> m_entries;
+    std::vector<Id> m_freeIds;
+
+    // Entries overlapping each cell, from top to bottom
+    std::unordered_map<UInt64, std::vector<Id>> m_cells;
+
+    // Entries overlapping too many cells, from top to bottom
+    std::vector<Id> m_large;
+};
+
+#endif // CZ_CZRRECTINDEX_H
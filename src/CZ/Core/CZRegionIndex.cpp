@@ -0,0 +1,274 @@
+#include <CZ/Core/CZRegionIndex.h>
+#include <algorithm>
+#include <limits>
+#include <optional>
+
+using namespace CZ;
+
+void CZRegionIndex::setRegion(const SkRegion &region) noexcept
+{
+    // Cheap when both share the same data, e.g. the region was not modified since the last call
+    if (region == m_region)
+        return;
+
+    m_region = region;
+    build();
+}
+
+/*
+ * SkRegion rectangles already come in bands: rows sorted by y whose rectangles share the same top and
+ * bottom, sorted by x. To not depend on that, the bands are rebuilt from the distinct y edges and each
+ * rectangle is added to the bands it spans, which is exactly one band per rectangle for SkRegion.
+ */
+void CZRegionIndex::build() noexcept
+{
+    m_bands.clear();
+    m_blocks.clear();
+    m_rects.clear();
+
+    std::vector<Int32> edges;
+
+    for (SkRegion::Iterator it(m_region); !it.done(); it.next())
+    {
+        edges.push_back(it.rect().fTop);
+        edges.push_back(it.rect().fBottom);
+    }
+
+    if (edges.empty())
+        return;
+
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    const auto edgeIndex = [&edges](Int32 y) {
+        return static_cast<size_t>(std::lower_bound(edges.begin(), edges.end(), y) - edges.begin());
+    };
+
+    // Count the rectangles of each band between two edges and lay them out contiguously
+    std::vector<UInt32> offsets(edges.size(), 0);
+
+    for (SkRegion::Iterator it(m_region); !it.done(); it.next())
+        for (size_t i = edgeIndex(it.rect().fTop), end = edgeIndex(it.rect().fBottom); i < end; i++)
+            offsets[i + 1]++;
+
+    for (size_t i = 1; i < offsets.size(); i++)
+        offsets[i] += offsets[i - 1];
+
+    m_rects.resize(offsets.back());
+    std::vector<UInt32> fill(offsets.begin(), offsets.end() - 1);
+
+    for (SkRegion::Iterator it(m_region); !it.done(); it.next())
+        for (size_t i = edgeIndex(it.rect().fTop), end = edgeIndex(it.rect().fBottom); i < end; i++)
+            m_rects[fill[i]++] = SkIRect::MakeLTRB(it.rect().fLeft, edges[i], it.rect().fRight, edges[i + 1]);
+
+    for (size_t i = 0; i + 1 < edges.size(); i++)
+    {
+        if (offsets[i] == offsets[i + 1])
+            continue;
+
+        std::sort(m_rects.begin() + offsets[i], m_rects.begin() + offsets[i + 1], [](const SkIRect &a, const SkIRect &b) {
+            return a.fLeft < b.fLeft;
+        });
+
+        m_bands.push_back({ edges[i], edges[i + 1], offsets[i], offsets[i + 1] });
+    }
+
+    for (size_t i = 0; i < m_bands.size(); i++)
+    {
+        // Intervals are sorted and disjoint, the first has the smallest left and the last the largest right
+        const Int32 left { m_rects[m_bands[i].begin].fLeft };
+        const Int32 right { m_rects[m_bands[i].end - 1].fRight };
+
+        if (i % BlockSize == 0)
+            m_blocks.push_back({ left, right });
+        else
+        {
+            m_blocks.back().left = std::min(m_blocks.back().left, left);
+            m_blocks.back().right = std::max(m_blocks.back().right, right);
+        }
+    }
+}
+
+const CZRegionIndex::Band *CZRegionIndex::bandAt(Int32 y) const noexcept
+{
+    const auto it { std::partition_point(m_bands.begin(), m_bands.end(), [y](const Band &band) {
+        return band.bottom <= y;
+    })};
+
+    return it != m_bands.end() && it->top <= y ? &*it : nullptr;
+}
+
+bool CZRegionIndex::contains(SkPoint point) const noexcept
+{
+    return contains(SkScalarFloorToInt(point.x()), SkScalarFloorToInt(point.y()));
+}
+
+const SkIRect *CZRegionIndex::rectAt(Int32 x, Int32 y) const noexcept
+{
+    const Band *band { bandAt(y) };
+
+    if (!band)
+        return nullptr;
+
+    const auto begin { m_rects.begin() + band->begin };
+    const auto end { m_rects.begin() + band->end };
+    const auto it { std::partition_point(begin, end, [x](const SkIRect &rect) { return rect.fRight <= x; }) };
+    return it != end && it->fLeft <= x ? &*it : nullptr;
+}
+
+SkPoint CZRegionIndex::closestPoint(SkPoint point, Float32 padding) const noexcept
+{
+    if (m_bands.empty())
+        return point;
+
+    Float32 smallestDistance { std::numeric_limits<Float32>::max() };
+    size_t closestIndex { 0 };
+    SkPoint closestPoint { point };
+
+    // Same as CZRegionUtils::ClosestPointFrom() for a single rect, returns true if the point is inside
+    const auto visit = [&](size_t index) {
+        const SkIRect &rect { m_rects[index] };
+        SkPoint tmpPoint;
+        UInt8 in { 0 };
+
+        if (point.x() <= rect.fLeft)
+            tmpPoint.fX = Float32(rect.fLeft) + padding;
+        else if (point.x() >= rect.fRight)
+            tmpPoint.fX = Float32(rect.fRight) - padding;
+        else
+        {
+            in++;
+            tmpPoint.fX = point.x();
+        }
+
+        if (point.y() <= rect.fTop)
+            tmpPoint.fY = Float32(rect.fTop) + padding;
+        else if (point.y() >= rect.fBottom)
+            tmpPoint.fY = Float32(rect.fBottom) - padding;
+        else
+        {
+            in++;
+            tmpPoint.fY = point.y();
+        }
+
+        if (in == 2)
+            return true;
+
+        // Ties go to the first rect in region order, as when iterating the region
+        const Float32 distance { SkPoint::Distance(point, tmpPoint) };
+
+        if (distance < smallestDistance || (distance == smallestDistance && index < closestIndex))
+        {
+            smallestDistance = distance;
+            closestIndex = index;
+            closestPoint = tmpPoint;
+        }
+
+        return false;
+    };
+
+    // The padding moves the candidate points, this bounds how much closer they can get
+    const Float32 slack { std::min(padding, 0.f) };
+
+    const auto axisDistance = [slack](Float32 value, Int32 min, Int32 max) {
+        return std::max(0.f, std::max(Float32(min) - value, value - Float32(max)) + slack);
+    };
+
+    // Starts with the intervals right before and after the point and continues outwards while they can be closer,
+    // which without negative padding is usually just those two
+    const auto visitBand = [&](const Band &band) {
+        const auto begin { m_rects.begin() + band.begin };
+        const auto end { m_rects.begin() + band.end };
+        const auto it { std::partition_point(begin, end, [&point](const SkIRect &rect) {
+            return Float32(rect.fRight) <= point.x();
+        })};
+
+        const size_t after { static_cast<size_t>(it - m_rects.begin()) };
+
+        for (size_t i = after; i > band.begin; i--)
+        {
+            if (axisDistance(point.x(), m_rects[i - 1].fLeft, m_rects[i - 1].fRight) > smallestDistance)
+                break;
+
+            if (visit(i - 1))
+                return true;
+        }
+
+        for (size_t i = after; i < band.end; i++)
+        {
+            if (axisDistance(point.x(), m_rects[i].fLeft, m_rects[i].fRight) > smallestDistance)
+                break;
+
+            if (visit(i))
+                return true;
+        }
+
+        return false;
+    };
+
+    // Whether rects within [top, bottom) x [left, right) can be closer than the closest point so far
+    const auto mayBeCloser = [&](Int32 top, Int32 bottom, Int32 left, Int32 right) {
+        const Float32 dx { axisDistance(point.x(), left, right) };
+        const Float32 dy { axisDistance(point.y(), top, bottom) };
+        return dx * dx + dy * dy <= smallestDistance * smallestDistance;
+    };
+
+    // Returns true if the point is inside, false to continue with the next band and nullopt to stop
+    const auto visitIndex = [&](size_t i, bool down, bool entering, size_t &skipTo) -> std::optional<bool> {
+        const Band &band { m_bands[i] };
+
+        // Bands are visited outwards, the following ones are even farther vertically
+        if (axisDistance(point.y(), band.top, band.bottom) > smallestDistance)
+            return std::nullopt;
+
+        const size_t blockFirst { i - i % BlockSize };
+        const size_t blockLast { std::min(m_bands.size(), blockFirst + BlockSize) - 1 };
+
+        if (entering || i == (down ? blockFirst : blockLast))
+        {
+            const Block &block { m_blocks[i / BlockSize] };
+
+            if (!mayBeCloser(m_bands[blockFirst].top, m_bands[blockLast].bottom, block.left, block.right))
+            {
+                skipTo = down ? blockLast : blockFirst;
+                return false;
+            }
+        }
+
+        if (!mayBeCloser(band.top, band.bottom, m_rects[band.begin].fLeft, m_rects[band.end - 1].fRight))
+            return false;
+
+        return visitBand(band);
+    };
+
+    const size_t first { static_cast<size_t>(std::partition_point(m_bands.begin(), m_bands.end(), [&point](const Band &band) {
+        return Float32(band.bottom) <= point.y();
+    }) - m_bands.begin()) };
+
+    for (size_t i = first; i < m_bands.size(); i++)
+    {
+        const auto result { visitIndex(i, true, i == first, i) };
+
+        if (!result)
+            break;
+
+        if (*result)
+            return point;
+    }
+
+    for (size_t i = first; i > 0; i--)
+    {
+        size_t index { i - 1 };
+        const auto result { visitIndex(index, false, i == first, index) };
+
+        if (!result)
+            break;
+
+        if (*result)
+            return point;
+
+        i = index + 1;
+    }
+
+    return closestPoint;
+}
@@ -0,0 +1,117 @@
+#ifndef CZ_CZREGIONINDEX_H
+#define CZ_CZREGIONINDEX_H
+
+#include <CZ/Core/Cuarzo.h>
+#include <CZ/skia/core/SkPoint.h>
+#include <CZ/skia/core/SkRegion.h>
+#include <vector>
+
+/**
+ * @brief Spatial index over the rectangles of a region for fast point queries.
+ *
+ * SkRegion::contains() and CZRegionUtils::ClosestPointFrom() walk the rectangles of the region, which adds up when
+ * called on every pointer motion, e.g. to keep the cursor within the outputs or a confinement region.
+ *
+ * The index stores the rectangles as horizontal bands sorted by y, each with its x intervals sorted by x. Containment
+ * and "which rectangle" queries are two binary searches, O(log n). Nearest-point queries start at the band of the
+ * point and visit the bands above and below only while they can still be closer than the best candidate, checking
+ * two intervals per band. Bands, and blocks of 16 bands, whose horizontal extent is too far are skipped.
+ *
+ * setRegion() keeps a reference to the region (SkRegion copies share their data) and only rebuilds the index if the
+ * region differs, so it can be called every time before querying.
+ *
+ * @code
+ * index.setRegion(outputsRegion); // Cheap if unchanged
+ *
+ * if (!index.contains(cursorPos))
+ *     cursorPos = index.closestPoint(cursorPos);
+ * @endcode
+ */
+class CZ::CZRegionIndex
+{
+public:
+
+    /**
+     * @brief Constructs an index of an empty region.
+     */
+    CZRegionIndex() noexcept = default;
+
+    /**
+     * @brief Constructs an index of the given region.
+     */
+    explicit CZRegionIndex(const SkRegion &region) noexcept { setRegion(region); }
+
+    /**
+     * @brief Indexes a region.
+     *
+     * Does nothing if the region equals the indexed one.
+     */
+    void setRegion(const SkRegion &region) noexcept;
+
+    /**
+     * @brief The indexed region.
+     */
+    const SkRegion &region() const noexcept { return m_region; }
+
+    /**
+     * @brief Whether the pixel at the given coordinates is within the region, same as SkRegion::contains().
+     */
+    bool contains(Int32 x, Int32 y) const noexcept { return rectAt(x, y) != nullptr; }
+
+    /**
+     * @brief Whether the point is within the region (left and top edges included).
+     */
+    bool contains(SkPoint point) const noexcept;
+
+    /**
+     * @brief The rectangle of the region containing the pixel at the given coordinates.
+     *
+     * @return The rectangle, as returned by SkRegion::Iterator, or `nullptr` if the pixel is not within the region.
+     */
+    const SkIRect *rectAt(Int32 x, Int32 y) const noexcept;
+
+    /**
+     * @brief Returns the point within the region closest to the given point.
+     *
+     * Same result as CZRegionUtils::ClosestPointFrom().
+     *
+     * @param point The point to find the closest point within the region.
+     * @param padding Optional padding applied to each of the region rectangles.
+     */
+    SkPoint closestPoint(SkPoint point, Float32 padding = 0.f) const noexcept;
+
+    /**
+     * @brief Number of horizontal bands.
+     */
+    size_t bandCount() const noexcept { return m_bands.size(); }
+
+    /**
+     * @brief Number of rectangles, after splitting them into bands.
+     */
+    size_t rectCount() const noexcept { return m_rects.size(); }
+
+private:
+    struct Band
+    {
+        Int32 top, bottom;
+
+        // Range of m_rects, sorted by x
+        UInt32 begin, end;
+    };
+
+    // Horizontal extent of each group of BlockSize consecutive bands, to skip them at once
+    static constexpr size_t BlockSize { 16 };
+    struct Block
+    {
+        Int32 left, right;
+    };
+
+    void build() noexcept;
+    const Band *bandAt(Int32 y) const noexcept;
+    SkRegion m_region;
+    std::vector<Band> m_bands;
+    std::vector<Block> m_blocks;
+    std::vector<SkIRect> m_rects;
+};
+
+#endif // CZ_CZREGIONINDEX_H
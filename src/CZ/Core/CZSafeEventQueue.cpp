@@ -1,31 +1,320 @@
 #include <CZ/Core/CZSafeEventQueue.h>
 #include <CZ/Core/Events/CZEvent.h>
+#include <CZ/Core/Events/CZPointerMoveEvent.h>
+#include <CZ/Core/Events/CZTouchMoveEvent.h>
 #include <CZ/Core/CZCore.h>
 #include <CZ/Core/CZLog.h>
+#include <algorithm>
 
 using namespace CZ;
 
+static constexpr UInt32 InputLane { static_cast<UInt32>(CZSafeEventQueue::Lane::Input) };
+
+CZSafeEventQueue::Lane CZSafeEventQueue::LaneOf(CZEvent::Type type) noexcept
+{
+    using T = CZEvent::Type;
+
+    if ((type >= T::Input_First && type <= T::Input_Last) || type == T::TouchBatch)
+        return Lane::Input;
+
+    switch (type)
+    {
+    case T::Presentation:
+    case T::Render:
+    case T::Bake:
+        return Lane::Presentation;
+    case T::WindowState:
+    case T::AKSceneChanged:
+    case T::Layout:
+    case T::ColorScheme:
+    case T::Vibrancy:
+        return Lane::Layout;
+    default:
+        return Lane::User;
+    }
+}
+
 void CZSafeEventQueue::addEvent(std::shared_ptr<CZEvent> event, CZObject &object) noexcept
 {
     if (!event) return;
-    m_queue.emplace(CZWeak<CZObject>(&object), event);
+    const auto lane { static_cast<UInt32>(LaneOf(event->type())) };
+    auto &slot { m_lanes[lane].emplaceBack() };
+    slot.object.reset(&object);
+    slot.event = std::move(event);
+    slot.queuedUs = m_statsEnabled ? CZTime::Us() : 0;
+}
+
+void CZSafeEventQueue::addEvent(CZEventPool::Handle event, CZObject &object) noexcept
+{
+    if (!event) return;
+    const auto lane { static_cast<UInt32>(LaneOf(event->type())) };
+    auto &slot { m_lanes[lane].emplaceBack() };
+    slot.object.reset(&object);
+    slot.pooled = std::move(event);
+    slot.queuedUs = m_statsEnabled ? CZTime::Us() : 0;
 }
 
-void CZSafeEventQueue::dispatch() noexcept
+bool CZSafeEventQueue::empty() const noexcept
+{
+    for (const auto &lane : m_lanes)
+        if (!lane.empty())
+            return false;
+
+    return true;
+}
+
+size_t CZSafeEventQueue::size() const noexcept
+{
+    size_t count { 0 };
+
+    for (const auto &lane : m_lanes)
+        count += lane.size();
+
+    return count;
+}
+
+bool CZSafeEventQueue::dispatch() noexcept
 {
     auto core { CZCore::Get() };
 
     if (core.use_count() == 1)
     {
         CZLog(CZError, CZLN, "Missing CZCore");
-        m_queue = {};
+        for (auto &lane : m_lanes)
+            lane.clear();
+        return false;
+    }
+
+    for (UInt32 lane = 0; lane < LaneCount; lane++)
+    {
+        // Input queued by the handlers of the previous lane goes first. Lanes defer after a
+        // single event while input is pending, so they still progress if input keeps arriving
+        if (lane > InputLane && !m_lanes[InputLane].empty())
+            dispatchLane(*core, InputLane);
+
+        dispatchLane(*core, lane);
+    }
+
+    return !empty();
+}
+
+void CZSafeEventQueue::dispatchLane(CZCore &core, UInt32 lane) noexcept
+{
+    if (m_lanes[lane].empty())
         return;
+
+    // Handlers may add events to the lane while it is dispatched, and recursive
+    // dispatches of a busy lane get temporary storage
+    Ring tmp;
+    Ring &events { m_busy[lane] ? tmp : m_dispatching[lane] };
+    std::swap(events, m_lanes[lane]);
+    m_busy[lane] = true;
+
+    auto &stats { m_stats[lane] };
+    const UInt64 budget { m_budgetsUs[lane] };
+    const UInt64 begin { budget > 0 || m_statsEnabled ? CZTime::Us() : 0 };
+    UInt64 delivered { 0 };
+
+    // Reading the clock costs about as much as delivering a cheap event, so the budget is
+    // checked at intervals estimated from the average cost of the events delivered so far
+    UInt64 nextCheck { 1 };
+
+    while (!events.empty())
+    {
+        auto &front { events.front() };
+
+        if (!front.object)
+        {
+            events.popFront();
+            continue;
+        }
+
+        UInt64 now { 0 };
+
+        if (m_statsEnabled || (budget > 0 && delivered >= nextCheck))
+            now = CZTime::Us();
+
+        if (delivered > 0)
+        {
+            bool defer { lane > InputLane && !m_lanes[InputLane].empty() };
+
+            if (!defer && budget > 0 && delivered >= nextCheck)
+            {
+                const UInt64 elapsed { now - begin };
+
+                if (elapsed >= budget)
+                    defer = true;
+                else
+                {
+                    const UInt64 perEvent { elapsed / delivered };
+                    nextCheck = delivered + std::clamp<UInt64>((budget - elapsed) / (2 * perEvent + 1), 1, 64);
+                }
+            }
+
+            if (defer)
+            {
+                stats.deferrals++;
+                break;
+            }
+        }
+
+        delivered++;
+
+        stats.delivered++;
+
+        if (m_statsEnabled && front.queuedUs > 0)
+        {
+            const UInt64 delay { now > front.queuedUs ? now - front.queuedUs : 0 };
+            stats.totalDelayUs += delay;
+            stats.maxDelayUs = std::max(stats.maxDelayUs, delay);
+        }
+
+        size_t merged { 0 };
+
+        if (m_coalescePolicy == CoalescePolicy::Motion)
+        {
+            m_samples.clear();
+            while (merged + 1 < events.size() && coalesce(front, events[merged + 1]))
+                merged++;
+        }
+
+        if (merged == 0)
+        {
+            core.sendEvent(front.get(), *front.object.get());
+            events.popFront();
+            continue;
+        }
+
+        CZEvent &event { front.get() };
+        const std::span<const CZMotionSample> history { m_samples };
+
+        if (event.type() == CZEvent::Type::PointerMove)
+            static_cast<CZPointerMoveEvent&>(event).history = history;
+        else
+            static_cast<CZTouchMoveEvent&>(event).history = history;
+
+        core.sendEvent(event, *front.object.get());
+
+        // The event may outlive the dispatch if it was shared
+        if (event.type() == CZEvent::Type::PointerMove)
+            static_cast<CZPointerMoveEvent&>(event).history = {};
+        else
+            static_cast<CZTouchMoveEvent&>(event).history = {};
+
+        for (size_t i = 0; i <= merged; i++)
+            events.popFront();
     }
 
-    while (!m_queue.empty())
+    if (&events == &m_dispatching[lane])
+        m_busy[lane] = false;
+
+    if (events.empty())
+        return;
+
+    // Leftovers go before the events added in the meantime
+    auto &incoming { m_lanes[lane] };
+
+    while (!incoming.empty())
     {
-        if (m_queue.front().object)
-            core->sendEvent(*m_queue.front().event, *m_queue.front().object.get());
-        m_queue.pop();
+        auto &src { incoming.front() };
+        auto &dst { events.emplaceBack() };
+        dst.object = src.object;
+        dst.event = std::move(src.event);
+        dst.pooled = std::move(src.pooled);
+        dst.queuedUs = src.queuedUs;
+        incoming.popFront();
     }
+
+    std::swap(events, incoming);
+}
+
+void CZSafeEventQueue::Ring::grow() noexcept
+{
+    std::vector<SafeEvent> slots(std::max<size_t>(16, m_slots.size() * 2));
+
+    for (size_t i = 0; i < m_size; i++)
+    {
+        auto &src { (*this)[i] };
+        auto &dst { slots[i] };
+        dst.object = src.object;
+        dst.event = std::move(src.event);
+        dst.pooled = std::move(src.pooled);
+        dst.queuedUs = src.queuedUs;
+    }
+
+    m_slots = std::move(slots);
+    m_head = 0;
+}
+
+bool CZSafeEventQueue::coalesce(SafeEvent &target, const SafeEvent &next) noexcept
+{
+    if (next.object.get() != target.object.get())
+        return false;
+
+    const CZEvent &a { target.get() };
+    const CZEvent &b { next.get() };
+
+    if (a.type() != b.type())
+        return false;
+
+    if (a.type() == CZEvent::Type::PointerMove)
+    {
+        const auto &second { static_cast<const CZPointerMoveEvent&>(b) };
+
+        if (static_cast<const CZPointerMoveEvent&>(a).device != second.device)
+            return false;
+
+        auto &first { static_cast<CZPointerMoveEvent&>(ownEvent(target)) };
+
+        if (m_samples.empty())
+            m_samples.emplace_back(first.us, first.pos, first.delta, first.deltaUnaccelerated);
+
+        m_samples.emplace_back(second.us, second.pos, second.delta, second.deltaUnaccelerated);
+        first.pos = second.pos;
+        first.delta += second.delta;
+        first.deltaUnaccelerated += second.deltaUnaccelerated;
+        first.serial = second.serial;
+        first.setTimeUs(second.us);
+        return true;
+    }
+
+    if (a.type() == CZEvent::Type::TouchMove)
+    {
+        const auto &second { static_cast<const CZTouchMoveEvent&>(b) };
+
+        if (static_cast<const CZTouchMoveEvent&>(a).device != second.device ||
+            static_cast<const CZTouchMoveEvent&>(a).id != second.id)
+            return false;
+
+        auto &first { static_cast<CZTouchMoveEvent&>(ownEvent(target)) };
+
+        if (m_samples.empty())
+            m_samples.emplace_back(first.us, first.pos, SkPoint(), SkPoint());
+
+        m_samples.emplace_back(second.us, second.pos, SkPoint(), SkPoint());
+        first.pos = second.pos;
+        first.localPos = second.localPos;
+        first.serial = second.serial;
+        first.setTimeUs(second.us);
+        return true;
+    }
+
+    return false;
+}
+
+CZEvent &CZSafeEventQueue::ownEvent(SafeEvent &slot) noexcept
+{
+    // The poster may still hold the event, merge into a copy to not modify it behind its back
+    if (slot.pooled)
+    {
+        if (slot.pooled.useCount() > 1)
+        {
+            slot.event = slot.pooled->copy();
+            slot.pooled.reset();
+        }
+    }
+    else if (slot.event.use_count() > 1)
+        slot.event = slot.event->copy();
+
+    return slot.get();
 }
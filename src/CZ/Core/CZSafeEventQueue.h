@@ -5,8 +5,12 @@
 #include <CZ/Core/CZObject.h>
 #include <CZ/Core/CZWeak.h>
 #include <CZ/Core/Events/CZEvent.h>
+#include <CZ/Core/Events/CZEventPool.h>
+#include <CZ/Core/Events/CZMotionSample.h>
+#include <array>
 #include <memory>
-#include <queue>
+#include <utility>
+#include <vector>
 
 /**
  * @brief Event queue with weak object references.
@@ -16,12 +20,83 @@
  *
  * Use this in situations where objects may be destroyed while handling events in the queue.
  *
+ * Events are sorted into priority lanes based on their type (see Lane). Higher lanes are always
+ * dispatched first and lower lanes are given a per-dispatch time budget, so bursts of low priority
+ * events cannot delay input delivery. Events within the same lane keep their FIFO order.
+ *
  * Internally, it triggers CZCore::sendEvent().
  */
 class CZ::CZSafeEventQueue
 {
 public:
 
+    /**
+     * @brief Controls whether queued events are merged before being dispatched.
+     */
+    enum class CoalescePolicy
+    {
+        /// Every event is delivered
+        None,
+
+        /**
+         * Consecutive CZPointerMoveEvent or CZTouchMoveEvent events with the same target, device
+         * (and touch id) are delivered as a single event. Positions and timestamps are taken from the
+         * newest event, pointer deltas are accumulated and the individual samples are exposed through
+         * the `history` span of the delivered event.
+         *
+         * Merged values are written into the first queued event, or into a copy of it if it is
+         * still referenced by the poster (a shared_ptr or CZEventPool::Handle kept after posting).
+         *
+         * Merging happens at dispatch time, so events posted with CZCore::postEvent<T>() can still
+         * be filled after being queued.
+         */
+        Motion
+    };
+
+    /**
+     * @brief Priority classes of queued events, from highest to lowest.
+     */
+    enum class Lane : UInt32
+    {
+        /// Input events, always drained completely
+        Input,
+
+        /// Presentation, Render and Bake events
+        Presentation,
+
+        /// WindowState, AKSceneChanged, Layout, ColorScheme and Vibrancy events
+        Layout,
+
+        /// Everything else, including Destroy, Close and user-defined events
+        User
+    };
+
+    /// Number of lanes
+    static constexpr UInt32 LaneCount { 4 };
+
+    /**
+     * @brief Queueing delay statistics of a lane.
+     */
+    struct LaneStats
+    {
+        /// Delivered events, coalesced events count as one
+        UInt64 delivered;
+
+        /// Sum of the time spent in the queue by delivered events in microseconds, see setLaneStatsEnabled()
+        UInt64 totalDelayUs;
+
+        /// Longest time spent in the queue by a delivered event in microseconds, see setLaneStatsEnabled()
+        UInt64 maxDelayUs;
+
+        /// Number of times the lane was left with pending events because its budget ran out or input arrived
+        UInt64 deferrals;
+    };
+
+    /**
+     * @brief The lane assigned to events of the given type.
+     */
+    static Lane LaneOf(CZEvent::Type type) noexcept;
+
     /**
      * @brief Default constructor.
      */
@@ -51,8 +126,14 @@ public:
     {
         if (this != &other)
         {
-            m_queue = std::move(other.m_queue);
-            other.m_queue = std::queue<SafeEvent>();
+            for (UInt32 i = 0; i < LaneCount; i++)
+            {
+                m_lanes[i] = std::move(other.m_lanes[i]);
+                other.m_lanes[i].clear();
+            }
+            m_coalescePolicy = other.m_coalescePolicy;
+            m_budgetsUs = other.m_budgetsUs;
+            m_statsEnabled = other.m_statsEnabled;
         }
         return *this;
     }
@@ -68,14 +149,87 @@ public:
      */
     void addEvent(std::shared_ptr<CZEvent> event, CZObject &object) noexcept;
 
+    /**
+     * @brief Adds a pooled event to the queue.
+     *
+     * @param event Handle to the event, see CZEventPool.
+     * @param object The target object associated with the event.
+     */
+    void addEvent(CZEventPool::Handle event, CZObject &object) noexcept;
+
     /**
      * @brief Dispatches events in the queue.
      *
-     * This method processes each event in the queue, discarding events
-     * associated with destroyed objects and triggering AKApplication::sendEvent()
-     * for remaining events.
+     * This method processes the events queued before the call, lane by lane, discarding events
+     * associated with destroyed objects and triggering CZCore::sendEvent() for remaining events.
+     * Events added during the dispatch are left for the next call.
+     *
+     * A lane stops once its budget is exhausted or, for lanes below Lane::Input, as soon as new input
+     * events are queued, which are then delivered before the next lane. At least one event per lane is
+     * always delivered, so no lane can starve even if input keeps arriving.
+     *
+     * @return `true` if events remain in the queue, `false` otherwise.
+     */
+    bool dispatch() noexcept;
+
+    /**
+     * @brief Whether the queue has no events.
+     */
+    bool empty() const noexcept;
+
+    /**
+     * @brief Number of queued events.
+     */
+    size_t size() const noexcept;
+
+    /**
+     * @brief Sets the time a lane may spend delivering events per dispatch() call.
+     *
+     * Defaults to 0 (unlimited) for Lane::Input and 4 ms for the other lanes.
+     *
+     * @param lane The lane.
+     * @param us Budget in microseconds, or 0 to drain the lane completely.
      */
-    void dispatch() noexcept;
+    void setLaneBudgetUs(Lane lane, UInt64 us) noexcept { m_budgetsUs[static_cast<UInt32>(lane)] = us; }
+
+    /**
+     * @brief The time budget of a lane in microseconds.
+     */
+    UInt64 laneBudgetUs(Lane lane) const noexcept { return m_budgetsUs[static_cast<UInt32>(lane)]; }
+
+    /**
+     * @brief Queueing delay statistics of a lane since creation or the last resetLaneStats() call.
+     */
+    const LaneStats &laneStats(Lane lane) const noexcept { return m_stats[static_cast<UInt32>(lane)]; }
+
+    /**
+     * @brief Clears the statistics of all lanes.
+     */
+    void resetLaneStats() noexcept { m_stats = {}; }
+
+    /**
+     * @brief Enables tracking of queueing delays, disabled by default.
+     *
+     * Costs a clock read when each event is added and delivered. Only events added while enabled are measured.
+     */
+    void setLaneStatsEnabled(bool enabled) noexcept { m_statsEnabled = enabled; }
+
+    /**
+     * @brief Whether queueing delays are being tracked.
+     */
+    bool laneStatsEnabled() const noexcept { return m_statsEnabled; }
+
+    /**
+     * @brief Sets the coalescing policy, CoalescePolicy::None by default.
+     *
+     * The policy is kept after moving the queue.
+     */
+    void setCoalescePolicy(CoalescePolicy policy) noexcept { m_coalescePolicy = policy; }
+
+    /**
+     * @brief The current coalescing policy.
+     */
+    CoalescePolicy coalescePolicy() const noexcept { return m_coalescePolicy; }
 
 private:
 
@@ -83,9 +237,85 @@ private:
     {
         CZWeak<CZObject> object;
         std::shared_ptr<CZEvent> event;
+        CZEventPool::Handle pooled;
+        UInt64 queuedUs {};
+
+        CZEvent &get() const noexcept { return pooled ? *pooled : *event; }
+    };
+
+    /*
+     * Growable FIFO ring. Popped slots are reset but never freed, so a queue that is
+     * drained every iteration stops allocating once it reaches its working size.
+     * Slots never move while in use except when growing, which CZWeak supports by copy.
+     */
+    class Ring
+    {
+    public:
+        Ring() noexcept = default;
+        Ring(Ring &&other) noexcept { *this = std::move(other); }
+        Ring &operator=(Ring &&other) noexcept
+        {
+            if (this != &other)
+            {
+                m_slots = std::move(other.m_slots);
+                m_head = std::exchange(other.m_head, 0);
+                m_size = std::exchange(other.m_size, 0);
+                other.m_slots.clear();
+            }
+            return *this;
+        }
+
+        bool empty() const noexcept { return m_size == 0; }
+        size_t size() const noexcept { return m_size; }
+        SafeEvent &front() noexcept { return m_slots[m_head]; }
+        SafeEvent &operator[](size_t i) noexcept { return m_slots[(m_head + i) & (m_slots.size() - 1)]; }
+
+        SafeEvent &emplaceBack() noexcept
+        {
+            if (m_size == m_slots.size())
+                grow();
+
+            return m_slots[(m_head + m_size++) & (m_slots.size() - 1)];
+        }
+
+        void popFront() noexcept
+        {
+            auto &slot { m_slots[m_head] };
+            slot.object.reset();
+            slot.event.reset();
+            slot.pooled.reset();
+            m_head = (m_head + 1) & (m_slots.size() - 1);
+            m_size--;
+        }
+
+        void clear() noexcept
+        {
+            while (!empty())
+                popFront();
+        }
+
+    private:
+        void grow() noexcept;
+        std::vector<SafeEvent> m_slots; // Power of two size
+        size_t m_head { 0 };
+        size_t m_size { 0 };
     };
 
-    std::queue<SafeEvent> m_queue;
+    void dispatchLane(CZCore &core, UInt32 lane) noexcept;
+    bool coalesce(SafeEvent &target, const SafeEvent &next) noexcept;
+
+    // The event of the slot, replaced by a copy if also referenced outside the queue
+    CZEvent &ownEvent(SafeEvent &slot) noexcept;
+
+    // Events are added to m_lanes and swapped into m_dispatching to be delivered
+    std::array<Ring, LaneCount> m_lanes;
+    std::array<Ring, LaneCount> m_dispatching;
+    std::array<bool, LaneCount> m_busy {};
+    std::array<UInt64, LaneCount> m_budgetsUs { 0, 4000, 4000, 4000 };
+    std::array<LaneStats, LaneCount> m_stats {};
+    std::vector<CZMotionSample> m_samples;
+    CoalescePolicy m_coalescePolicy { CoalescePolicy::None };
+    bool m_statsEnabled { false };
 };
 
 #endif // CZ_CZSAFEEVENTQUEUE_H
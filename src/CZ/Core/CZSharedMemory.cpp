@@ -1,73 +1,372 @@
 #include <CZ/Core/CZSharedMemory.h>
-#include <random>
+#include <CZ/Core/CZLog.h>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unistd.h>
 
 using namespace CZ;
 
+// Bounds the retries when stale objects of a previous process with the same pid are left in /dev/shm
+static constexpr int MaxNameAttempts { 128 };
+
+// The pid keeps processes apart and the counter threads, so names rarely collide
 static std::string GenerateUniqueName() noexcept
 {
-    static std::mt19937 rng(std::random_device{}());
-    static std::uniform_int_distribution<int> dist(0, 999999);
-    return "/cz_shm_" + std::to_string(dist(rng));
+    static std::atomic<UInt32> counter { 0 };
+    return "/cz_shm_" + std::to_string(getpid()) + "_" + std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
 }
 
-std::shared_ptr<CZSharedMemory> CZSharedMemory::Make(size_t size, int oflag, mode_t mode) noexcept
+static size_t SystemPageSize() noexcept
 {
-    for (int attempts = 0; attempts < 999999; attempts++)
+    static const size_t pageSize { static_cast<size_t>(sysconf(_SC_PAGESIZE)) };
+    return pageSize;
+}
+
+// Default size of MFD_HUGETLB pages
+static size_t HugePageSize() noexcept
+{
+    static const size_t hugePageSize { []() -> size_t {
+        std::ifstream meminfo { "/proc/meminfo" };
+        std::string key;
+        size_t kib;
+
+        while (meminfo >> key)
+        {
+            if (key == "Hugepagesize:" && meminfo >> kib)
+                return kib * 1024;
+
+            meminfo.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+
+        return 2 * 1024 * 1024;
+    }() };
+
+    return hugePageSize;
+}
+
+static size_t RoundUp(size_t value, size_t alignment) noexcept
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+std::shared_ptr<CZSharedMemory> CZSharedMemory::Make(size_t size, int oflag, mode_t mode, const Options &options) noexcept
+{
+    Options opts { options };
+
+    if (opts.hugetlb)
+    {
+        CZLog(CZDebug, CZLN, "hugetlb is only supported by memfd regions, ignoring it");
+        opts.hugetlb = false;
+    }
+
+    for (int attempts = 0; attempts < MaxNameAttempts; attempts++)
     {
         const std::string name { GenerateUniqueName() };
 
         const int fd { shm_open(name.c_str(), oflag, mode) };
 
         if (fd < 0)
-            continue;
+        {
+            if (errno == EEXIST)
+                continue;
+
+            CZLog(CZError, CZLN, "shm_open failed: {}", strerror(errno));
+            return {};
+        }
 
         if (ftruncate(fd, size) < 0)
         {
+            CZLog(CZError, CZLN, "ftruncate failed: {}", strerror(errno));
             ::close(fd);
             shm_unlink(name.c_str());
-            continue;
+            return {};
         }
 
-        void *addr { mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) };
+        void *addr { Map(fd, size) };
 
         if (addr == MAP_FAILED)
         {
+            CZLog(CZError, CZLN, "mmap failed: {}", strerror(errno));
             ::close(fd);
             shm_unlink(name.c_str());
-            continue;
+            return {};
         }
 
-        return std::shared_ptr<CZSharedMemory>(new CZSharedMemory(size, fd, addr, name));
+        std::shared_ptr<CZSharedMemory> shm { new CZSharedMemory(size, size, fd, addr, name, opts, SystemPageSize()) };
+        shm->applyOptions(0, size);
+        return shm;
     }
 
+    CZLog(CZError, CZLN, "Failed to find a unique shm name");
     return {};
 }
 
+std::shared_ptr<CZSharedMemory> CZSharedMemory::MakeMemfd(size_t size, const char *debugName, const Options &options) noexcept
+{
+    Options opts { options };
+    const size_t pageSize { opts.hugetlb ? HugePageSize() : SystemPageSize() };
+
+    // hugetlbfs files can only be truncated to multiples of the huge page size
+    const size_t capacity { opts.hugetlb ? RoundUp(std::max<size_t>(size, 1), pageSize) : size };
+
+    const int fd { memfd_create(debugName ? debugName : "cz-shm", MFD_CLOEXEC | MFD_ALLOW_SEALING | (opts.hugetlb ? MFD_HUGETLB : 0)) };
+
+    if (fd < 0)
+    {
+        if (opts.hugetlb)
+        {
+            CZLog(CZDebug, CZLN, "MFD_HUGETLB not supported, falling back to regular pages");
+            opts.hugetlb = false;
+            return MakeMemfd(size, debugName, opts);
+        }
+
+        if (errno == ENOSYS)
+        {
+            CZLog(CZDebug, CZLN, "memfd_create not supported, falling back to shm_open");
+            return Make(size, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600, opts);
+        }
+
+        CZLog(CZError, CZLN, "memfd_create failed: {}", strerror(errno));
+        return {};
+    }
+
+    if (ftruncate(fd, capacity) < 0)
+    {
+        CZLog(CZError, CZLN, "ftruncate failed: {}", strerror(errno));
+        ::close(fd);
+        return {};
+    }
+
+    void *addr { Map(fd, capacity) };
+
+    if (addr == MAP_FAILED)
+    {
+        ::close(fd);
+
+        // Mapping hugetlb memory fails if not enough huge pages are reserved
+        if (opts.hugetlb)
+        {
+            CZLog(CZDebug, CZLN, "No huge pages available ({}), falling back to regular pages", strerror(errno));
+            opts.hugetlb = false;
+            return MakeMemfd(size, debugName, opts);
+        }
+
+        CZLog(CZError, CZLN, "mmap failed: {}", strerror(errno));
+        return {};
+    }
+
+    std::shared_ptr<CZSharedMemory> shm { new CZSharedMemory(size, capacity, fd, addr, {}, opts, pageSize) };
+    shm->applyOptions(0, capacity);
+    return shm;
+}
+
+void *CZSharedMemory::Map(int fd, size_t size) noexcept
+{
+    // Pages are prefaulted by applyOptions() instead of MAP_POPULATE, so that they are placed after mbind() and madvise()
+    return mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+}
+
+void CZSharedMemory::applyOptions(size_t offset, size_t length) noexcept
+{
+    if (length == 0 || (m_options.numaNode < 0 && !m_options.transparentHugepages && !m_options.populate))
+        return;
+
+    // Advice and policies apply to whole pages
+    const size_t pageSize { SystemPageSize() };
+    const size_t begin { offset / pageSize * pageSize };
+    const size_t end { RoundUp(offset + length, pageSize) };
+    UInt8 *addr { static_cast<UInt8*>(m_map) + begin };
+
+    if (m_options.numaNode >= 0)
+    {
+        constexpr size_t MaxNodes { 1024 };
+        unsigned long nodeMask[MaxNodes / (8 * sizeof(unsigned long))] {};
+        const size_t node { static_cast<size_t>(m_options.numaNode) };
+
+        if (node < MaxNodes)
+        {
+            nodeMask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+
+            if (syscall(SYS_mbind, addr, end - begin, MPOL_PREFERRED, nodeMask, MaxNodes, 0) < 0)
+                CZLog(CZWarning, CZLN, "Failed to place shared memory on NUMA node {}: {}", node, strerror(errno));
+        }
+        else
+            CZLog(CZWarning, CZLN, "Invalid NUMA node {}", node);
+    }
+
+    if (m_options.transparentHugepages && !m_options.hugetlb && madvise(addr, end - begin, MADV_HUGEPAGE) < 0)
+        CZLog(CZDebug, CZLN, "MADV_HUGEPAGE failed: {}", strerror(errno));
+
+    if (!m_options.populate || !m_writable)
+        return;
+
+    // Kernels (or headers) before 5.14 lack MADV_POPULATE_WRITE, fault the pages in by hand
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(addr, end - begin, MADV_POPULATE_WRITE) == 0)
+        return;
+#endif
+
+    const size_t step { m_options.hugetlb ? m_pageSize : pageSize };
+
+    for (size_t i = 0; i < end - begin; i += step)
+        std::atomic_ref<UInt8>(addr[i]).fetch_or(0, std::memory_order_relaxed);
+}
+
 bool CZSharedMemory::resize(size_t newSize) noexcept
 {
-    if (newSize == m_size)
+    if (newSize > m_capacity)
+    {
+        const size_t grown { static_cast<size_t>(static_cast<Float64>(m_capacity) * m_growthFactor) };
+        const size_t target { std::max(newSize, RoundUp(grown, m_pageSize)) };
+
+        // The extra capacity may not fit (e.g. in a size-limited tmpfs), retry with the exact size
+        if (!setCapacity(target) && (target == newSize || !setCapacity(newSize)))
+            return false;
+    }
+    else if (newSize < m_capacity / 4)
+    {
+        // Failing to release memory is harmless, the size is still valid
+        setCapacity(std::max<size_t>(newSize, 1));
+    }
+
+    m_size = newSize;
+    return true;
+}
+
+bool CZSharedMemory::reserve(size_t capacity) noexcept
+{
+    return capacity <= m_capacity || setCapacity(capacity);
+}
+
+bool CZSharedMemory::shrinkToFit() noexcept
+{
+    return setCapacity(std::max<size_t>(m_size, 1));
+}
+
+bool CZSharedMemory::setCapacity(size_t capacity) noexcept
+{
+    if (m_options.hugetlb)
+        capacity = RoundUp(capacity, m_pageSize);
+
+    if (capacity == m_capacity)
         return true;
 
-    if (munmap(m_map, m_size) < 0)
-        return false;
+    const bool grow { capacity > m_capacity };
 
-    if (ftruncate(m_fd, newSize) < 0)
+    // Grow the file first, so that a failure (e.g. a size seal) leaves the current mapping intact
+    if (grow && ftruncate(m_fd, capacity) < 0)
         return false;
 
-    void *newMap { mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0) };
+    // The kernel extends the mapping in place if the following range is free and only moves it otherwise
+    void *newMap { mremap(m_map, m_capacity, capacity, MREMAP_MAYMOVE) };
+
+    // Some mappings (e.g. hugetlb on older kernels) cannot be remapped, map them again
+    if (newMap == MAP_FAILED && errno == EINVAL && m_writable)
+    {
+        newMap = Map(m_fd, capacity);
+
+        if (newMap != MAP_FAILED)
+            munmap(m_map, m_capacity);
+    }
 
     if (newMap == MAP_FAILED)
+    {
+        CZLog(CZError, CZLN, "mremap failed: {}", strerror(errno));
+
+        if (grow)
+            ftruncate(m_fd, m_capacity);
+
         return false;
+    }
 
+    // Shrink the file once nothing maps the tail, if sealed it simply keeps its size
+    if (!grow)
+        ftruncate(m_fd, capacity);
+
+    const size_t oldCapacity { m_capacity };
     m_map = newMap;
-    m_size = newSize;
+    m_capacity = capacity;
+
+    if (grow)
+        applyOptions(oldCapacity, capacity - oldCapacity);
+
     return true;
 }
 
+bool CZSharedMemory::seal(UInt32 seals) noexcept
+{
+    if (!isMemfd())
+        return false;
+
+    // Write seals are refused while writable shared mappings exist
+    const bool dropWrite { (seals & F_SEAL_WRITE) && m_writable };
+
+    if (dropWrite)
+        munmap(m_map, m_capacity);
+
+    if (fcntl(m_fd, F_ADD_SEALS, seals) < 0)
+    {
+        CZLog(CZError, CZLN, "Failed to seal memfd: {}", strerror(errno));
+
+        if (dropWrite)
+        {
+            m_map = mmap(nullptr, m_capacity, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+
+            if (m_map == MAP_FAILED)
+                m_map = nullptr;
+        }
+
+        return false;
+    }
+
+    if (dropWrite)
+    {
+        m_writable = false;
+        m_map = mmap(nullptr, m_capacity, PROT_READ, MAP_SHARED, m_fd, 0);
+
+        if (m_map == MAP_FAILED)
+        {
+            CZLog(CZError, CZLN, "Failed to map sealed memfd: {}", strerror(errno));
+            m_map = nullptr;
+        }
+    }
+
+    return true;
+}
+
+UInt32 CZSharedMemory::seals() const noexcept
+{
+    if (!isMemfd())
+        return 0;
+
+    const int seals { fcntl(m_fd, F_GET_SEALS) };
+    return seals < 0 ? 0 : static_cast<UInt32>(seals);
+}
+
+int CZSharedMemory::openReadOnly() const noexcept
+{
+    if (!isMemfd())
+        return shm_open(m_name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+
+    // A fully sealed region is read-only through any fd, skip the path lookup
+    if ((seals() & SealAll) == SealAll)
+        return fcntl(m_fd, F_DUPFD_CLOEXEC, 0);
+
+    // A new open file description, unlike dup(), so the access mode can differ
+    const std::string path { "/proc/self/fd/" + std::to_string(m_fd) };
+    return open(path.c_str(), O_RDONLY | O_CLOEXEC);
+}
+
 CZSharedMemory::~CZSharedMemory() noexcept
 {
     if (m_map)
-        munmap(m_map, m_size);
+        munmap(m_map, m_capacity);
 
     if (m_fd >= 0)
         ::close(m_fd);
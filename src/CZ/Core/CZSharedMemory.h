@@ -3,26 +3,180 @@
 
 #include <CZ/Core/CZObject.h>
 #include <memory>
+#include <string>
 #include <fcntl.h>
 #include <sys/mman.h>
 
+/**
+ * @brief Shared memory region mapped into the process.
+ *
+ * Make() creates a named POSIX shared memory object under /dev/shm, which other processes can open by name().
+ * MakeMemfd() creates an anonymous `memfd_create()` file instead, which is only reachable through its fd, needs no
+ * unique name and can be sealed, e.g. to share a keymap or a buffer that clients can never modify or resize.
+ */
 class CZ::CZSharedMemory : public CZObject
 {
 public:
-    static std::shared_ptr<CZSharedMemory> Make(size_t size, int oflag = O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, mode_t mode = 0666) noexcept;
+    /// Seals applied by seal() by default: the size and contents can no longer change
+    static constexpr UInt32 SealAll { F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE };
+
+    /**
+     * @brief Placement and faulting options of the pages of a region.
+     *
+     * Large buffers otherwise take a page fault on the first touch of every 4 KiB page, e.g. while rendering the
+     * first frame after a resize. The options are applied again to the memory added by resize().
+     */
+    struct Options
+    {
+        /// Back the region with hugetlbfs pages (`MFD_HUGETLB`, memfd only), rounding the capacity to the huge page
+        /// size. Falls back to regular pages if none are reserved.
+        bool hugetlb { false };
+
+        /// Advise transparent huge pages (`MADV_HUGEPAGE`), effective if shmem THP is set to `advise` or `always`
+        bool transparentHugepages { false };
+
+        /// Prefault all pages on creation and growth, once placed (`MADV_POPULATE_WRITE`, or touching each page on
+        /// kernels before 5.14)
+        bool populate { false };
+
+        /// Preferred NUMA node of the pages (`mbind()` with `MPOL_PREFERRED`), -1 for the default policy
+        Int32 numaNode { -1 };
+    };
+
+    static std::shared_ptr<CZSharedMemory> Make(size_t size, int oflag = O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, mode_t mode = 0666) noexcept
+    {
+        return Make(size, oflag, mode, Options {});
+    }
+
+    static std::shared_ptr<CZSharedMemory> Make(size_t size, int oflag, mode_t mode, const Options &options) noexcept;
+
+    /**
+     * @brief Creates an anonymous, sealable region with `memfd_create()`.
+     *
+     * Falls back to Make() with mode 0600 if memfd is not supported by the kernel.
+     *
+     * @param size Size in bytes.
+     * @param debugName Name shown in `/proc/<pid>/fd`, does not need to be unique.
+     */
+    static std::shared_ptr<CZSharedMemory> MakeMemfd(size_t size, const char *debugName = "cz-shm") noexcept
+    {
+        return MakeMemfd(size, debugName, Options {});
+    }
+
+    /**
+     * @brief Creates a memfd region with the given page options, see Options.
+     */
+    static std::shared_ptr<CZSharedMemory> MakeMemfd(size_t size, const char *debugName, const Options &options) noexcept;
+
+    /**
+     * @brief Options the region was created with, hugetlb is cleared if it fell back to regular pages.
+     */
+    const Options &options() const noexcept { return m_options; }
+
+    /**
+     * @brief Granularity of the capacity, the huge page size for hugetlb regions and the page size otherwise.
+     */
+    size_t pageSize() const noexcept { return m_pageSize; }
+
     int fd() const noexcept { return m_fd; }
+
+    // Empty for memfd regions
     const std::string &name() const noexcept { return m_name; }
+
     void *map() const noexcept { return m_map; }
     size_t size() const noexcept { return m_size; }
+
+    /**
+     * @brief Changes size().
+     *
+     * Sizes within capacity() only update size(). Otherwise the file and the mapping are grown with `mremap()`,
+     * in place if the address range after the mapping is free or moved otherwise, so touched pages stay mapped and
+     * the contents are kept. map() only changes if the mapping was moved.
+     *
+     * When growing, the capacity is multiplied by growthFactor() (at least up to the new size) so that a sequence
+     * of small grows only remaps a logarithmic number of times. It is released when the size drops below a quarter
+     * of it.
+     *
+     * @return `false` on failure (e.g. a size seal), in which case the region is left unchanged.
+     */
     bool resize(size_t size) noexcept;
+
+    /**
+     * @brief Size of the file and the mapping in bytes, at least size().
+     */
+    size_t capacity() const noexcept { return m_capacity; }
+
+    /**
+     * @brief Grows capacity() to at least the given size without changing size().
+     */
+    bool reserve(size_t capacity) noexcept;
+
+    /**
+     * @brief Shrinks capacity() to size().
+     */
+    bool shrinkToFit() noexcept;
+
+    /**
+     * @brief Capacity multiplier applied when resize() grows past capacity(), 2 by default.
+     *
+     * 1 makes the capacity always match the size, e.g. if peers rely on the file size.
+     */
+    void setGrowthFactor(Float32 factor) noexcept { m_growthFactor = factor < 1.f ? 1.f : factor; }
+    Float32 growthFactor() const noexcept { return m_growthFactor; }
+
+    /**
+     * @brief Whether the region was created with MakeMemfd().
+     */
+    bool isMemfd() const noexcept { return m_name.empty(); }
+
+    /**
+     * @brief Whether map() can be written, `false` after sealing with `F_SEAL_WRITE`.
+     */
+    bool isWritable() const noexcept { return m_writable; }
+
+    /**
+     * @brief Adds seals to a memfd region (see `fcntl(2)`).
+     *
+     * `F_SEAL_WRITE` requires dropping the writable mapping, so map() is replaced by a read-only one.
+     * Sealed regions can no longer be resized with resize() if `F_SEAL_SHRINK` or `F_SEAL_GROW` are set.
+     *
+     * @return `false` if the region is not a memfd or the seals could not be added, in which case map() is
+     *         left as it was.
+     */
+    bool seal(UInt32 seals = SealAll) noexcept;
+
+    /**
+     * @brief Seals currently applied, 0 if none or not a memfd.
+     */
+    UInt32 seals() const noexcept;
+
+    /**
+     * @brief Opens a new read-only fd for the region, e.g. to share it with clients.
+     *
+     * memfd regions with all SealAll seals are simply duplicated, since no fd can modify them, and other memfd regions
+     * are reopened through `/proc/self/fd`. Named ones are reopened through `shm_open()`. The caller owns the
+     * returned fd.
+     *
+     * @return The fd or -1 on failure.
+     */
+    int openReadOnly() const noexcept;
+
     ~CZSharedMemory() noexcept;
 private:
-    CZSharedMemory(size_t size, int fd, void *map, const std::string &name) noexcept :
-        m_size(size), m_fd(fd), m_map(map), m_name(name) {}
+    CZSharedMemory(size_t size, size_t capacity, int fd, void *map, const std::string &name, const Options &options, size_t pageSize) noexcept :
+        m_size(size), m_capacity(capacity), m_fd(fd), m_map(map), m_name(name), m_options(options), m_pageSize(pageSize) {}
+    static void *Map(int fd, size_t size) noexcept;
+    void applyOptions(size_t offset, size_t length) noexcept;
+    bool setCapacity(size_t capacity) noexcept;
     size_t m_size;
+    size_t m_capacity;
     int m_fd;
     void *m_map;
     std::string m_name;
+    Options m_options;
+    size_t m_pageSize;
+    Float32 m_growthFactor { 2.f };
+    bool m_writable { true };
 };
 
 #endif // CZSHAREDMEMORY_H
@@ -0,0 +1,236 @@
+#include <CZ/Core/CZSharedMemoryPool.h>
+#include <CZ/Core/CZLog.h>
+#include <CZ/Core/CZTime.h>
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace CZ;
+
+static UInt64 NowNs() noexcept
+{
+    const timespec ts { CZTime::Ns() };
+    return static_cast<UInt64>(ts.tv_sec) * 1000000000 + static_cast<UInt64>(ts.tv_nsec);
+}
+
+static void AddLatency(UInt64 &total, UInt64 &max, UInt64 begin) noexcept
+{
+    const UInt64 ns { NowNs() - begin };
+    total += ns;
+    max = std::max(max, ns);
+}
+
+std::shared_ptr<CZSharedMemoryPool> CZSharedMemoryPool::Make(size_t initialSize, size_t alignment) noexcept
+{
+    if (!std::has_single_bit(alignment))
+    {
+        CZLog(CZError, CZLN, "Invalid alignment {}, must be a power of two", alignment);
+        return {};
+    }
+
+    initialSize = (std::max(initialSize, alignment) + alignment - 1) & ~(alignment - 1);
+    auto memory { CZSharedMemory::MakeMemfd(initialSize, "cz-shm-pool") };
+
+    if (!memory)
+        return {};
+
+    // The pool doubles the region itself, its file size must match size() for wl_shm_pool
+    memory->setGrowthFactor(1.f);
+    return std::shared_ptr<CZSharedMemoryPool>(new CZSharedMemoryPool(memory, alignment));
+}
+
+CZSharedMemoryPool::CZSharedMemoryPool(std::shared_ptr<CZSharedMemory> memory, size_t alignment) noexcept :
+    m_memory(memory),
+    m_alignment(alignment)
+{
+    insertFree(0, m_memory->size());
+}
+
+CZSharedMemoryPool::Slice CZSharedMemoryPool::alloc(size_t size) noexcept
+{
+    const UInt64 begin { NowNs() };
+    const Slice slice { allocate(size) };
+    AddLatency(m_allocNs, m_maxAllocNs, begin);
+    return slice;
+}
+
+CZSharedMemoryPool::Slice CZSharedMemoryPool::allocate(size_t size) noexcept
+{
+    if (size == 0)
+    {
+        m_failures++;
+        return {};
+    }
+
+    size = (size + m_alignment - 1) & ~(m_alignment - 1);
+
+    auto fit { m_freeBySize.lower_bound({ size, 0 }) };
+
+    if (fit == m_freeBySize.end())
+    {
+        if (!grow(size))
+        {
+            m_failures++;
+            return {};
+        }
+
+        fit = m_freeBySize.lower_bound({ size, 0 });
+    }
+
+    const auto [rangeSize, offset] { *fit };
+    eraseFree(m_freeByOffset.find(offset));
+
+    if (rangeSize > size)
+        insertFree(offset + size, rangeSize - size);
+
+    m_slices.emplace(offset, size);
+    m_used += size;
+    m_allocations++;
+    return { offset, size };
+}
+
+void CZSharedMemoryPool::free(Slice slice) noexcept
+{
+    const auto it { m_slices.find(slice.offset) };
+
+    if (it == m_slices.end() || it->second != slice.size)
+    {
+        CZLog(CZWarning, CZLN, "Ignoring unknown slice (offset {}, size {})", slice.offset, slice.size);
+        return;
+    }
+
+    m_slices.erase(it);
+    m_used -= slice.size;
+    m_frees++;
+
+    size_t offset { slice.offset };
+    size_t size { slice.size };
+
+    // Coalesce with the following range
+    auto next { m_freeByOffset.find(offset + size) };
+
+    if (next != m_freeByOffset.end())
+    {
+        size += next->second;
+        eraseFree(next);
+    }
+
+    // And the previous one
+    auto prev { m_freeByOffset.lower_bound(offset) };
+
+    if (prev != m_freeByOffset.begin())
+    {
+        prev--;
+
+        if (prev->first + prev->second == offset)
+        {
+            offset = prev->first;
+            size += prev->second;
+            eraseFree(prev);
+        }
+    }
+
+    insertFree(offset, size);
+}
+
+size_t CZSharedMemoryPool::trim() noexcept
+{
+    if (m_freeByOffset.empty())
+        return 0;
+
+    const auto &[offset, size] { *m_freeByOffset.rbegin() };
+
+    if (offset + size != m_memory->size())
+        return 0;
+
+    const size_t pageSize { static_cast<size_t>(sysconf(_SC_PAGESIZE)) };
+    const size_t begin { (offset + pageSize - 1) & ~(pageSize - 1) };
+    const size_t end { m_memory->size() & ~(pageSize - 1) };
+
+    if (begin >= end)
+        return 0;
+
+    if (fallocate(m_memory->fd(), FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, begin, end - begin) < 0)
+    {
+        CZLog(CZWarning, CZLN, "Failed to release pool pages: {}", strerror(errno));
+        return 0;
+    }
+
+    return end - begin;
+}
+
+CZSharedMemoryPool::Stats CZSharedMemoryPool::stats() const noexcept
+{
+    Stats stats {};
+    stats.size = m_memory->size();
+    stats.used = m_used;
+    stats.free = stats.size - m_used;
+    stats.largestFree = m_freeBySize.empty() ? 0 : m_freeBySize.rbegin()->first;
+    stats.freeRanges = m_freeByOffset.size();
+    stats.slices = m_slices.size();
+    stats.fragmentation = stats.free == 0 ? 0.0 : 1.0 - static_cast<Float64>(stats.largestFree) / static_cast<Float64>(stats.free);
+    stats.allocations = m_allocations;
+    stats.frees = m_frees;
+    stats.grows = m_grows;
+    stats.failures = m_failures;
+    stats.allocNs = m_allocNs;
+    stats.maxAllocNs = m_maxAllocNs;
+    stats.growNs = m_growNs;
+    stats.maxGrowNs = m_maxGrowNs;
+    return stats;
+}
+
+bool CZSharedMemoryPool::grow(size_t minFree) noexcept
+{
+    const size_t oldSize { m_memory->size() };
+
+    // A free range at the end only needs to be extended by the difference
+    size_t tailFree { 0 };
+
+    if (!m_freeByOffset.empty())
+    {
+        const auto &[offset, size] { *m_freeByOffset.rbegin() };
+
+        if (offset + size == oldSize)
+            tailFree = size;
+    }
+
+    const size_t newSize { std::max(oldSize * 2, oldSize - tailFree + minFree) };
+    const UInt64 begin { NowNs() };
+    const bool resized { m_memory->resize(newSize) };
+    AddLatency(m_growNs, m_maxGrowNs, begin);
+
+    if (!resized)
+    {
+        CZLog(CZError, CZLN, "Failed to grow the pool from {} to {} bytes", oldSize, newSize);
+        return false;
+    }
+
+    m_grows++;
+
+    if (tailFree > 0)
+    {
+        const size_t offset { oldSize - tailFree };
+        eraseFree(m_freeByOffset.find(offset));
+        insertFree(offset, newSize - offset);
+    }
+    else
+        insertFree(oldSize, newSize - oldSize);
+
+    return true;
+}
+
+void CZSharedMemoryPool::insertFree(size_t offset, size_t size) noexcept
+{
+    m_freeByOffset.emplace(offset, size);
+    m_freeBySize.emplace(size, offset);
+}
+
+void CZSharedMemoryPool::eraseFree(std::map<size_t, size_t>::iterator it) noexcept
+{
+    m_freeBySize.erase({ it->second, it->first });
+    m_freeByOffset.erase(it);
+}
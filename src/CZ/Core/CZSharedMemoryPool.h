@@ -0,0 +1,188 @@
+#ifndef CZ_CZSHAREDMEMORYPOOL_H
+#define CZ_CZSHAREDMEMORYPOOL_H
+
+#include <CZ/Core/CZObject.h>
+#include <CZ/Core/CZSharedMemory.h>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+
+/**
+ * @brief Sub-allocator of buffers within a single shared memory region.
+ *
+ * Creating a CZSharedMemory per buffer costs an fd, a truncation and a mapping each time. A pool instead carves
+ * buffers out of one memfd region with a best-fit free list that coalesces adjacent free ranges. Each buffer is an
+ * (offset, size) slice of the region, which maps directly to `wl_shm_pool_create_buffer()` offsets, with the pool
+ * itself created once from memory()->fd() and size().
+ *
+ * When no free range fits, the region is grown with CZSharedMemory::resize(), at least doubling it. Growing only
+ * extends the region (like `wl_shm_pool_resize()`) so existing offsets stay valid, but the mapping may move: get
+ * pointers with data() after allocating instead of caching them. trim() returns the memory of the unused tail to
+ * the system without shrinking the file, so peers mapping the pool are not affected.
+ *
+ * @code
+ * auto pool { CZSharedMemoryPool::Make(4 * 1024 * 1024) };
+ * auto wlPool { wl_shm_create_pool(shm, pool->memory()->fd(), pool->size()) };
+ * ...
+ * const auto slice { pool->alloc(stride * height) };
+ *
+ * if (pool->size() != wlPoolSize)
+ *     wl_shm_pool_resize(wlPool, pool->size());
+ *
+ * auto buffer { wl_shm_pool_create_buffer(wlPool, slice.offset, width, height, stride, format) };
+ * draw(pool->data(slice));
+ * ...
+ * pool->free(slice);
+ * @endcode
+ */
+class CZ::CZSharedMemoryPool : public CZObject
+{
+public:
+
+    /**
+     * @brief A buffer within the pool.
+     */
+    struct Slice
+    {
+        /// Offset from the start of the region in bytes
+        size_t offset { 0 };
+
+        /// Size in bytes (rounded up to the alignment), 0 if invalid
+        size_t size { 0 };
+
+        explicit operator bool() const noexcept { return size > 0; }
+    };
+
+    /**
+     * @brief Usage counters, see stats().
+     */
+    struct Stats
+    {
+        /// Size of the region
+        size_t size;
+
+        /// Bytes in allocated slices
+        size_t used;
+
+        /// Bytes in free ranges
+        size_t free;
+
+        /// Largest free range, the largest slice that fits without growing
+        size_t largestFree;
+
+        /// Number of free ranges
+        size_t freeRanges;
+
+        /// Number of allocated slices
+        size_t slices;
+
+        /// Share of free bytes outside the largest free range, from 0 (one free range) to 1
+        Float64 fragmentation;
+
+        UInt64 allocations;
+        UInt64 frees;
+
+        /// Times the region was grown
+        UInt64 grows;
+
+        /// Allocations that failed
+        UInt64 failures;
+
+        /// Time spent in alloc() in nanoseconds, including grows, divide by allocations + failures for the mean
+        UInt64 allocNs;
+
+        /// Slowest alloc() call in nanoseconds
+        UInt64 maxAllocNs;
+
+        /// Time spent resizing the region in nanoseconds
+        UInt64 growNs;
+
+        /// Slowest resize in nanoseconds
+        UInt64 maxGrowNs;
+    };
+
+    /**
+     * @brief Creates a pool backed by a memfd region.
+     *
+     * @param initialSize Initial size of the region in bytes.
+     * @param alignment Alignment of the offsets and sizes of slices, a power of two (64 by default, a cache line).
+     */
+    static std::shared_ptr<CZSharedMemoryPool> Make(size_t initialSize, size_t alignment = 64) noexcept;
+
+    /**
+     * @brief Allocates a slice, growing the region if needed.
+     *
+     * @return The slice or an invalid one (size 0) if the size is 0 or the region could not grow.
+     */
+    Slice alloc(size_t size) noexcept;
+
+    /**
+     * @brief Returns a slice to the pool.
+     *
+     * Unknown or already freed slices are ignored.
+     */
+    void free(Slice slice) noexcept;
+
+    /**
+     * @brief Start of the slice in the current mapping.
+     */
+    void *data(Slice slice) const noexcept { return static_cast<UInt8*>(m_memory->map()) + slice.offset; }
+
+    /**
+     * @brief The underlying region, share its fd to create a `wl_shm_pool`.
+     */
+    const std::shared_ptr<CZSharedMemory> &memory() const noexcept { return m_memory; }
+
+    /**
+     * @brief Size of the region in bytes, only grows.
+     */
+    size_t size() const noexcept { return m_memory->size(); }
+
+    /**
+     * @brief Alignment of slices.
+     */
+    size_t alignment() const noexcept { return m_alignment; }
+
+    /**
+     * @brief Releases the pages of the free range at the end of the region.
+     *
+     * The region keeps its size and the pages read as zeros when reused.
+     *
+     * @return Number of bytes released.
+     */
+    size_t trim() noexcept;
+
+    /**
+     * @brief Current usage, lifetime counters and allocation latency.
+     */
+    Stats stats() const noexcept;
+
+private:
+    CZSharedMemoryPool(std::shared_ptr<CZSharedMemory> memory, size_t alignment) noexcept;
+    Slice allocate(size_t size) noexcept;
+    bool grow(size_t minFree) noexcept;
+    void insertFree(size_t offset, size_t size) noexcept;
+    void eraseFree(std::map<size_t, size_t>::iterator it) noexcept;
+    std::shared_ptr<CZSharedMemory> m_memory;
+
+    // Free ranges by offset (to coalesce neighbours) and by (size, offset) (for best fit)
+    std::map<size_t, size_t> m_freeByOffset;
+    std::set<std::pair<size_t, size_t>> m_freeBySize;
+
+    // Allocated slices by offset, to validate frees
+    std::unordered_map<size_t, size_t> m_slices;
+
+    size_t m_alignment;
+    size_t m_used { 0 };
+    UInt64 m_allocations { 0 };
+    UInt64 m_frees { 0 };
+    UInt64 m_grows { 0 };
+    UInt64 m_failures { 0 };
+    UInt64 m_allocNs { 0 };
+    UInt64 m_maxAllocNs { 0 };
+    UInt64 m_growNs { 0 };
+    UInt64 m_maxGrowNs { 0 };
+};
+
+#endif // CZ_CZSHAREDMEMORYPOOL_H
@@ -0,0 +1,404 @@
+#include <CZ/Core/CZShmRing.h>
+#include <CZ/Core/CZSharedMemory.h>
+#include <CZ/Core/CZEventSource.h>
+#include <CZ/Core/CZLog.h>
+#include <CZ/Core/CZTime.h>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+
+using namespace CZ;
+
+/*
+ * Start of the region. head and tail are monotonic byte positions, the free space is capacity - (head - tail).
+ * Each message is an 8 byte header (its size) followed by the payload padded to 8 bytes. Messages never wrap:
+ * when one does not fit before the end, the producer writes a Wrap header and continues at the start.
+ */
+struct CZShmRing::Control
+{
+    static constexpr UInt32 Magic { 0x52534d43 }; // "CMSR"
+    static constexpr UInt32 Version { 1 };
+    static constexpr UInt32 Wrap { UINT32_MAX };
+
+    UInt32 magic;
+    UInt32 version;
+    UInt64 capacity;
+    alignas(64) std::atomic<UInt64> head;
+    alignas(64) std::atomic<UInt64> tail;
+
+    // Messages start on the cache line after the control block
+    static constexpr size_t DataOffset() noexcept { return (sizeof(Control) + 63) & ~size_t(63); }
+};
+
+static_assert(std::atomic<UInt64>::is_always_lock_free, "Cross-process atomics must be lock-free");
+
+static constexpr size_t Padded(size_t size) noexcept
+{
+    return (size + 7) & ~size_t(7);
+}
+
+std::shared_ptr<CZShmRing> CZShmRing::Make(size_t capacity, Role role) noexcept
+{
+    capacity = std::bit_ceil(std::max(capacity, size_t(4096)));
+
+    auto memory { CZSharedMemory::MakeMemfd(Control::DataOffset() + capacity, "cz-shm-ring") };
+
+    if (!memory)
+        return {};
+
+    // The peer could otherwise truncate the region and crash this process with SIGBUS on its next access
+    if (!memory->seal(F_SEAL_SHRINK | F_SEAL_GROW))
+        return {};
+
+    CZSpFd eventFd { eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK) };
+
+    if (eventFd.get() < 0)
+    {
+        CZLog(CZError, CZLN, "eventfd failed: {}", strerror(errno));
+        return {};
+    }
+
+    auto *control { new (memory->map()) Control() };
+    control->magic = Control::Magic;
+    control->version = Control::Version;
+    control->capacity = capacity;
+    void *map { memory->map() };
+    return std::shared_ptr<CZShmRing>(new CZShmRing(role, memory, map, memory->size(), std::move(eventFd)));
+}
+
+std::shared_ptr<CZShmRing> CZShmRing::Open(int memoryFd, int eventFd, Role role) noexcept
+{
+    struct stat st;
+
+    if (fstat(memoryFd, &st) != 0 || static_cast<size_t>(st.st_size) < Control::DataOffset())
+    {
+        CZLog(CZError, CZLN, "Invalid ring region fd {}", memoryFd);
+        return {};
+    }
+
+    // Without a shrink seal the creator could truncate the region under our mapping
+    const int seals { fcntl(memoryFd, F_GET_SEALS) };
+
+    if (seals < 0 || !(seals & F_SEAL_SHRINK))
+    {
+        CZLog(CZError, CZLN, "The ring region fd {} is not sealed against shrinking", memoryFd);
+        return {};
+    }
+
+    const size_t mapSize { static_cast<size_t>(st.st_size) };
+    void *map { mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, memoryFd, 0) };
+
+    if (map == MAP_FAILED)
+    {
+        CZLog(CZError, CZLN, "Failed to map the ring region: {}", strerror(errno));
+        return {};
+    }
+
+    const auto *control { static_cast<const Control*>(map) };
+    const UInt64 capacity { control->capacity };
+    const UInt64 head { control->head.load(std::memory_order_acquire) };
+    const UInt64 tail { control->tail.load(std::memory_order_acquire) };
+
+    if (control->magic != Control::Magic || control->version != Control::Version || capacity < 4096 ||
+        !std::has_single_bit(capacity) || capacity > mapSize - Control::DataOffset() || head < tail || head - tail > capacity)
+    {
+        CZLog(CZError, CZLN, "Invalid ring region layout");
+        munmap(map, mapSize);
+        return {};
+    }
+
+    CZSpFd eventFdCopy { fcntl(eventFd, F_DUPFD_CLOEXEC, 0) };
+
+    if (eventFdCopy.get() < 0)
+    {
+        CZLog(CZError, CZLN, "Failed to dup the ring eventfd {}", eventFd);
+        munmap(map, mapSize);
+        return {};
+    }
+
+    return std::shared_ptr<CZShmRing>(new CZShmRing(role, {}, map, mapSize, std::move(eventFdCopy)));
+}
+
+CZShmRing::CZShmRing(Role role, std::shared_ptr<CZSharedMemory> memory, void *map, size_t mapSize, CZSpFd &&eventFd) noexcept :
+    m_memory(memory),
+    m_eventFd(std::move(eventFd)),
+    m_control(static_cast<Control*>(map)),
+    m_data(static_cast<UInt8*>(map) + Control::DataOffset()),
+    m_map(map),
+    m_mapSize(mapSize),
+    m_capacity(m_control->capacity),
+    m_role(role)
+{
+    m_head = m_cachedHead = m_control->head.load(std::memory_order_acquire);
+    m_tail = m_cachedTail = m_control->tail.load(std::memory_order_acquire);
+}
+
+CZShmRing::~CZShmRing() noexcept
+{
+    m_source.reset();
+
+    if (!m_memory)
+        munmap(m_map, m_mapSize);
+}
+
+int CZShmRing::memoryFd() const noexcept
+{
+    return m_memory ? m_memory->fd() : -1;
+}
+
+void *CZShmRing::reserve(size_t size) noexcept
+{
+    if (m_role != Role::Producer)
+    {
+        CZLog(CZError, CZLN, "Only the producer can reserve messages");
+        return nullptr;
+    }
+
+    m_reserving = false;
+
+    if (size > maxMessageSize())
+        return nullptr;
+
+    const size_t length { HeaderSize + Padded(size) };
+    const size_t untilEnd { m_capacity - (m_head & (m_capacity - 1)) };
+    const size_t skip { untilEnd < length ? untilEnd : 0 };
+
+    if (m_head + skip + length - m_cachedTail > m_capacity)
+    {
+        m_cachedTail = m_control->tail.load(std::memory_order_acquire);
+
+        if (m_head + skip + length - m_cachedTail > m_capacity)
+        {
+            m_fullCount++;
+            return nullptr;
+        }
+    }
+
+    // Not visible to the consumer until commit() moves the head past it
+    if (skip)
+        *reinterpret_cast<UInt32*>(at(m_head)) = Control::Wrap;
+
+    m_reserved = m_head + skip;
+    m_reservedSize = size;
+    m_reserving = true;
+    return at(m_reserved) + HeaderSize;
+}
+
+bool CZShmRing::commit(size_t size) noexcept
+{
+    if (!m_reserving)
+        return false;
+
+    m_reserving = false;
+    size = std::min(size, m_reservedSize);
+    *reinterpret_cast<UInt32*>(at(m_reserved)) = static_cast<UInt32>(size);
+
+    const UInt64 prevHead { m_head };
+    m_head = m_reserved + HeaderSize + Padded(size);
+    m_control->head.store(m_head, std::memory_order_release);
+
+    // Pairs with the fence in peek(): either the consumer sees the new head or we see that it drained the ring.
+    // Acquire because the cached tail also lets reserve() reuse the space the consumer released
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    m_cachedTail = m_control->tail.load(std::memory_order_acquire);
+
+    if (m_cachedTail == prevHead)
+        wake();
+
+    return true;
+}
+
+bool CZShmRing::push(const void *data, size_t size) noexcept
+{
+    void *dst { reserve(size) };
+
+    if (!dst)
+        return false;
+
+    if (size > 0)
+        std::memcpy(dst, data, size);
+
+    return commit();
+}
+
+std::span<const UInt8> CZShmRing::peek() noexcept
+{
+    if (m_role != Role::Consumer)
+    {
+        CZLog(CZError, CZLN, "Only the consumer can read messages");
+        return {};
+    }
+
+    if (m_peeking)
+        return { at(m_tail) + HeaderSize, m_peekedSize };
+
+    while (true)
+    {
+        if (m_tail == m_cachedHead)
+        {
+            // Pairs with the fence in commit(), see there
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            m_cachedHead = m_control->head.load(std::memory_order_acquire);
+
+            if (m_tail == m_cachedHead)
+                return {};
+        }
+
+        // Read once, the peer may be writing garbage
+        const UInt32 size { *reinterpret_cast<const volatile UInt32*>(at(m_tail)) };
+
+        if (size == Control::Wrap)
+        {
+            // Like messages, the skipped bytes must have been published
+            const size_t skip { m_capacity - (m_tail & (m_capacity - 1)) };
+
+            if (skip <= m_cachedHead - m_tail)
+            {
+                m_tail += skip;
+                continue;
+            }
+        }
+        else
+        {
+            const size_t length { HeaderSize + Padded(size) };
+
+            if (size <= maxMessageSize() && length <= m_cachedHead - m_tail &&
+                (m_tail & (m_capacity - 1)) + length <= m_capacity)
+            {
+                m_peekedSize = size;
+                m_peeking = true;
+                return { at(m_tail) + HeaderSize, m_peekedSize };
+            }
+        }
+
+        CZLog(CZError, CZLN, "Corrupted message of size {}, dropping {} bytes", size, m_cachedHead - m_tail);
+        m_tail = m_cachedHead;
+        m_control->tail.store(m_tail, std::memory_order_release);
+    }
+}
+
+void CZShmRing::pop() noexcept
+{
+    if (!m_peeking && empty())
+        return;
+
+    m_peeking = false;
+    m_tail += HeaderSize + Padded(m_peekedSize);
+    m_control->tail.store(m_tail, std::memory_order_release);
+}
+
+size_t CZShmRing::drain(const Handler &handler, size_t max) noexcept
+{
+    size_t count { 0 };
+
+    while (count < max)
+    {
+        const auto message { peek() };
+
+        if (!m_peeking)
+            break;
+
+        handler(message);
+        pop();
+        count++;
+    }
+
+    return count;
+}
+
+bool CZShmRing::setCallback(const Callback &callback) noexcept
+{
+    if (m_role != Role::Consumer)
+    {
+        CZLog(CZError, CZLN, "Only the consumer can watch the ring");
+        return false;
+    }
+
+    m_callback = callback;
+
+    if (!m_callback)
+    {
+        m_source.reset();
+        return true;
+    }
+
+    if (m_source)
+        return true;
+
+    m_source = CZEventSource::Make(m_eventFd.get(), EPOLLIN, CZOwn::Borrow, [this](int, UInt32, auto) {
+        onEvent();
+    });
+
+    if (!m_source)
+    {
+        CZLog(CZError, CZLN, "Failed to create CZEventSource");
+        return false;
+    }
+
+    // Messages committed before watching did not necessarily signal
+    if (!empty())
+        wake();
+
+    return true;
+}
+
+bool CZShmRing::wait(Int32 timeoutMs) noexcept
+{
+    if (m_role != Role::Consumer)
+    {
+        CZLog(CZError, CZLN, "Only the consumer can wait for messages");
+        return false;
+    }
+
+    const UInt64 deadline { CZTime::Us() + static_cast<UInt64>(std::max(timeoutMs, 0)) * 1000 };
+
+    while (empty())
+    {
+        Int32 remainingMs { -1 };
+
+        if (timeoutMs >= 0)
+        {
+            const UInt64 now { CZTime::Us() };
+
+            if (now >= deadline)
+                return false;
+
+            remainingMs = static_cast<Int32>((deadline - now + 999) / 1000);
+        }
+
+        pollfd pfd { m_eventFd.get(), POLLIN, 0 };
+
+        if (poll(&pfd, 1, remainingMs) < 0 && errno != EINTR)
+        {
+            CZLog(CZError, CZLN, "poll failed: {}", strerror(errno));
+            return false;
+        }
+
+        eventfd_t value;
+        eventfd_read(m_eventFd.get(), &value);
+    }
+
+    return true;
+}
+
+void CZShmRing::wake() noexcept
+{
+    m_wakeups++;
+    eventfd_write(m_eventFd.get(), 1);
+}
+
+void CZShmRing::onEvent() noexcept
+{
+    eventfd_t value;
+    eventfd_read(m_eventFd.get(), &value);
+
+    if (m_callback)
+        m_callback(this);
+
+    // Leftovers (e.g. a drain() with a limit) are delivered on the next loop iteration
+    if (m_source && !empty())
+        wake();
+}
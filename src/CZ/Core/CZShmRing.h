@@ -0,0 +1,225 @@
+#ifndef CZ_CZSHMRING_H
+#define CZ_CZSHMRING_H
+
+#include <CZ/Core/CZObject.h>
+#include <CZ/Core/CZSpFd.h>
+#include <functional>
+#include <memory>
+#include <span>
+
+/**
+ * @brief Single-producer/single-consumer message ring shared between two processes.
+ *
+ * Messages are written directly into a memfd region mapped by both processes, so passing one costs no syscall
+ * and no copy: the producer fills the memory returned by reserve() and publishes it with commit(), the consumer
+ * reads it in place with peek() and releases it with pop().
+ *
+ * The head (written by the producer) and the tail (written by the consumer) live on separate cache lines and are
+ * only read by the other side when its cached copy says the ring is full or empty. The consumer is woken through
+ * an eventfd, which the producer only signals when a commit makes an empty ring non-empty, so a consumer draining
+ * the ring on each wakeup costs a single `write()`/`read()` pair per burst instead of one per message.
+ *
+ * One side creates the ring with Make() and sends memoryFd() and eventFd() to the other (e.g. over a Unix socket),
+ * which opens it with Open() in the opposite role.
+ *
+ * @code
+ * // Producer
+ * if (auto *sample { static_cast<Sample*>(ring->reserve(sizeof(Sample))) })
+ * {
+ *     *sample = ...;
+ *     ring->commit();
+ * }
+ *
+ * // Consumer
+ * ring->setCallback([](CZShmRing *ring) {
+ *     ring->drain([](std::span<const UInt8> message) { ... });
+ * });
+ * @endcode
+ */
+class CZ::CZShmRing : public CZObject
+{
+public:
+
+    /**
+     * @brief Side of the ring used by this process.
+     */
+    enum class Role
+    {
+        Producer,
+        Consumer
+    };
+
+    /**
+     * @brief Called from the event loop when messages are available, see setCallback().
+     */
+    using Callback = std::function<void(CZShmRing *ring)>;
+
+    /**
+     * @brief Receives a message in drain(), only valid during the call.
+     */
+    using Handler = std::function<void(std::span<const UInt8> message)>;
+
+    /**
+     * @brief Creates a ring backed by a new memfd region and eventfd.
+     *
+     * @param capacity Bytes available for messages, rounded up to a power of two (at least 4 KiB).
+     * @param role Side used by this process.
+     */
+    static std::shared_ptr<CZShmRing> Make(size_t capacity, Role role) noexcept;
+
+    /**
+     * @brief Opens a ring created by another process.
+     *
+     * The layout of the region is validated and it must be sealed against shrinking, as done by Make(). Message
+     * headers are checked as they are read, a corrupted ring is emptied instead of trusted. Both fds are borrowed: the region stays mapped and the eventfd is
+     * duplicated, so the caller can close them afterwards.
+     *
+     * @param role Side used by this process, the opposite of the creator.
+     */
+    static std::shared_ptr<CZShmRing> Open(int memoryFd, int eventFd, Role role) noexcept;
+
+    ~CZShmRing() noexcept;
+
+    Role role() const noexcept { return m_role; }
+
+    /**
+     * @brief fd of the shared region, only valid in the process that created the ring.
+     */
+    int memoryFd() const noexcept;
+
+    /**
+     * @brief The eventfd used to wake the consumer.
+     */
+    int eventFd() const noexcept { return m_eventFd.get(); }
+
+    /**
+     * @brief Bytes available for messages, including an 8 byte header per message.
+     */
+    size_t capacity() const noexcept { return m_capacity; }
+
+    /**
+     * @brief Largest message that always fits in an empty ring.
+     */
+    size_t maxMessageSize() const noexcept { return m_capacity / 2 - HeaderSize; }
+
+    /**
+     * @brief Reserves space for a message of the given size.
+     *
+     * Producer only. The memory is 8 byte aligned and stays reserved until commit(), a later reserve() replaces
+     * the reservation.
+     *
+     * @return Pointer to write the message into or `nullptr` if the ring is full or the size exceeds
+     *         maxMessageSize().
+     */
+    void *reserve(size_t size) noexcept;
+
+    /**
+     * @brief Publishes the reserved message, waking the consumer if the ring was empty.
+     *
+     * @param size Final size of the message, at most the reserved one (the reserved size by default).
+     * @return `false` if nothing was reserved.
+     */
+    bool commit(size_t size = SIZE_MAX) noexcept;
+
+    /**
+     * @brief Copies and publishes a message, see reserve().
+     *
+     * @return `false` if the ring is full.
+     */
+    bool push(const void *data, size_t size) noexcept;
+
+    /**
+     * @brief The oldest message, read in place.
+     *
+     * Consumer only. The memory remains valid until pop().
+     *
+     * @return The message or an empty span if the ring is empty (use empty() to tell it apart from an empty message).
+     */
+    std::span<const UInt8> peek() noexcept;
+
+    /**
+     * @brief Releases the message returned by peek().
+     */
+    void pop() noexcept;
+
+    /**
+     * @brief Passes messages to the handler and pops them until the ring is empty.
+     *
+     * @param max Maximum number of messages to consume.
+     * @return Number of messages consumed.
+     */
+    size_t drain(const Handler &handler, size_t max = SIZE_MAX) noexcept;
+
+    /**
+     * @brief Whether there are no messages to consume.
+     */
+    bool empty() noexcept { peek(); return !m_peeking; }
+
+    /**
+     * @brief Watches the eventfd from the CZCore event loop.
+     *
+     * Consumer only. The callback is expected to consume the messages. If some are left, it is called again on the
+     * next loop iteration. Passing `nullptr` removes the event source.
+     *
+     * @return `false` if there is no CZCore or the ring is not a consumer.
+     */
+    bool setCallback(const Callback &callback) noexcept;
+
+    /**
+     * @brief Blocks until the ring is not empty, for processes without a CZCore loop.
+     *
+     * Consumer only.
+     *
+     * @param timeoutMs Maximum time to wait, -1 to wait indefinitely.
+     * @return `true` if there are messages to consume.
+     */
+    bool wait(Int32 timeoutMs = -1) noexcept;
+
+    /**
+     * @brief Number of times this producer woke the consumer.
+     */
+    UInt64 wakeups() const noexcept { return m_wakeups; }
+
+    /**
+     * @brief Number of reserve() calls that failed because the ring was full.
+     */
+    UInt64 fullCount() const noexcept { return m_fullCount; }
+
+private:
+    static constexpr size_t HeaderSize { 8 };
+    struct Control;
+    CZShmRing(Role role, std::shared_ptr<CZSharedMemory> memory, void *map, size_t mapSize, CZSpFd &&eventFd) noexcept;
+    UInt8 *at(UInt64 position) const noexcept { return m_data + (position & (m_capacity - 1)); }
+    void wake() noexcept;
+    void onEvent() noexcept;
+
+    // Set in the creating process, otherwise the region is mapped by Open()
+    std::shared_ptr<CZSharedMemory> m_memory;
+    std::shared_ptr<CZEventSource> m_source;
+    Callback m_callback;
+    CZSpFd m_eventFd;
+    Control *m_control;
+    UInt8 *m_data;
+    void *m_map;
+    size_t m_mapSize;
+    size_t m_capacity;
+
+    // Producer: position of the next message, start of the reservation and cached consumer tail
+    UInt64 m_head {};
+    UInt64 m_reserved {};
+    size_t m_reservedSize {};
+    UInt64 m_cachedTail {};
+
+    // Consumer: position of the next message and cached producer head
+    UInt64 m_tail {};
+    UInt64 m_cachedHead {};
+    size_t m_peekedSize {};
+
+    UInt64 m_wakeups {};
+    UInt64 m_fullCount {};
+    Role m_role;
+    bool m_reserving { false };
+    bool m_peeking { false };
+};
+
+#endif // CZ_CZSHMRING_H
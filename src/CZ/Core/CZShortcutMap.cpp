@@ -0,0 +1,237 @@
+#include <CZ/Core/CZShortcutMap.h>
+#include <CZ/Core/CZLog.h>
+#include <CZ/Core/Events/CZKeyboardKeyEvent.h>
+#include <algorithm>
+#include <bit>
+
+using namespace CZ;
+
+static constexpr size_t MinCapacity { 64 };
+
+// Keys that only change modifiers must not break a pending sequence
+static bool IsModifierSymbol(xkb_keysym_t symbol) noexcept
+{
+    return (symbol >= XKB_KEY_Shift_L && symbol <= XKB_KEY_Hyper_R) ||
+           (symbol >= XKB_KEY_ISO_Lock && symbol <= XKB_KEY_ISO_Last_Group_Lock) ||
+           symbol == XKB_KEY_Mode_switch ||
+           symbol == XKB_KEY_Num_Lock;
+}
+
+// Most shortcuts use ASCII or function keys, skip the table lookups of xkb for them
+static xkb_keysym_t ToLower(xkb_keysym_t symbol) noexcept
+{
+    if (symbol < 0x80)
+        return (symbol >= 'A' && symbol <= 'Z') ? symbol + ('a' - 'A') : symbol;
+
+    // Function, cursor, keypad and modifier keys have no case
+    if (symbol >= 0xff00 && symbol <= 0xffff)
+        return symbol;
+
+    return xkb_keysym_to_lower(symbol);
+}
+
+// splitmix64 finalizer, spreads the few varying bits of the keysym over the whole table
+static UInt64 Hash(UInt64 key) noexcept
+{
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+UInt64 CZShortcutMap::Key(UInt32 state, Chord chord) noexcept
+{
+    return (UInt64(state) << 40) | (UInt64(chord.modifiers & Modifiers) << 32) | ToLower(chord.symbol);
+}
+
+bool CZShortcutMap::add(std::span<const Chord> sequence, UInt32 id) noexcept
+{
+    if (sequence.empty() || sequence.size() > MaxSequence || (id & StateBit))
+    {
+        CZLog(CZError, CZLN, "Invalid shortcut (length {}, id {})", sequence.size(), id);
+        return false;
+    }
+
+    // Walk the existing prefix first so that conflicts leave the table untouched
+    UInt32 state { 0 };
+    size_t i { 0 };
+
+    for (; i < sequence.size(); i++)
+    {
+        const Slot *slot { lookup(Key(state, sequence[i])) };
+
+        if (!slot)
+            break;
+
+        // Either a binding is a prefix of this one, or this one is already bound or a prefix of another
+        if (!(slot->value & StateBit) || i + 1 == sequence.size())
+        {
+            CZLog(CZWarning, CZLN, "Shortcut {} conflicts with an existing binding", id);
+            return false;
+        }
+
+        state = slot->value & ~StateBit;
+    }
+
+    const size_t newStates { sequence.size() - i - 1 };
+
+    if (m_states + newStates >= (1u << 24))
+    {
+        CZLog(CZError, CZLN, "Too many shortcut sequences");
+        return false;
+    }
+
+    for (; i + 1 < sequence.size(); i++)
+    {
+        const UInt32 next { ++m_states };
+        insert(Key(state, sequence[i]), next | StateBit);
+        state = next;
+    }
+
+    insert(Key(state, sequence.back()), id);
+    m_bindings++;
+    return true;
+}
+
+bool CZShortcutMap::find(std::span<const Chord> sequence, UInt32 *id) const noexcept
+{
+    UInt32 state { 0 };
+
+    for (size_t i = 0; i < sequence.size(); i++)
+    {
+        const Slot *slot { lookup(Key(state, sequence[i])) };
+
+        if (!slot)
+            return false;
+
+        if (!(slot->value & StateBit))
+        {
+            if (i + 1 != sequence.size())
+                return false;
+
+            if (id)
+                *id = slot->value;
+
+            return true;
+        }
+
+        state = slot->value & ~StateBit;
+    }
+
+    return false;
+}
+
+void CZShortcutMap::clear() noexcept
+{
+    m_slots.clear();
+    m_used = 0;
+    m_bindings = 0;
+    m_states = 0;
+    m_state = 0;
+}
+
+void CZShortcutMap::reserve(size_t bindings) noexcept
+{
+    if (bindings * 2 > m_slots.size())
+        rehash(bindings * 2);
+}
+
+CZShortcutMap::Match CZShortcutMap::feed(const CZKeyboardKeyEvent &event, const CZKeyModifiers &modifiers) noexcept
+{
+    if (!event.isPressed)
+        return { isPending() ? Pending : None, 0 };
+
+    return feed({ NormalizeModifiers(modifiers), event.symbol }, event.isRepeat);
+}
+
+CZShortcutMap::Match CZShortcutMap::feed(Chord chord, bool isRepeat) noexcept
+{
+    if (chord.symbol == XKB_KEY_NoSymbol || IsModifierSymbol(chord.symbol))
+        return { isPending() ? Pending : None, 0 };
+
+    // Holding the key of a pending chord
+    if (isRepeat && isPending())
+        return { Pending, 0 };
+
+    const Slot *slot { lookup(Key(m_state, chord)) };
+
+    if (!slot)
+    {
+        if (!isPending())
+            return { None, 0 };
+
+        m_state = 0;
+        return { Cancelled, 0 };
+    }
+
+    if (slot->value & StateBit)
+    {
+        if (isRepeat)
+            return { None, 0 };
+
+        m_state = slot->value & ~StateBit;
+        return { Pending, 0 };
+    }
+
+    m_state = 0;
+    return { Matched, slot->value };
+}
+
+const CZShortcutMap::Slot *CZShortcutMap::lookup(UInt64 key) const noexcept
+{
+    if (m_slots.empty())
+        return nullptr;
+
+    const size_t mask { m_slots.size() - 1 };
+
+    for (size_t i = Hash(key) & mask;; i = (i + 1) & mask)
+    {
+        const Slot &slot { m_slots[i] };
+
+        if (slot.key == key)
+            return &slot;
+
+        if (slot.key == Empty)
+            return nullptr;
+    }
+}
+
+void CZShortcutMap::insert(UInt64 key, UInt32 value) noexcept
+{
+    // Keep the load factor at or below 1/2 so that probes stay short
+    if ((m_used + 1) * 2 > m_slots.size())
+        rehash((m_used + 1) * 2);
+
+    const size_t mask { m_slots.size() - 1 };
+    size_t i { Hash(key) & mask };
+
+    while (m_slots[i].key != Empty)
+        i = (i + 1) & mask;
+
+    m_slots[i] = { key, value };
+    m_used++;
+}
+
+void CZShortcutMap::rehash(size_t capacity) noexcept
+{
+    capacity = std::bit_ceil(std::max(capacity, MinCapacity));
+
+    std::vector<Slot> old { std::move(m_slots) };
+    m_slots.assign(capacity, { Empty, 0 });
+    const size_t mask { capacity - 1 };
+
+    for (const Slot &slot : old)
+    {
+        if (slot.key == Empty)
+            continue;
+
+        size_t i { Hash(slot.key) & mask };
+
+        while (m_slots[i].key != Empty)
+            i = (i + 1) & mask;
+
+        m_slots[i] = slot;
+    }
+}
@@ -0,0 +1,180 @@
+#ifndef CZ_CZSHORTCUTMAP_H
+#define CZ_CZSHORTCUTMAP_H
+
+#include <CZ/Core/CZKeyModifiers.h>
+#include <xkbcommon/xkbcommon.h>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Compiled table of keyboard shortcuts.
+ *
+ * Bindings map a sequence of one or more chords (a modifier mask plus a keysym) to a user-defined id. They are
+ * compiled into a single open-addressing hash table keyed by (chord state, modifiers, keysym), where multi-chord
+ * sequences (e.g. `Ctrl+X Ctrl+S`) become transitions of a small state machine. Matching a key event is a single
+ * lookup regardless of the number of bindings, and allocates nothing.
+ *
+ * Modifiers are normalized to Shift, Ctrl, Alt and Super, whether depressed, latched or locked, so that Caps Lock,
+ * Num Lock and other modifiers do not break shortcuts. Keysyms are lowercased, so `Ctrl+Shift+T` is bound as
+ * `{ Ctrl | Shift, XKB_KEY_t }` and matches the `XKB_KEY_T` produced while Shift is held.
+ *
+ * @code
+ * CZShortcutMap shortcuts;
+ * shortcuts.add({ { CZShortcutMap::Ctrl, XKB_KEY_q } }, Quit);
+ * shortcuts.add({ { CZShortcutMap::Ctrl, XKB_KEY_x }, { CZShortcutMap::Ctrl, XKB_KEY_s } }, Save);
+ * ...
+ * const CZKeyModifiers mods { keymap->modifiers() };
+ * keymap->feed(event);
+ *
+ * if (const auto match { shortcuts.feed(event, mods) }; match.status == CZShortcutMap::Matched)
+ *     run(match.id);
+ * @endcode
+ */
+class CZ::CZShortcutMap
+{
+public:
+
+    /// Modifier bits of a chord, the indices of the real xkb modifiers
+    static constexpr UInt32 Shift { 1 << 0 };
+    static constexpr UInt32 Ctrl  { 1 << 2 };
+    static constexpr UInt32 Alt   { 1 << 3 };
+    static constexpr UInt32 Super { 1 << 6 };
+
+    /// All modifiers considered when matching
+    static constexpr UInt32 Modifiers { Shift | Ctrl | Alt | Super };
+
+    /// Longest supported sequence
+    static constexpr UInt32 MaxSequence { 8 };
+
+    /**
+     * @brief A modifier mask and a keysym.
+     */
+    struct Chord
+    {
+        UInt32 modifiers;
+        xkb_keysym_t symbol;
+    };
+
+    /**
+     * @brief Outcome of feeding a key event.
+     */
+    enum Status
+    {
+        /// Not part of any shortcut, leave the event to the focus
+        None,
+
+        /// Matched the start of a sequence, waiting for the next chord
+        Pending,
+
+        /// Completed a shortcut, see Match::id
+        Matched,
+
+        /// Broke a pending sequence, which was discarded
+        Cancelled
+    };
+
+    /**
+     * @brief Result of feed(), the id is only valid if Matched.
+     */
+    struct Match
+    {
+        Status status;
+        UInt32 id;
+    };
+
+    CZShortcutMap() noexcept = default;
+
+    /**
+     * @brief Adds a binding.
+     *
+     * @param sequence Chords to be pressed in order, from 1 to MaxSequence.
+     * @param id Value returned by feed() when the sequence is completed, below 2^31.
+     * @return `false` if the id is out of range, or the sequence is empty, too long, already bound, or is a prefix
+     *         of another binding or vice versa (e.g. `Ctrl+X` and `Ctrl+X Ctrl+S`), in which case nothing is added.
+     */
+    bool add(std::span<const Chord> sequence, UInt32 id) noexcept;
+    bool add(std::initializer_list<Chord> sequence, UInt32 id) noexcept
+    {
+        return add(std::span<const Chord> { sequence.begin(), sequence.size() }, id);
+    }
+
+    /**
+     * @brief Finds the id bound to a sequence without affecting the pending state.
+     *
+     * @return `false` if the sequence is not bound.
+     */
+    bool find(std::span<const Chord> sequence, UInt32 *id = nullptr) const noexcept;
+
+    /**
+     * @brief Removes all bindings and resets the pending state.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Pre-allocates the table for the given number of bindings.
+     */
+    void reserve(size_t bindings) noexcept;
+
+    /**
+     * @brief Number of bindings.
+     */
+    size_t size() const noexcept { return m_bindings; }
+
+    /**
+     * @brief Matches a key event.
+     *
+     * Releases and modifier keys are ignored, so that they do not break sequences. Repeats only match single-chord
+     * shortcuts.
+     *
+     * @param event Key event already fed to the keymap, only its symbol is used.
+     * @param modifiers Modifiers active when the key was pressed, read before CZKeymap::feed() since pressing a key
+     *                  clears latched modifiers.
+     */
+    Match feed(const CZKeyboardKeyEvent &event, const CZKeyModifiers &modifiers) noexcept;
+
+    /**
+     * @brief Matches a chord, see feed().
+     */
+    Match feed(Chord chord, bool isRepeat = false) noexcept;
+
+    /**
+     * @brief Whether a sequence has been started and awaits more chords.
+     */
+    bool isPending() const noexcept { return m_state != 0; }
+
+    /**
+     * @brief Discards the pending sequence, e.g. after a timeout or a focus change.
+     */
+    void reset() noexcept { m_state = 0; }
+
+    /**
+     * @brief Modifiers of a CZKeyModifiers relevant to shortcuts.
+     */
+    static UInt32 NormalizeModifiers(const CZKeyModifiers &modifiers) noexcept
+    {
+        return (modifiers.depressed | modifiers.latched | modifiers.locked) & Modifiers;
+    }
+
+private:
+    struct Slot
+    {
+        UInt64 key;
+        UInt32 value;
+    };
+
+    // Values with this bit point to the next state of a sequence, others are ids
+    static constexpr UInt32 StateBit { 1u << 31 };
+    static constexpr UInt64 Empty { ~UInt64(0) };
+    static UInt64 Key(UInt32 state, Chord chord) noexcept;
+    const Slot *lookup(UInt64 key) const noexcept;
+    void insert(UInt64 key, UInt32 value) noexcept;
+    void rehash(size_t capacity) noexcept;
+    std::vector<Slot> m_slots;
+    size_t m_used { 0 };
+    size_t m_bindings { 0 };
+    UInt32 m_states { 0 };
+    UInt32 m_state { 0 };
+};
+
+#endif // CZ_CZSHORTCUTMAP_H
@@ -12,13 +12,13 @@ CZSpringAnimation::CZSpringAnimation(Float64 from, Float64 to, Float64 initialVe
     m_dampingRatio(dampingRatio)
 {
     m_value = a;
-    m_naturalFreq = std::sqrt(k* 0.01);
+    m_naturalFreq = NaturalFrequency(k);
 }
 
 void CZSpringAnimation::setStiffness(Float64 stiffness) noexcept
 {
     k = stiffness;
-    m_naturalFreq = std::sqrt(k * 0.01);
+    m_naturalFreq = NaturalFrequency(k);
 }
 
 void CZSpringAnimation::onStart() noexcept
@@ -30,7 +30,7 @@ void CZSpringAnimation::onUpdate() noexcept
 {
     Float64 dt = 0.001 * std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime()).count();
 
-    computeNextState(dt);
+    Step(m_value, v, b, m_naturalFreq, m_dampingRatio, dt);
 
     if (isAtRest())
     {
@@ -48,57 +48,47 @@ bool CZSpringAnimation::isAtRest() const noexcept
             std::abs(v) < velThresh);
 }
 
-void CZSpringAnimation::computeNextState(Float64 dt) noexcept
+Float64 CZSpringAnimation::NaturalFrequency(Float64 stiffness) noexcept
 {
-    Float64 delta = m_value - b;
-
-    if (m_dampingRatio < 1)
-        computeUnderdamped(delta, dt);
-    else if (m_dampingRatio == 1)
-        computeCriticallyDamped(delta, dt);
-    else
-        computeOverdamped(delta, dt);
-}
-
-void CZSpringAnimation::computeUnderdamped(Float64 delta, Float64 dt) noexcept
-{
-    Float64 w_d = m_naturalFreq * std::sqrt(1 - m_dampingRatio * m_dampingRatio);
-
-    Float64 A = delta;
-    Float64 B = (v + m_dampingRatio * m_naturalFreq * delta) / w_d;
-
-    Float64 expTerm = std::exp(-m_dampingRatio * m_naturalFreq * dt);
-
-    m_value = b + expTerm * (A * std::cos(w_d * dt) +
-                             B * std::sin(w_d * dt));
-
-    v = expTerm * (
-            -m_naturalFreq * m_dampingRatio * (A * std::cos(w_d * dt)
-                                               + B * std::sin(w_d * dt)) +
-            -A * w_d * std::sin(w_d * dt) +
-            B * w_d * std::cos(w_d * dt)
-            );
-}
-
-void CZSpringAnimation::computeCriticallyDamped(Float64 delta, Float64 dt) noexcept
-{
-    Float64 A = delta;
-    Float64 B = v + m_naturalFreq * delta;
-    Float64 expTerm = std::exp(-m_naturalFreq * dt);
-
-    m_value = b + expTerm * (A + B * dt);
-    v = expTerm * (B - m_naturalFreq * (A + B * dt));
+    return std::sqrt(stiffness * 0.01);
 }
 
-void CZSpringAnimation::computeOverdamped(Float64 delta, Float64 dt) noexcept
+void CZSpringAnimation::Step(Float64 &value, Float64 &velocity, Float64 target, Float64 naturalFreq, Float64 dampingRatio, Float64 dt) noexcept
 {
-    Float64 d = std::sqrt(m_dampingRatio * m_dampingRatio - 1);
-    Float64 r1 = -m_naturalFreq * (m_dampingRatio - d);
-    Float64 r2 = -m_naturalFreq * (m_dampingRatio + d);
+    const Float64 delta { value - target };
 
-    Float64 A = (v - r2 * delta) / (r1 - r2);
-    Float64 B = delta - A;
+    if (dampingRatio < 1)
+    {
+        const Float64 w_d { naturalFreq * std::sqrt(1 - dampingRatio * dampingRatio) };
+        const Float64 A { delta };
+        const Float64 B { (velocity + dampingRatio * naturalFreq * delta) / w_d };
+        const Float64 expTerm { std::exp(-dampingRatio * naturalFreq * dt) };
+        const Float64 c { std::cos(w_d * dt) };
+        const Float64 s { std::sin(w_d * dt) };
+
+        value = target + expTerm * (A * c + B * s);
+        velocity = expTerm * (-naturalFreq * dampingRatio * (A * c + B * s) - A * w_d * s + B * w_d * c);
+    }
+    else if (dampingRatio == 1)
+    {
+        const Float64 A { delta };
+        const Float64 B { velocity + naturalFreq * delta };
+        const Float64 expTerm { std::exp(-naturalFreq * dt) };
 
-    m_value = b + A * std::exp(r1 * dt) + B * std::exp(r2 * dt);
-    v = A * r1 * std::exp(r1 * dt) + B * r2 * std::exp(r2 * dt);
+        value = target + expTerm * (A + B * dt);
+        velocity = expTerm * (B - naturalFreq * (A + B * dt));
+    }
+    else
+    {
+        const Float64 d { std::sqrt(dampingRatio * dampingRatio - 1) };
+        const Float64 r1 { -naturalFreq * (dampingRatio - d) };
+        const Float64 r2 { -naturalFreq * (dampingRatio + d) };
+        const Float64 A { (velocity - r2 * delta) / (r1 - r2) };
+        const Float64 B { delta - A };
+        const Float64 e1 { std::exp(r1 * dt) };
+        const Float64 e2 { std::exp(r2 * dt) };
+
+        value = target + A * e1 + B * e2;
+        velocity = A * r1 * e1 + B * r2 * e2;
+    }
 }
@@ -158,6 +158,26 @@ public:
      */
     void setVelocity(Float64 vel) noexcept { v = vel; }
 
+    /**
+     * @brief Natural frequency of the spring for the given stiffness, in the scale used by this class.
+     */
+    static Float64 NaturalFrequency(Float64 stiffness) noexcept;
+
+    /**
+     * @brief Advances a damped spring by `dt` seconds from its current state.
+     *
+     * Solves the damped harmonic oscillator analytically for the underdamped, critically damped and overdamped
+     * cases. Used by this class and by others simulating the same spring, e.g. CZKineticScroll.
+     *
+     * @param value Current value, replaced with the value after `dt`.
+     * @param velocity Current velocity, replaced with the velocity after `dt`.
+     * @param target Rest value of the spring.
+     * @param naturalFreq See NaturalFrequency().
+     * @param dampingRatio The damping ratio.
+     * @param dt Time step in seconds.
+     */
+    static void Step(Float64 &value, Float64 &velocity, Float64 target, Float64 naturalFreq, Float64 dampingRatio, Float64 dt) noexcept;
+
 protected:
     void onStart() noexcept override;
     void onUpdate() noexcept override;
@@ -167,10 +187,6 @@ private:
     Float64 m_naturalFreq, m_dampingRatio;
 
     bool isAtRest() const noexcept;
-    void computeNextState(Float64 dt) noexcept;
-    void computeUnderdamped(Float64 delta, Float64 dt) noexcept;
-    void computeCriticallyDamped(Float64 delta, Float64 dt) noexcept;
-    void computeOverdamped(Float64 delta, Float64 dt) noexcept;
 };
 
 #endif // CZ_CZSPRINGANIMATION_H
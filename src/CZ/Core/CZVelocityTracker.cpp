@@ -0,0 +1,161 @@
+#include <CZ/Core/CZVelocityTracker.h>
+#include <CZ/Core/Events/CZPointerMoveEvent.h>
+#include <CZ/Core/Events/CZTouchMoveEvent.h>
+#include <CZ/Core/Events/CZPointerSwipeUpdateEvent.h>
+#include <algorithm>
+
+using namespace CZ;
+
+// Keeps sample times small so the running sums do not lose precision
+static constexpr UInt64 RebaseIntervalUs { 1000000 };
+
+void CZVelocityTracker::addSample(UInt64 us, SkPoint pos) noexcept
+{
+    if (m_count > 0 && (us < m_lastUs || us - m_lastUs > m_horizonUs))
+        reset();
+
+    if (m_count == 0)
+        m_baseUs = us;
+    else if (us - m_baseUs > RebaseIntervalUs)
+        rebase(us);
+
+    if (m_count == Capacity)
+        popFront();
+
+    push({ static_cast<Float64>(us - m_baseUs) * 1e-6, pos.x(), pos.y() });
+    m_lastUs = us;
+    m_lastPos = pos;
+
+    // Drop samples that fell out of the horizon, times before a rebase are negative
+    const Float64 oldest { (static_cast<Float64>(us - m_baseUs) - static_cast<Float64>(m_horizonUs)) * 1e-6 };
+
+    while (m_count > 1 && m_samples[m_head].t < oldest)
+        popFront();
+}
+
+void CZVelocityTracker::addEvent(const CZPointerMoveEvent &event) noexcept
+{
+    if (event.history.empty())
+        addSample(event.us, event.pos);
+    else
+        for (const auto &sample : event.history)
+            addSample(sample.us, sample.pos);
+}
+
+void CZVelocityTracker::addEvent(const CZTouchMoveEvent &event) noexcept
+{
+    if (event.history.empty())
+        addSample(event.us, event.pos);
+    else
+        for (const auto &sample : event.history)
+            addSample(sample.us, sample.pos);
+}
+
+void CZVelocityTracker::addEvent(const CZPointerSwipeUpdateEvent &event) noexcept
+{
+    if (m_count == 0)
+        m_swipePos = {};
+
+    m_swipePos += event.delta;
+    addSample(event.us, m_swipePos);
+}
+
+void CZVelocityTracker::reset() noexcept
+{
+    m_head = 0;
+    m_count = 0;
+    m_sums = {};
+}
+
+void CZVelocityTracker::push(const Sample &s) noexcept
+{
+    m_samples[(m_head + m_count) % Capacity] = s;
+    m_count++;
+    m_sums.t += s.t;
+    m_sums.tt += s.t * s.t;
+    m_sums.x += s.x;
+    m_sums.tx += s.t * s.x;
+    m_sums.y += s.y;
+    m_sums.ty += s.t * s.y;
+}
+
+void CZVelocityTracker::popFront() noexcept
+{
+    const Sample &s { m_samples[m_head] };
+    m_sums.t -= s.t;
+    m_sums.tt -= s.t * s.t;
+    m_sums.x -= s.x;
+    m_sums.tx -= s.t * s.x;
+    m_sums.y -= s.y;
+    m_sums.ty -= s.t * s.y;
+    m_head = (m_head + 1) % Capacity;
+    m_count--;
+}
+
+void CZVelocityTracker::rebase(UInt64 baseUs) noexcept
+{
+    const Float64 shift { static_cast<Float64>(baseUs - m_baseUs) * 1e-6 };
+    const UInt32 count { m_count };
+    m_baseUs = baseUs;
+    m_sums = {};
+    m_count = 0;
+
+    // Recomputing from scratch also clears the rounding error accumulated by the running sums
+    for (UInt32 i = 0; i < count; i++)
+    {
+        Sample s { m_samples[(m_head + i) % Capacity] };
+        s.t -= shift;
+        push(s);
+    }
+}
+
+bool CZVelocityTracker::fit(Float64 &bx, Float64 &by, Float64 &ax, Float64 &ay) const noexcept
+{
+    if (m_count < 2)
+        return false;
+
+    const Float64 n { static_cast<Float64>(m_count) };
+    const Float64 den { n * m_sums.tt - m_sums.t * m_sums.t };
+
+    // All samples share the same timestamp
+    if (den <= 1e-12)
+        return false;
+
+    bx = (n * m_sums.tx - m_sums.t * m_sums.x) / den;
+    by = (n * m_sums.ty - m_sums.t * m_sums.y) / den;
+    ax = (m_sums.x - bx * m_sums.t) / n;
+    ay = (m_sums.y - by * m_sums.t) / n;
+    return true;
+}
+
+SkPoint CZVelocityTracker::velocity() const noexcept
+{
+    Float64 bx, by, ax, ay;
+
+    if (!fit(bx, by, ax, ay))
+        return {};
+
+    return SkPoint::Make(bx, by);
+}
+
+SkPoint CZVelocityTracker::velocity(UInt64 nowUs) const noexcept
+{
+    if (m_count == 0 || (nowUs > m_lastUs && nowUs - m_lastUs > m_horizonUs))
+        return {};
+
+    return velocity();
+}
+
+SkPoint CZVelocityTracker::predict(UInt64 us) const noexcept
+{
+    Float64 bx, by, ax, ay;
+
+    if (!fit(bx, by, ax, ay))
+        return m_lastPos;
+
+    us = std::min(us, m_lastUs + m_maxPredictionUs);
+
+    // Times before the base are valid too, e.g. when resampling a past frame
+    const Float64 t { (static_cast<Float64>(us) - static_cast<Float64>(m_baseUs)) * 1e-6 };
+    return SkPoint::Make(ax + bx * t, ay + by * t);
+}
@@ -0,0 +1,143 @@
+#ifndef CZ_CZVELOCITYTRACKER_H
+#define CZ_CZVELOCITYTRACKER_H
+
+#include <CZ/Core/Cuarzo.h>
+#include <CZ/skia/core/SkPoint.h>
+#include <array>
+
+/**
+ * @brief Estimates the velocity of a pointer, finger or gesture from its recent motion.
+ *
+ * Samples are kept in a fixed-size ring covering a short time horizon, and the velocity is the slope
+ * of a least-squares line fitted to them. The sums of the fit are updated incrementally, so adding a
+ * sample and querying the velocity are O(1) and nothing is allocated.
+ *
+ * The same fit can be evaluated at an arbitrary time with predict(), for example to resample motion
+ * to the expected presentation time of the next frame and hide part of the input latency.
+ *
+ * Use one tracker per pointer or touch point, e.g. for fling and kinetic scrolling:
+ *
+ * @code
+ * tracker.addEvent(moveEvent);
+ * ...
+ * const SkPoint v { tracker.velocity(core->loopTimeUs()) }; // px/s
+ * @endcode
+ */
+class CZ::CZVelocityTracker
+{
+public:
+
+    /// Maximum number of samples considered
+    static constexpr UInt32 Capacity { 32 };
+
+    /**
+     * @brief Adds a position sample.
+     *
+     * Samples must be added in chronological order. A gap longer than the horizon restarts
+     * the estimation, since the motion is assumed to have stopped in between.
+     *
+     * @param us Monotonic timestamp in microseconds.
+     * @param pos Position at that time.
+     */
+    void addSample(UInt64 us, SkPoint pos) noexcept;
+
+    /**
+     * @brief Adds the position of a pointer motion event, including its coalesced samples.
+     */
+    void addEvent(const CZPointerMoveEvent &event) noexcept;
+
+    /**
+     * @brief Adds the position of a touch point motion event, including its coalesced samples.
+     */
+    void addEvent(const CZTouchMoveEvent &event) noexcept;
+
+    /**
+     * @brief Accumulates the delta of a swipe gesture update.
+     *
+     * Positions are relative to the origin of the first update since the last reset().
+     */
+    void addEvent(const CZPointerSwipeUpdateEvent &event) noexcept;
+
+    /**
+     * @brief Discards all samples.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Estimated velocity in units per second, zero with less than two samples.
+     */
+    SkPoint velocity() const noexcept;
+
+    /**
+     * @brief Estimated velocity in units per second at the given time.
+     *
+     * Returns zero if no sample was added within the horizon, e.g. when a finger rested before lifting.
+     */
+    SkPoint velocity(UInt64 nowUs) const noexcept;
+
+    /**
+     * @brief Position predicted by the fit at the given time.
+     *
+     * Times past the last sample are clamped to maxPredictionUs() to limit overshoot.
+     * With a single sample, returns its position.
+     */
+    SkPoint predict(UInt64 us) const noexcept;
+
+    /**
+     * @brief Number of samples within the horizon.
+     */
+    UInt32 sampleCount() const noexcept { return m_count; }
+
+    /**
+     * @brief Timestamp of the last sample or 0 if empty.
+     */
+    UInt64 lastUs() const noexcept { return m_count ? m_lastUs : 0; }
+
+    /**
+     * @brief Position of the last sample.
+     */
+    SkPoint lastPos() const noexcept { return m_lastPos; }
+
+    /**
+     * @brief Age of the oldest sample considered, 100 ms by default.
+     */
+    UInt64 horizonUs() const noexcept { return m_horizonUs; }
+    void setHorizonUs(UInt64 us) noexcept { m_horizonUs = us; }
+
+    /**
+     * @brief How far ahead of the last sample predict() can extrapolate, 20 ms by default.
+     */
+    UInt64 maxPredictionUs() const noexcept { return m_maxPredictionUs; }
+    void setMaxPredictionUs(UInt64 us) noexcept { m_maxPredictionUs = us; }
+
+private:
+    struct Sample
+    {
+        Float64 t; // Seconds since m_baseUs
+        Float64 x;
+        Float64 y;
+    };
+
+    struct Sums
+    {
+        Float64 t, tt, x, tx, y, ty;
+    };
+
+    void push(const Sample &sample) noexcept;
+    void popFront() noexcept;
+    void rebase(UInt64 baseUs) noexcept;
+    bool fit(Float64 &bx, Float64 &by, Float64 &ax, Float64 &ay) const noexcept;
+
+    std::array<Sample, Capacity> m_samples;
+    UInt32 m_head { 0 };
+    UInt32 m_count { 0 };
+    Sums m_sums {};
+    UInt64 m_baseUs { 0 };
+    UInt64 m_lastUs { 0 };
+    SkPoint m_lastPos {};
+    SkPoint m_swipePos {};
+    UInt64 m_horizonUs { 100000 };
+    UInt64 m_maxPredictionUs { 20000 };
+};
+
+#endif // CZ_CZVELOCITYTRACKER_H
@@ -16,6 +16,7 @@ namespace CZ
     class CZCore;
     class CZObjectBase;
     class CZObject;
+    class CZObjectCensus;
     class CZTime;
     class CZInputDevice;
     class CZEventSource;
@@ -26,6 +27,16 @@ namespace CZ
     class CZSpringAnimation;
     class CZEase;
     class CZSafeEventQueue;
+    class CZInputRecorder;
+    class CZInputReplayer;
+    class CZVelocityTracker;
+    class CZDamageRing;
+    class CZRegionIndex;
+    class CZRRectIndex;
+    class CZKineticScroll;
+    class CZKeySet;
+    class CZKeyRepeater;
+    class CZShortcutMap;
     class CZLockGuard;
     class CZKeymap;
     class CZWeakUtils;
@@ -40,8 +51,11 @@ namespace CZ
 
     struct CZPresentationTime;
     struct CZRRect;
+    struct CZMotionSample;
 
     class CZSharedMemory;
+    class CZSharedMemoryPool;
+    class CZShmRing;
     class CZRegionUtils;
     class CZStringUtils;
     class CZVectorUtils;
@@ -54,6 +68,7 @@ namespace CZ
     using CZAdaptiveColor = CZAdaptive<SkColor>;
 
     class CZEvent;
+    class CZEventPool;
     class CZDestroyEvent;
     class CZCloseEvent;
     class CZDestroyEvent;
@@ -86,6 +101,7 @@ namespace CZ
     class CZTouchMoveEvent;
     class CZTouchFrameEvent;
     class CZTouchCancelEvent;
+    class CZTouchBatchEvent;
 
     class CZInputDevicePluggedEvent;
     class CZInputDeviceUnpluggedEvent;
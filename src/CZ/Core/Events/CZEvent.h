@@ -74,6 +74,10 @@ public:
         LSurfaceCommit,
         LSurfaceUnlock,
 
+        /* Cuarzo, appended to keep the values above stable, see isTouchEvent() */
+
+        TouchBatch,
+
         User = 1000
     };
 
@@ -101,10 +105,10 @@ public:
         return false;
     }
 
-    bool isInputEvent() const noexcept { return type() >= Type::Input_First && type() <= Type::Input_Last; }
+    bool isInputEvent() const noexcept { return (type() >= Type::Input_First && type() <= Type::Input_Last) || type() == Type::TouchBatch; }
     bool isPointerEvent() const noexcept { return type() >= Type::Pointer_First && type() <= Type::Pointer_Last; };
     bool isKeyboardEvent() const noexcept { return type() >= Type::Keyboard_First && type() <= Type::Keyboard_Last; };
-    bool isTouchEvent() const noexcept { return type() >= Type::Touch_First && type() <= Type::Touch_Last; };
+    bool isTouchEvent() const noexcept { return (type() >= Type::Touch_First && type() <= Type::Touch_Last) || type() == Type::TouchBatch; };
 
     /**
      * @brief Creates a deep copy of the event.
@@ -0,0 +1,115 @@
+#include <CZ/Core/Events/CZEventPool.h>
+#include <array>
+
+using namespace CZ;
+
+static constexpr std::array<std::size_t, 4> SizeClasses { 64, 128, 256, 512 };
+static constexpr UInt32 Unpooled { SizeClasses.size() };
+
+namespace
+{
+    // Free slots are chained through their first word
+    struct FreeSlot
+    {
+        FreeSlot *next;
+    };
+
+    struct State
+    {
+        std::array<FreeSlot*, SizeClasses.size()> free {};
+        CZEventPool::Stats stats {};
+        bool alive { true };
+
+        void trim() noexcept
+        {
+            for (auto &list : free)
+            {
+                while (list)
+                {
+                    FreeSlot *next { list->next };
+                    ::operator delete(list);
+                    list = next;
+                    stats.cached--;
+                }
+            }
+        }
+
+        ~State() noexcept
+        {
+            trim();
+            alive = false;
+        }
+    };
+}
+
+static thread_local State t_state;
+
+CZEventPool::Slot *CZEventPool::Acquire(std::size_t size) noexcept
+{
+    auto &s { t_state };
+    s.stats.live++;
+
+    UInt32 sizeClass { 0 };
+
+    while (sizeClass < Unpooled && SizeClasses[sizeClass] < size)
+        sizeClass++;
+
+    Slot *slot;
+
+    if (sizeClass == Unpooled)
+    {
+        slot = static_cast<Slot*>(::operator new(size));
+        s.stats.heapAllocations++;
+    }
+    else if (s.free[sizeClass])
+    {
+        slot = reinterpret_cast<Slot*>(s.free[sizeClass]);
+        s.free[sizeClass] = s.free[sizeClass]->next;
+        s.stats.reuses++;
+        s.stats.cached--;
+    }
+    else
+    {
+        slot = static_cast<Slot*>(::operator new(SizeClasses[sizeClass]));
+        s.stats.heapAllocations++;
+    }
+
+    slot->refs = 1;
+    slot->sizeClass = sizeClass;
+    return slot;
+}
+
+void CZEventPool::Release(Slot *slot) noexcept
+{
+    const UInt32 sizeClass { slot->sizeClass };
+    slot->event->~CZEvent();
+
+    auto &s { t_state };
+
+    // Released after the thread state was destroyed or too big to be recycled
+    if (!s.alive || sizeClass == Unpooled)
+    {
+        ::operator delete(slot);
+
+        if (s.alive)
+            s.stats.live--;
+
+        return;
+    }
+
+    auto *freeSlot { reinterpret_cast<FreeSlot*>(slot) };
+    freeSlot->next = s.free[sizeClass];
+    s.free[sizeClass] = freeSlot;
+    s.stats.live--;
+    s.stats.cached++;
+}
+
+CZEventPool::Stats CZEventPool::GetStats() noexcept
+{
+    return t_state.stats;
+}
+
+void CZEventPool::Trim() noexcept
+{
+    t_state.trim();
+}
@@ -0,0 +1,149 @@
+#ifndef CZ_CZEVENTPOOL_H
+#define CZ_CZEVENTPOOL_H
+
+#include <CZ/Core/Events/CZEvent.h>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/**
+ * @brief Recycling allocator for loop-local events.
+ *
+ * Events created with Make() are constructed in place inside recycled slots and referenced through a
+ * Handle with an intrusive, non-atomic reference count. Once the last handle is released the event is
+ * destroyed and its slot returned to a per-thread free list, so steady streams of events (e.g. pointer
+ * motion at 1000 Hz) do not touch the heap.
+ *
+ * Slots are grouped in size classes of up to 512 bytes. Larger events are heap-allocated and freed as usual.
+ *
+ * @note Handles are not thread-safe. They must be created and released on the same thread, typically
+ *       the one running the CZCore loop. Use `std::shared_ptr<CZEvent>` to share events across threads.
+ *
+ * @see CZCore::postEvent()
+ */
+class CZ::CZEventPool
+{
+public:
+
+    /**
+     * @brief Intrusive reference to a pooled event.
+     */
+    class Handle
+    {
+    public:
+        Handle() noexcept = default;
+        Handle(const Handle &other) noexcept : m_slot(other.m_slot) { if (m_slot) m_slot->refs++; }
+        Handle(Handle &&other) noexcept : m_slot(other.m_slot) { other.m_slot = nullptr; }
+        ~Handle() noexcept { reset(); }
+
+        Handle &operator=(const Handle &other) noexcept
+        {
+            if (m_slot != other.m_slot)
+            {
+                reset();
+                m_slot = other.m_slot;
+                if (m_slot) m_slot->refs++;
+            }
+            return *this;
+        }
+
+        Handle &operator=(Handle &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                m_slot = other.m_slot;
+                other.m_slot = nullptr;
+            }
+            return *this;
+        }
+
+        /**
+         * @brief The referenced event or `nullptr`.
+         */
+        CZEvent *get() const noexcept { return m_slot ? m_slot->event : nullptr; }
+        CZEvent &operator*() const noexcept { return *m_slot->event; }
+        CZEvent *operator->() const noexcept { return m_slot->event; }
+        explicit operator bool() const noexcept { return m_slot != nullptr; }
+
+        /**
+         * @brief Number of handles referencing the event, 0 if empty.
+         */
+        UInt32 useCount() const noexcept { return m_slot ? m_slot->refs : 0; }
+
+        /**
+         * @brief Releases the reference, destroying the event if it was the last one.
+         */
+        void reset() noexcept
+        {
+            if (m_slot && --m_slot->refs == 0)
+                CZEventPool::Release(m_slot);
+            m_slot = nullptr;
+        }
+
+    private:
+        friend class CZEventPool;
+        struct Slot
+        {
+            CZEvent *event;
+            UInt32 refs;
+            UInt32 sizeClass;
+        };
+        explicit Handle(Slot *slot) noexcept : m_slot(slot) {}
+        Slot *m_slot {};
+    };
+
+    /**
+     * @brief Allocation statistics of the calling thread.
+     */
+    struct Stats
+    {
+        /// Slots taken from the heap
+        UInt64 heapAllocations;
+
+        /// Slots reused from the free lists
+        UInt64 reuses;
+
+        /// Events currently alive
+        UInt64 live;
+
+        /// Free slots waiting to be reused
+        UInt64 cached;
+    };
+
+    CZEventPool() = delete;
+
+    /**
+     * @brief Constructs an event of type T in a recycled slot.
+     *
+     * @param args Arguments forwarded to the T constructor.
+     */
+    template<class T, class... Args>
+    static Handle Make(Args&&... args) noexcept
+    {
+        static_assert(std::is_base_of_v<CZEvent, T>, "T must be a subclass of CZEvent");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned events are not supported");
+
+        auto *slot { Acquire(SlotOffset + sizeof(T)) };
+        slot->event = new (reinterpret_cast<std::byte*>(slot) + SlotOffset) T(std::forward<Args>(args)...);
+        return Handle(slot);
+    }
+
+    /**
+     * @brief Allocation statistics of the calling thread.
+     */
+    static Stats GetStats() noexcept;
+
+    /**
+     * @brief Frees the cached slots of the calling thread.
+     */
+    static void Trim() noexcept;
+
+private:
+    using Slot = Handle::Slot;
+    static constexpr std::size_t SlotOffset { (sizeof(Slot) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1) };
+    static Slot *Acquire(std::size_t size) noexcept;
+    static void Release(Slot *slot) noexcept;
+};
+
+#endif // CZ_CZEVENTPOOL_H
@@ -7,9 +7,32 @@
 class CZ::CZInputEvent : public CZEvent
 {
 public:
-    CZInputEvent(Type type) noexcept : CZEvent(type){}
-    UInt32 ms { CZTime::Ms() };
-    UInt64 us { CZTime::Us() };
+    /**
+     * @brief Timestamps the event with the current time, using a single clock read.
+     */
+    CZInputEvent(Type type) noexcept : CZInputEvent(type, CZTime::Us()) {}
+
+    /**
+     * @brief Timestamps the event with the given monotonic time, without reading the clock.
+     *
+     * Meant for kernel-provided timestamps (e.g. `libinput_event_pointer_get_time_usec()`) or, when the
+     * exact time is not required, for the time cached by the loop (CZCore::loopTimeUs()).
+     *
+     * @param timeUs Monotonic time in microseconds, see CZTime::Us().
+     */
+    CZInputEvent(Type type, UInt64 timeUs) noexcept : CZEvent(type), ms(static_cast<UInt32>(timeUs / 1000)), us(timeUs) {}
+
+    /**
+     * @brief Updates both ms and us from a monotonic time in microseconds.
+     */
+    void setTimeUs(UInt64 timeUs) noexcept
+    {
+        ms = static_cast<UInt32>(timeUs / 1000);
+        us = timeUs;
+    }
+
+    UInt32 ms;
+    UInt64 us;
     std::shared_ptr<CZInputDevice> device;
 };
 
@@ -8,6 +8,7 @@ class CZ::CZKeyboardEnterEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZKeyboardEnterEvent() noexcept : CZInputEvent(Type::KeyboardEnter) {};
+    explicit CZKeyboardEnterEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::KeyboardEnter, timeUs) {};
 };
 
 #endif // CZ_CZKEYBOARDENTEREVENT_H
@@ -3,12 +3,99 @@
 
 #include <CZ/Core/Events/CZInputEvent.h>
 #include <xkbcommon/xkbcommon-compose.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string_view>
 
 class CZ::CZKeyboardKeyEvent : public CZInputEvent
 {
 public:
     CZ_EVENT_DECLARE_COPY
+
+    /**
+     * @brief Inline, null-terminated UTF-8 text of a key.
+     *
+     * Fits in 64 bytes including the length, so key events can be created and copied without
+     * touching the heap. Longer text (e.g. from unusual compose sequences) is truncated at the
+     * last complete code point.
+     */
+    class UTF8
+    {
+    public:
+        /// Maximum length in bytes, excluding the null terminator
+        static constexpr size_t Capacity { 62 };
+
+        UTF8() noexcept = default;
+        UTF8(std::string_view text) noexcept { assign(text); }
+        UTF8 &operator=(std::string_view text) noexcept { assign(text); return *this; }
+
+        /**
+         * @brief Replaces the text, truncating it if longer than Capacity.
+         */
+        void assign(std::string_view text) noexcept
+        {
+            const size_t length { std::min(text.size(), Capacity + 1) };
+            std::memcpy(m_data.data(), text.data(), length);
+            setLength(text.size());
+        }
+
+        /**
+         * @brief Fills the buffer in place.
+         *
+         * @param writer Called with the buffer and its size (Capacity + 1), must write a null-terminated string
+         *               and return its full length, like `xkb_state_key_get_utf8()`.
+         */
+        template<class F>
+        void write(F &&writer) noexcept
+        {
+            const int length { writer(m_data.data(), m_data.size()) };
+            setLength(length > 0 ? static_cast<size_t>(length) : 0);
+        }
+
+        void clear() noexcept { m_data[0] = '\0'; m_size = 0; }
+
+        const char *c_str() const noexcept { return m_data.data(); }
+        const char *data() const noexcept { return m_data.data(); }
+        size_t size() const noexcept { return m_size; }
+        bool empty() const noexcept { return m_size == 0; }
+        std::string_view view() const noexcept { return { m_data.data(), m_size }; }
+        operator std::string_view() const noexcept { return view(); }
+        bool operator==(std::string_view text) const noexcept { return view() == text; }
+
+    private:
+        void setLength(size_t length) noexcept
+        {
+            if (length > Capacity)
+            {
+                // Only the first Capacity bytes are reliable (writers may null-terminate there), find the start
+                // of the last code point and drop it if its sequence does not fit
+                length = Capacity;
+                size_t start { length };
+
+                while (start > 0 && (static_cast<UInt8>(m_data[start - 1]) & 0xC0) == 0x80)
+                    start--;
+
+                if (start > 0)
+                {
+                    const UInt8 lead { static_cast<UInt8>(m_data[--start]) };
+                    const size_t sequence { lead < 0x80 ? 1u : lead >= 0xF0 ? 4u : lead >= 0xE0 ? 3u : 2u };
+
+                    if (length - start < sequence)
+                        length = start;
+                }
+            }
+
+            m_data[length] = '\0';
+            m_size = static_cast<UInt8>(length);
+        }
+
+        std::array<char, Capacity + 1> m_data {};
+        UInt8 m_size { 0 };
+    };
+
     CZKeyboardKeyEvent() noexcept : CZInputEvent(Type::KeyboardKey) {};
+    explicit CZKeyboardKeyEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::KeyboardKey, timeUs) {};
 
     mutable bool isPressed {};
     mutable bool isRepeat {};
@@ -18,7 +105,9 @@ public:
     mutable xkb_keysym_t symbol {};
 
     mutable xkb_compose_status composeStatus { XKB_COMPOSE_NOTHING };
-    mutable std::string utf8 {};
+    mutable UTF8 utf8 {};
 };
 
+static_assert(sizeof(CZ::CZKeyboardKeyEvent::UTF8) == 64);
+
 #endif // CZ_CZKEYBOARDKEYEVENT_H
@@ -8,6 +8,7 @@ class CZ::CZKeyboardLeaveEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZKeyboardLeaveEvent() noexcept : CZInputEvent(Type::KeyboardLeave) {};
+    explicit CZKeyboardLeaveEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::KeyboardLeave, timeUs) {};
 };
 
 #endif // CZ_CZKEYBOARDLEAVEEVENT_H
@@ -0,0 +1,27 @@
+#ifndef CZ_CZMOTIONSAMPLE_H
+#define CZ_CZMOTIONSAMPLE_H
+
+#include <CZ/Core/Cuarzo.h>
+#include <CZ/skia/core/SkPoint.h>
+
+/**
+ * @brief Individual sample of a coalesced motion event.
+ *
+ * @see CZSafeEventQueue::CoalescePolicy
+ */
+struct CZ::CZMotionSample
+{
+    /// Monotonic timestamp in microseconds
+    UInt64 us;
+
+    /// Position reported by the sample
+    SkPoint pos;
+
+    /// Relative motion of the sample (pointer events only)
+    SkPoint delta;
+
+    /// Unaccelerated relative motion of the sample (pointer events only)
+    SkPoint deltaUnaccelerated;
+};
+
+#endif // CZ_CZMOTIONSAMPLE_H
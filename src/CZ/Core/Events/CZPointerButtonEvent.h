@@ -10,6 +10,7 @@ class CZ::CZPointerButtonEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZPointerButtonEvent() noexcept : CZInputEvent(Type::PointerButton) {};
+    explicit CZPointerButtonEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::PointerButton, timeUs) {};
 
     /// @see #include <linux/input-event-codes.h>
     UInt32 button { BTN_LEFT };
@@ -10,6 +10,7 @@ class CZ::CZPointerEnterEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZPointerEnterEvent() noexcept : CZInputEvent(Type::PointerEnter) {};
+    explicit CZPointerEnterEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::PointerEnter, timeUs) {};
     // Can be local or global depending on the context
     mutable SkPoint pos {};
 };
@@ -9,6 +9,7 @@ class CZ::CZPointerHoldBeginEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZPointerHoldBeginEvent() noexcept : CZInputEvent(Type::PointerHoldBegin) {};
+    explicit CZPointerHoldBeginEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::PointerHoldBegin, timeUs) {};
     UInt32 fingers {};
 };
 
@@ -9,6 +9,7 @@ class CZ::CZPointerHoldEndEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZPointerHoldEndEvent() noexcept : CZInputEvent(Type::PointerHoldEnd) {};
+    explicit CZPointerHoldEndEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::PointerHoldEnd, timeUs) {};
     UInt32 fingers {};
     bool cancelled {};
 };
@@ -9,6 +9,7 @@ class CZ::CZPointerLeaveEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZPointerLeaveEvent() noexcept : CZInputEvent(Type::PointerLeave) {};
+    explicit CZPointerLeaveEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::PointerLeave, timeUs) {};
 };
 
 #endif // CZ_CZPOINTERLEAVEEVENT_H
@@ -3,16 +3,26 @@
 
 #include <CZ/skia/core/SkPoint.h>
 #include <CZ/Core/Events/CZInputEvent.h>
+#include <CZ/Core/Events/CZMotionSample.h>
+#include <span>
 
 class CZ::CZPointerMoveEvent : public CZInputEvent
 {
 public:
     CZ_EVENT_DECLARE_COPY
     CZPointerMoveEvent() noexcept : CZInputEvent(Type::PointerMove) {}
+    explicit CZPointerMoveEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::PointerMove, timeUs) {}
     // Can be local or global depending on the context
     mutable SkPoint pos {};
     SkPoint delta {};
     SkPoint deltaUnaccelerated {};
+
+    /**
+     * @brief Samples merged into this event by a coalescing queue, oldest first.
+     *
+     * Empty unless the event was coalesced. Only valid during delivery.
+     */
+    std::span<const CZMotionSample> history {};
 };
 
 #endif // CZ_CZPOINTERMOVEEVENT_H
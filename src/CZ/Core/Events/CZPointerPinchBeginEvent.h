@@ -9,6 +9,7 @@ class CZ::CZPointerPinchBeginEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZPointerPinchBeginEvent() noexcept : CZInputEvent(Type::PointerPinchBegin) {};
+    explicit CZPointerPinchBeginEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::PointerPinchBegin, timeUs) {};
     UInt32 fingers {};
 };
 
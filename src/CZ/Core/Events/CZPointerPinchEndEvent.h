@@ -9,6 +9,7 @@ class CZ::CZPointerPinchEndEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZPointerPinchEndEvent() noexcept : CZInputEvent(Type::PointerPinchEnd) {};
+    explicit CZPointerPinchEndEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::PointerPinchEnd, timeUs) {};
     UInt32 fingers {};
     bool cancelled {};
 };
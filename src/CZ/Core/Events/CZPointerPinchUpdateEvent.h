@@ -9,6 +9,7 @@ class CZ::CZPointerPinchUpdateEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZPointerPinchUpdateEvent() noexcept : CZInputEvent(Type::PointerPinchUpdate) {};
+    explicit CZPointerPinchUpdateEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::PointerPinchUpdate, timeUs) {};
     UInt32 fingers {};
     SkPoint delta {};
     SkPoint deltaUnaccelerated {};
@@ -45,6 +45,7 @@ public:
     };
 
     CZPointerScrollEvent() noexcept : CZInputEvent(Type::PointerScroll) {};
+    explicit CZPointerScrollEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::PointerScroll, timeUs) {};
 
     bool hasX {};
     bool hasY {};
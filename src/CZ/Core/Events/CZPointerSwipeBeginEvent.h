@@ -9,6 +9,7 @@ class CZ::CZPointerSwipeBeginEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZPointerSwipeBeginEvent() noexcept : CZInputEvent(Type::PointerSwipeBegin) {};
+    explicit CZPointerSwipeBeginEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::PointerSwipeBegin, timeUs) {};
     UInt32 fingers {};
 };
 
@@ -9,6 +9,7 @@ class CZ::CZPointerSwipeEndEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZPointerSwipeEndEvent() noexcept : CZInputEvent(Type::PointerSwipeEnd) {};
+    explicit CZPointerSwipeEndEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::PointerSwipeEnd, timeUs) {};
     UInt32 fingers {};
     bool cancelled {};
 };
@@ -9,6 +9,7 @@ class CZ::CZPointerSwipeUpdateEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZPointerSwipeUpdateEvent() noexcept : CZInputEvent(Type::PointerSwipeUpdate) {};
+    explicit CZPointerSwipeUpdateEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::PointerSwipeUpdate, timeUs) {};
     UInt32 fingers {};
     SkPoint delta {};
     SkPoint deltaUnaccelerated {};
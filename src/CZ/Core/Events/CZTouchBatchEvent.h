@@ -0,0 +1,206 @@
+#ifndef CZ_CZTOUCHBATCHEVENT_H
+#define CZ_CZTOUCHBATCHEVENT_H
+
+#include <CZ/Core/Events/CZInputEvent.h>
+#include <CZ/Core/Events/CZTouchDownEvent.h>
+#include <CZ/Core/Events/CZTouchMoveEvent.h>
+#include <CZ/Core/Events/CZTouchUpEvent.h>
+#include <CZ/Core/Events/CZTouchFrameEvent.h>
+#include <CZ/skia/core/SkPoint.h>
+#include <array>
+
+/**
+ * @brief All the touch points that changed within a touch frame.
+ *
+ * A compact alternative to sending one CZTouchDownEvent, CZTouchMoveEvent or CZTouchUpEvent per point
+ * followed by a CZTouchFrameEvent. Points are stored as parallel arrays (ids, positions and states) of
+ * up to MaxPoints entries, so a whole frame fits in a single CZEventPool slot and shares one device
+ * reference, serial and timestamp.
+ *
+ * Backends can build a batch with append() from per-point events or add() directly, and consumers that
+ * only understand per-point events can expand it with forEachPointEvent().
+ */
+class CZ::CZTouchBatchEvent : public CZInputEvent
+{
+public:
+    CZ_EVENT_DECLARE_COPY
+
+    /// Maximum number of points per batch
+    static constexpr UInt32 MaxPoints { 16 };
+
+    /**
+     * @brief What happened to a point within the frame.
+     */
+    enum class State : UInt8
+    {
+        Down,
+        Move,
+        Up
+    };
+
+    CZTouchBatchEvent() noexcept : CZInputEvent(Type::TouchBatch) {};
+    explicit CZTouchBatchEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::TouchBatch, timeUs) {};
+
+    /**
+     * @brief Adds a point.
+     *
+     * Consecutive motion of the same point within the frame is merged into its latest entry, keeping the
+     * latest position. Motion after a Down or Up of the point gets its own entry, preserving the order.
+     *
+     * @return `false` if the batch is full.
+     */
+    bool add(State state, Int32 id, SkPoint pos, SkPoint localPos = {}) noexcept
+    {
+        if (state == State::Move)
+        {
+            const UInt32 i { indexOf(id) };
+
+            if (i < count && states[i] == State::Move)
+            {
+                this->pos[i] = pos;
+                this->localPos[i] = localPos;
+                return true;
+            }
+        }
+
+        if (count == MaxPoints)
+            return false;
+
+        ids[count] = id;
+        this->pos[count] = pos;
+        this->localPos[count] = localPos;
+        states[count] = state;
+        count++;
+        return true;
+    }
+
+    /**
+     * @brief Adds the point carried by a CZTouchDownEvent, CZTouchMoveEvent or CZTouchUpEvent.
+     *
+     * The device and timestamp of the batch are taken from the event.
+     *
+     * @return `false` if the event is not a per-point touch event or the batch is full.
+     */
+    bool append(const CZInputEvent &event) noexcept
+    {
+        bool added;
+
+        switch (event.type())
+        {
+        case Type::TouchDown:
+        {
+            const auto &e { static_cast<const CZTouchDownEvent&>(event) };
+            added = add(State::Down, e.id, e.pos, e.localPos);
+            break;
+        }
+        case Type::TouchMove:
+        {
+            const auto &e { static_cast<const CZTouchMoveEvent&>(event) };
+            added = add(State::Move, e.id, e.pos, e.localPos);
+            break;
+        }
+        case Type::TouchUp:
+        {
+            const auto &e { static_cast<const CZTouchUpEvent&>(event) };
+            const UInt32 i { indexOf(e.id) };
+            added = add(State::Up, e.id, i < count ? pos[i] : SkPoint(), i < count ? localPos[i] : SkPoint());
+            break;
+        }
+        default:
+            return false;
+        }
+
+        if (added)
+        {
+            if (device != event.device)
+                device = event.device;
+
+            setTimeUs(event.us);
+        }
+
+        return added;
+    }
+
+    /**
+     * @brief Expands the batch into per-point events followed by a CZTouchFrameEvent.
+     *
+     * The events are built on the stack with the batch device and timestamp and passed to `fn`
+     * as `const CZInputEvent&`, e.g. to forward them with CZCore::sendEvent().
+     */
+    template<class Fn>
+    void forEachPointEvent(Fn &&fn) const noexcept
+    {
+        for (UInt32 i = 0; i < count; i++)
+        {
+            switch (states[i])
+            {
+            case State::Down:
+            {
+                CZTouchDownEvent e { us };
+                e.device = device;
+                e.id = ids[i];
+                e.pos = pos[i];
+                e.localPos = localPos[i];
+                fn(static_cast<const CZInputEvent&>(e));
+                break;
+            }
+            case State::Move:
+            {
+                CZTouchMoveEvent e { us };
+                e.device = device;
+                e.id = ids[i];
+                e.pos = pos[i];
+                e.localPos = localPos[i];
+                fn(static_cast<const CZInputEvent&>(e));
+                break;
+            }
+            case State::Up:
+            {
+                CZTouchUpEvent e { us };
+                e.device = device;
+                e.id = ids[i];
+                fn(static_cast<const CZInputEvent&>(e));
+                break;
+            }
+            }
+        }
+
+        CZTouchFrameEvent frame { us };
+        frame.device = device;
+        fn(static_cast<const CZInputEvent&>(frame));
+    }
+
+    /**
+     * @brief Index of the last entry of the given point, or `count` if not present.
+     */
+    UInt32 indexOf(Int32 id) const noexcept
+    {
+        for (UInt32 i = count; i > 0; i--)
+            if (ids[i - 1] == id)
+                return i - 1;
+
+        return count;
+    }
+
+    /**
+     * @brief Removes all points.
+     */
+    void clear() noexcept { count = 0; }
+
+    /// Number of valid entries in the arrays
+    UInt32 count {};
+
+    /// Point ids
+    std::array<Int32, MaxPoints> ids {};
+
+    /// Global positions
+    std::array<SkPoint, MaxPoints> pos {};
+
+    /// Positions local to the target, if applicable
+    mutable std::array<SkPoint, MaxPoints> localPos {};
+
+    /// States
+    std::array<State, MaxPoints> states {};
+};
+
+#endif // CZ_CZTOUCHBATCHEVENT_H
@@ -8,6 +8,7 @@ class CZ::CZTouchCancelEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZTouchCancelEvent() noexcept : CZInputEvent(Type::TouchCancel) {};
+    explicit CZTouchCancelEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::TouchCancel, timeUs) {};
 };
 
 #endif // CZ_CZTOUCHCANCELEVENT_H
@@ -9,6 +9,7 @@ class CZ::CZTouchDownEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZTouchDownEvent() noexcept : CZInputEvent(Type::TouchDown) {};
+    explicit CZTouchDownEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::TouchDown, timeUs) {};
 
     mutable SkPoint localPos {};
     SkPoint pos {};
@@ -8,6 +8,7 @@ class CZ::CZTouchFrameEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZTouchFrameEvent() noexcept : CZInputEvent(Type::TouchFrame) {};
+    explicit CZTouchFrameEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::TouchFrame, timeUs) {};
 };
 
 #endif // CZ_CZTOUCHFRAMEEVENT_H
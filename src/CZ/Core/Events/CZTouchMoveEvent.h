@@ -2,16 +2,26 @@
 #define CZ_CZTOUCHMOVEEVENT_H
 
 #include <CZ/Core/Events/CZInputEvent.h>
+#include <CZ/Core/Events/CZMotionSample.h>
 #include <CZ/skia/core/SkPoint.h>
+#include <span>
 
 class CZ::CZTouchMoveEvent : public CZInputEvent
 {
 public:
     CZ_EVENT_DECLARE_COPY
     CZTouchMoveEvent() noexcept : CZInputEvent(Type::TouchMove) {};
+    explicit CZTouchMoveEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::TouchMove, timeUs) {};
     mutable SkPoint localPos {};
     Int32 id {};
     SkPoint pos {};
+
+    /**
+     * @brief Samples merged into this event by a coalescing queue, oldest first.
+     *
+     * Empty unless the event was coalesced. Only valid during delivery.
+     */
+    std::span<const CZMotionSample> history {};
 };
 
 #endif // CZ_CZTOUCHMOVEEVENT_H
@@ -9,6 +9,7 @@ class CZ::CZTouchUpEvent : public CZInputEvent
 public:
     CZ_EVENT_DECLARE_COPY
     CZTouchUpEvent() noexcept : CZInputEvent(Type::TouchUp) {};
+    explicit CZTouchUpEvent(UInt64 timeUs) noexcept : CZInputEvent(Type::TouchUp, timeUs) {};
     Int32 id {};
 };
 
@@ -1,5 +1,7 @@
 #include <CZ/Core/Utils/CZRegionUtils.h>
 #include <CZ/skia/core/SkRegion.h>
+#include <algorithm>
+#include <vector>
 
 using namespace CZ;
 
@@ -9,116 +11,117 @@ const SkRegion &CZRegionUtils::Empty() noexcept
     return region;
 }
 
-void CZRegionUtils::ApplyTransform(SkRegion &region, SkISize size, CZTransform transform) noexcept
+/*
+ * Adding rects one by one with op(rect, kUnion_Op) re-runs the region algebra over the partial result each time,
+ * O(n²) for n rects (SkRegion::setRects() does the same). Instead, the rects are sorted by position and merged
+ * pairwise, so each level of the merge tree costs O(n) and neighbouring rects are merged first, keeping the
+ * intermediate regions small.
+ */
+static void UnionRects(std::vector<SkIRect> &rects, SkRegion &dst) noexcept
 {
-    region.op(SkIRect::MakeSize(size), SkRegion::Op::kIntersect_Op);
+    if (rects.size() <= 1)
+    {
+        if (rects.empty())
+            dst.setEmpty();
+        else
+            dst.setRect(rects[0]);
 
-    if (transform == CZTransform::Normal)
         return;
+    }
 
-    SkRegion tmp;
-    SkRegion::Iterator it(region);
+    std::sort(rects.begin(), rects.end(), [](const SkIRect &a, const SkIRect &b) {
+        return a.fTop < b.fTop || (a.fTop == b.fTop && a.fLeft < b.fLeft);
+    });
+
+    static thread_local std::vector<SkRegion> regions;
+    size_t count { (rects.size() + 1) / 2 };
+    regions.resize(count);
+
+    for (size_t i = 0; i < rects.size(); i += 2)
+    {
+        regions[i / 2].setRect(rects[i]);
+
+        if (i + 1 < rects.size())
+            regions[i / 2].op(rects[i + 1], SkRegion::Op::kUnion_Op);
+    }
+
+    while (count > 1)
+    {
+        for (size_t i = 0; i + 1 < count; i += 2)
+            regions[i / 2].op(regions[i], regions[i + 1], SkRegion::Op::kUnion_Op);
+
+        if (count % 2 == 1)
+            regions[count / 2].swap(regions[count - 1]);
+
+        count = (count + 1) / 2;
+    }
+
+    dst.swap(regions[0]);
+    regions.clear();
+}
+
+// Maps each rect of src and unions the results into dst, which can be src
+template<class F>
+static void MapRects(const SkRegion &src, SkRegion &dst, F &&map) noexcept
+{
+    static thread_local std::vector<SkIRect> rects;
+    rects.clear();
+
+    for (SkRegion::Iterator it(src); !it.done(); it.next())
+        rects.push_back(map(it.rect()));
+
+    UnionRects(rects, dst);
+}
+
+void CZRegionUtils::ApplyTransform(SkRegion &region, SkISize size, CZTransform transform) noexcept
+{
+    region.op(SkIRect::MakeSize(size), SkRegion::Op::kIntersect_Op);
+
+    const Int32 w { size.width() };
+    const Int32 h { size.height() };
 
     switch (transform)
     {
     case CZTransform::Normal:
         return;
     case CZTransform::Flipped270:
-        while (!it.done())
-        {
-            tmp.op(
-                SkIRect::MakeXYWH(
-                    size.height() - it.rect().fBottom,
-                    size.width() - it.rect().fRight,
-                    it.rect().fBottom - it.rect().fTop,
-                    it.rect().fRight - it.rect().fLeft),
-                SkRegion::Op::kUnion_Op);
-            it.next();
-        }
+        MapRects(region, region, [w, h](const SkIRect &r) {
+            return SkIRect::MakeLTRB(h - r.fBottom, w - r.fRight, h - r.fTop, w - r.fLeft);
+        });
         break;
     case CZTransform::Flipped90:
-        while (!it.done())
-        {
-            tmp.op(
-                SkIRect::MakeXYWH(
-                    it.rect().fTop,
-                    it.rect().fLeft,
-                    it.rect().fBottom - it.rect().fTop,
-                    it.rect().fRight - it.rect().fLeft),
-                SkRegion::Op::kUnion_Op);
-            it.next();
-        }
+        MapRects(region, region, [](const SkIRect &r) {
+            return SkIRect::MakeLTRB(r.fTop, r.fLeft, r.fBottom, r.fRight);
+        });
         break;
     case CZTransform::Flipped180:
-        while (!it.done())
-        {
-            tmp.op(
-                SkIRect::MakeXYWH(
-                    it.rect().fLeft,
-                    size.height() - it.rect().fBottom,
-                    it.rect().fRight - it.rect().fLeft,
-                    it.rect().fBottom - it.rect().fTop),
-                SkRegion::Op::kUnion_Op);
-            it.next();
-        }
+        MapRects(region, region, [h](const SkIRect &r) {
+            return SkIRect::MakeLTRB(r.fLeft, h - r.fBottom, r.fRight, h - r.fTop);
+        });
         break;
     case CZTransform::Rotated180:
-        while (!it.done())
-        {
-            tmp.op(
-                SkIRect::MakeXYWH(
-                    size.width() - it.rect().fRight,
-                    size.height() - it.rect().fBottom,
-                    it.rect().fRight - it.rect().fLeft,
-                    it.rect().fBottom - it.rect().fTop),
-                SkRegion::Op::kUnion_Op);
-            it.next();
-        }
+        MapRects(region, region, [w, h](const SkIRect &r) {
+            return SkIRect::MakeLTRB(w - r.fRight, h - r.fBottom, w - r.fLeft, h - r.fTop);
+        });
         break;
     case CZTransform::Flipped:
-        while (!it.done())
-        {
-            tmp.op(
-                SkIRect::MakeXYWH(
-                    size.width() - it.rect().fRight,
-                    it.rect().fTop,
-                    it.rect().fRight - it.rect().fLeft,
-                    it.rect().fBottom - it.rect().fTop),
-                SkRegion::Op::kUnion_Op);
-            it.next();
-        }
+        MapRects(region, region, [w](const SkIRect &r) {
+            return SkIRect::MakeLTRB(w - r.fRight, r.fTop, w - r.fLeft, r.fBottom);
+        });
         break;
     case CZTransform::Rotated90:
-        while (!it.done())
-        {
-            tmp.op(
-                SkIRect::MakeXYWH(
-                    it.rect().fTop,
-                    size.width() - it.rect().fRight,
-                    it.rect().fBottom - it.rect().fTop,
-                    it.rect().fRight - it.rect().fLeft),
-                SkRegion::Op::kUnion_Op);
-            it.next();
-        }
+        MapRects(region, region, [w](const SkIRect &r) {
+            return SkIRect::MakeLTRB(r.fTop, w - r.fRight, r.fBottom, w - r.fLeft);
+        });
         break;
     case CZTransform::Rotated270:
-        while (!it.done())
-        {
-            tmp.op(
-                SkIRect::MakeXYWH(
-                    size.height() - it.rect().fBottom,
-                    it.rect().fLeft,
-                    it.rect().fBottom - it.rect().fTop,
-                    it.rect().fRight - it.rect().fLeft),
-                SkRegion::Op::kUnion_Op);
-            it.next();
-        }
+        MapRects(region, region, [h](const SkIRect &r) {
+            return SkIRect::MakeLTRB(h - r.fBottom, r.fLeft, h - r.fTop, r.fRight);
+        });
         break;
     default:
         return;
     }
-
-    region = tmp;
 }
 
 void CZRegionUtils::Scale(SkRegion &region, Float32 xFactor, Float32 yFactor) noexcept
@@ -126,137 +129,51 @@ void CZRegionUtils::Scale(SkRegion &region, Float32 xFactor, Float32 yFactor) no
     if (xFactor == 1.f && yFactor == 1.f)
         return;
 
-    SkRegion tmp;
-    SkRegion::Iterator it(region);
-
-    while (!it.done())
-    {
-        tmp.op(
-            SkIRect::MakeLTRB(
-                SkScalarFloorToInt(xFactor * SkScalar(it.rect().fLeft)),
-                SkScalarFloorToInt(yFactor * SkScalar(it.rect().fTop)),
-                SkScalarCeilToInt(xFactor * SkScalar(it.rect().fRight)),
-                SkScalarCeilToInt(yFactor * SkScalar(it.rect().fBottom))),
-            SkRegion::Op::kUnion_Op);
-        it.next();
-    }
-
-    region = tmp;
+    MapRects(region, region, [xFactor, yFactor](const SkIRect &r) {
+        return SkIRect::MakeLTRB(
+            SkScalarFloorToInt(xFactor * SkScalar(r.fLeft)),
+            SkScalarFloorToInt(yFactor * SkScalar(r.fTop)),
+            SkScalarCeilToInt(xFactor * SkScalar(r.fRight)),
+            SkScalarCeilToInt(yFactor * SkScalar(r.fBottom)));
+    });
 }
 
 void CZRegionUtils::Scale(SkRegion &region, Float32 factor) noexcept
 {
-    if (factor == 1.f)
-        return;
-
-    SkRegion tmp;
-    SkRegion::Iterator it(region);
-
-    if (factor == 0.5f)
-    {
-        while (!it.done())
-        {
-            tmp.op(
-                SkIRect::MakeLTRB(
-                    it.rect().left() >> 1,
-                    it.rect().top() >> 1,
-                    it.rect().right() >> 1,
-                    it.rect().bottom() >> 1),
-                SkRegion::Op::kUnion_Op),
-            it.next();
-        }
-    }
-    else if (factor == 2.f)
-    {
-        while (!it.done())
-        {
-            tmp.op(
-                SkIRect::MakeLTRB(
-                    it.rect().left() << 1,
-                    it.rect().top() << 1,
-                    it.rect().right() << 1,
-                    it.rect().bottom() << 1),
-                SkRegion::Op::kUnion_Op),
-            it.next();
-        }
-    }
-    else
-    {
-        while (!it.done())
-        {
-            tmp.op(
-                SkIRect::MakeLTRB(
-                    SkScalarFloorToInt(factor * SkScalar(it.rect().fLeft)),
-                    SkScalarFloorToInt(factor * SkScalar(it.rect().fTop)),
-                    SkScalarCeilToInt(factor * SkScalar(it.rect().fRight)),
-                    SkScalarCeilToInt(factor * SkScalar(it.rect().fBottom))),
-                SkRegion::Op::kUnion_Op);
-            it.next();
-        }
-    }
-
-    region = tmp;
+    Scale(region, region, factor);
 }
 
 void CZRegionUtils::Scale(const SkRegion &src, SkRegion &dst, Float32 factor) noexcept
 {
-    if (&dst == &src)
-    {
-        Scale(dst, factor);
-        return;
-    }
-
     if (factor == 1.f)
     {
-        dst = src;
+        if (&dst != &src)
+            dst = src;
+
         return;
     }
 
-    dst.setEmpty();
-
-    SkRegion::Iterator it(src);
-
     if (factor == 0.5f)
     {
-        while (!it.done())
-        {
-            dst.op(
-                SkIRect::MakeLTRB(
-                    it.rect().left() >> 1,
-                    it.rect().top() >> 1,
-                    it.rect().right() >> 1,
-                    it.rect().bottom() >> 1),
-                SkRegion::Op::kUnion_Op),
-            it.next();
-        }
+        MapRects(src, dst, [](const SkIRect &r) {
+            return SkIRect::MakeLTRB(r.left() >> 1, r.top() >> 1, r.right() >> 1, r.bottom() >> 1);
+        });
     }
     else if (factor == 2.f)
     {
-        while (!it.done())
-        {
-            dst.op(
-                SkIRect::MakeLTRB(
-                    it.rect().left() << 1,
-                    it.rect().top() << 1,
-                    it.rect().right() << 1,
-                    it.rect().bottom() << 1),
-                SkRegion::Op::kUnion_Op),
-            it.next();
-        }
+        MapRects(src, dst, [](const SkIRect &r) {
+            return SkIRect::MakeLTRB(r.left() << 1, r.top() << 1, r.right() << 1, r.bottom() << 1);
+        });
     }
     else
     {
-        while (!it.done())
-        {
-            dst.op(
-                SkIRect::MakeLTRB(
-                    SkScalarFloorToInt(factor * SkScalar(it.rect().fLeft)),
-                    SkScalarFloorToInt(factor * SkScalar(it.rect().fTop)),
-                    SkScalarCeilToInt(factor * SkScalar(it.rect().fRight)),
-                    SkScalarCeilToInt(factor * SkScalar(it.rect().fBottom))),
-                SkRegion::Op::kUnion_Op);
-            it.next();
-        }
+        MapRects(src, dst, [factor](const SkIRect &r) {
+            return SkIRect::MakeLTRB(
+                SkScalarFloorToInt(factor * SkScalar(r.fLeft)),
+                SkScalarFloorToInt(factor * SkScalar(r.fTop)),
+                SkScalarCeilToInt(factor * SkScalar(r.fRight)),
+                SkScalarCeilToInt(factor * SkScalar(r.fBottom)));
+        });
     }
 }
 
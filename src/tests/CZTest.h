@@ -0,0 +1,42 @@
+#ifndef CZ_TEST_H
+#define CZ_TEST_H
+
+#include <CZ/Core/Cuarzo.h>
+#include <CZ/Core/CZLog.h>
+
+/*
+ * Helpers shared by the test executables registered with meson test().
+ */
+namespace CZ::Test
+{
+    // Number of failed checks so far
+    inline int Failures { 0 };
+
+    // Logs and counts the check if the condition is false
+    inline void Check(bool condition, const char *what) noexcept
+    {
+        if (condition)
+            return;
+
+        CZLog(CZError, "Failed: {}", what);
+        Failures++;
+    }
+
+    // Logs the result, returns the exit code of the test
+    inline int Finish() noexcept
+    {
+        if (Failures > 0)
+        {
+            CZLog(CZError, "{} checks failed", Failures);
+            return 1;
+        }
+
+        CZLog(CZInfo, "All checks passed");
+        return 0;
+    }
+
+    // Number of calls to the global operator new so far, requires linking cz_test_allocations
+    UInt64 Allocations() noexcept;
+}
+
+#endif // CZ_TEST_H
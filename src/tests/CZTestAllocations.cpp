@@ -0,0 +1,26 @@
+#include "CZTest.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace CZ;
+
+static std::atomic<UInt64> s_allocations { 0 };
+
+void *operator new(std::size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+UInt64 Test::Allocations() noexcept
+{
+    return s_allocations.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,45 @@
+#ifndef CZ_BENCH_H
+#define CZ_BENCH_H
+
+#include <CZ/Core/Cuarzo.h>
+#include <CZ/Core/CZTime.h>
+#include <cstdio>
+
+namespace CZ::Bench
+{
+    // Number of calls to the global operator new so far
+    UInt64 Allocations() noexcept;
+
+    inline UInt64 NowNs() noexcept
+    {
+        const timespec ts { CZTime::Ns() };
+        return static_cast<UInt64>(ts.tv_sec) * 1000000000 + static_cast<UInt64>(ts.tv_nsec);
+    }
+
+    // Keeps the compiler from optimizing away a computed value
+    template<class T>
+    inline void DoNotOptimize(const T &value) noexcept
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    void DamageRing();
+    void Events();
+    void EventLanes();
+    void EventQueue();
+    void InputReplay();
+    void Keymap();
+    void KeySet();
+    void RegionIndex();
+    void RRectIndex();
+    void Regions();
+    void SharedMemory();
+    void SharedMemoryPages();
+    void SharedMemoryPool();
+    void ShmRing();
+    void Shortcuts();
+    void Touch();
+    void Velocity();
+}
+
+#endif // CZ_BENCH_H
@@ -0,0 +1,104 @@
+#include "Bench.h"
+#include <CZ/Core/CZDamageRing.h>
+#include <CZ/Core/Utils/CZRegionUtils.h>
+#include <deque>
+
+using namespace CZ;
+
+static UInt64 Area(const SkRegion &region) noexcept
+{
+    UInt64 area { 0 };
+
+    for (SkRegion::Iterator it(region); !it.done(); it.next())
+        area += static_cast<UInt64>(it.rect().width()) * static_cast<UInt64>(it.rect().height());
+
+    return area;
+}
+
+// A moving cursor, a blinking caret and a panel scrolling every few frames, in logical coordinates
+static SkRegion FrameDamage(UInt32 frame) noexcept
+{
+    SkRegion damage;
+    const Int32 x { Int32(frame * 7 % 1800) };
+    damage.op(SkIRect::MakeXYWH(x, 400 + Int32(frame % 50), 32, 32), SkRegion::Op::kUnion_Op);
+    damage.op(SkIRect::MakeXYWH(x + 7, 400 + Int32((frame + 1) % 50), 32, 32), SkRegion::Op::kUnion_Op);
+
+    if (frame % 30 < 15)
+        damage.op(SkIRect::MakeXYWH(900, 300, 2, 18), SkRegion::Op::kUnion_Op);
+
+    if (frame % 4 == 0)
+        damage.op(SkIRect::MakeXYWH(80, 120, 360, 800), SkRegion::Op::kUnion_Op);
+
+    return damage;
+}
+
+/*
+ * Renders frames into a swapchain of three buffers, each reused every third frame (age 3) and
+ * an occasional one reused sooner (age 2), counting the pixels repainted.
+ */
+void Bench::DamageRing()
+{
+    constexpr UInt32 Frames { 2000 };
+    constexpr UInt32 Queries { 4 };
+    const SkISize logicalSize { SkISize::Make(1920, 1080) };
+    const CZTransform transform { CZTransform::Rotated90 };
+
+    CZDamageRing ring { 4 };
+    ring.setGeometry(logicalSize, 2.f, transform);
+
+    // Previous frames in buffer coordinates, for the reference union
+    std::deque<SkRegion> history;
+
+    UInt64 fullPixels { 0 }, ringPixels { 0 }, naiveNs { 0 }, ringNs { 0 };
+    UInt32 mismatches { 0 };
+    const UInt64 bufferArea { static_cast<UInt64>(ring.bufferSize().width()) * static_cast<UInt64>(ring.bufferSize().height()) };
+
+    for (UInt32 frame = 0; frame < Frames; frame++)
+    {
+        const UInt32 age { frame < 3 ? 0u : (frame % 10 == 0 ? 2u : 3u) };
+        const SkRegion damage { FrameDamage(frame) };
+        SkRegion naive, repaint;
+
+        // Same query repeated, e.g. by several render passes of the frame
+        UInt64 begin { Bench::NowNs() };
+
+        for (UInt32 q = 0; q < Queries; q++)
+        {
+            if (age == 0 || age - 1 > history.size())
+                naive.setRect(SkIRect::MakeSize(ring.bufferSize()));
+            else
+            {
+                ring.toBuffer(damage, naive);
+
+                for (UInt32 i = 0; i + 1 < age; i++)
+                    naive.op(history[i], SkRegion::Op::kUnion_Op);
+            }
+        }
+
+        naiveNs += Bench::NowNs() - begin;
+        begin = Bench::NowNs();
+
+        for (UInt32 q = 0; q < Queries; q++)
+            ring.repaintRegion(damage, age, repaint);
+
+        ringNs += Bench::NowNs() - begin;
+        mismatches += !(naive == repaint);
+        fullPixels += bufferArea;
+        ringPixels += Area(repaint);
+
+        ring.addFrame(damage);
+        history.emplace_front();
+        ring.toBuffer(damage, history.front());
+
+        if (history.size() > ring.capacity())
+            history.pop_back();
+    }
+
+    printf("%u frames of %dx%d at scale 2 (%s), buffers of age 3 (2 every tenth frame)\n", Frames,
+           logicalSize.width(), logicalSize.height(), CZ::TransformString(transform).data());
+    printf("Repainted pixels per frame: full %.2f M, damage ring %.3f M (%.2f%%)%s\n",
+           Float64(fullPixels) / Frames / 1e6, Float64(ringPixels) / Frames / 1e6,
+           100.0 * Float64(ringPixels) / Float64(fullPixels), mismatches ? "  MISMATCH" : "");
+    printf("%u queries per frame: union of the last frames %.2f us, CZDamageRing %.2f us per frame\n", Queries,
+           Float64(naiveNs) / Frames / 1e3, Float64(ringNs) / Frames / 1e3);
+}
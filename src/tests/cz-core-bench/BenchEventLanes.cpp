@@ -0,0 +1,88 @@
+#include "Bench.h"
+#include <CZ/Core/CZCore.h>
+#include <CZ/Core/Events/CZLayoutEvent.h>
+#include <CZ/Core/Events/CZKeyboardKeyEvent.h>
+
+using namespace CZ;
+
+namespace
+{
+    class Target : public CZObject
+    {
+    public:
+        UInt64 layouts {};
+        UInt64 keyDeliveredNs {};
+        UInt32 postKeyAt {};
+    protected:
+        bool event(const CZEvent &e) noexcept override
+        {
+            if (e.type() == CZEvent::Type::KeyboardKey)
+            {
+                keyDeliveredNs = Bench::NowNs();
+                return true;
+            }
+
+            // Simulated layout pass of ~10 us
+            const UInt64 until { Bench::NowNs() + 10000 };
+            while (Bench::NowNs() < until) {}
+
+            // A key press arrives while the burst is being processed
+            if (++layouts == postKeyAt)
+                CZCore::Get()->postEvent<CZKeyboardKeyEvent>(*this);
+
+            return true;
+        }
+    };
+}
+
+static void Burst(const char *name, UInt64 budgetUs)
+{
+    constexpr UInt32 Layouts { 2000 };
+
+    auto core { CZCore::Get() };
+    auto &queue { core->eventQueue() };
+    const UInt64 defaultBudget { queue.laneBudgetUs(CZSafeEventQueue::Lane::Layout) };
+    queue.setLaneBudgetUs(CZSafeEventQueue::Lane::Layout, budgetUs);
+    queue.resetLaneStats();
+    queue.setLaneStatsEnabled(true);
+
+    Target target;
+    target.postKeyAt = 10;
+
+    for (UInt32 i = 0; i < Layouts; i++)
+        core->postEvent<CZLayoutEvent>(target);
+
+    const UInt64 begin { Bench::NowNs() };
+    UInt64 keyPostedNs {};
+    UInt32 iterations { 0 };
+
+    while (!queue.empty())
+    {
+        core->dispatch(0);
+        iterations++;
+
+        if (!keyPostedNs && target.layouts >= target.postKeyAt)
+            keyPostedNs = Bench::NowNs();
+    }
+
+    const UInt64 ns { Bench::NowNs() - begin };
+    const auto &input { queue.laneStats(CZSafeEventQueue::Lane::Input) };
+    const auto &layout { queue.laneStats(CZSafeEventQueue::Lane::Layout) };
+
+    printf("%-24s %6.2f ms burst  %4u iterations  key delay %8.0f us  layout max delay %6.2f ms  %4lu deferrals\n",
+           name, ns / 1e6, iterations, Float64(input.maxDelayUs), layout.maxDelayUs / 1e3, layout.deferrals);
+
+    queue.setLaneBudgetUs(CZSafeEventQueue::Lane::Layout, defaultBudget);
+    queue.setLaneStatsEnabled(false);
+}
+
+void Bench::EventLanes()
+{
+    auto core { CZCore::GetOrMake() };
+
+    printf("2000 layout events of ~10 us each, a key press is posted by the 10th one\n");
+    printf("A single FIFO queue would delay the key by the whole burst\n");
+    Burst("layout budget 1 ms", 1000);
+    Burst("layout budget 4 ms", 4000);
+    Burst("layout budget unlimited", 0);
+}
@@ -0,0 +1,108 @@
+#include "Bench.h"
+#include <CZ/Core/CZCore.h>
+#include <CZ/Core/CZSafeEventQueue.h>
+#include <CZ/Core/Events/CZLayoutEvent.h>
+#include <queue>
+
+using namespace CZ;
+
+namespace
+{
+    class Target : public CZObject
+    {
+    public:
+        UInt64 received {};
+    protected:
+        bool event(const CZEvent &) noexcept override
+        {
+            received++;
+            return true;
+        }
+    };
+
+    // Replica of the std::queue based implementation, drained through a temporary as CZCore used to do
+    class LegacyQueue
+    {
+    public:
+        LegacyQueue() noexcept = default;
+        LegacyQueue(LegacyQueue &&other) noexcept
+        {
+            m_queue = std::move(other.m_queue);
+            other.m_queue = std::queue<SafeEvent>();
+        }
+
+        void addEvent(std::shared_ptr<CZEvent> event, CZObject &object) noexcept
+        {
+            m_queue.emplace(CZWeak<CZObject>(&object), event);
+        }
+
+        void dispatch() noexcept
+        {
+            auto core { CZCore::Get() };
+
+            while (!m_queue.empty())
+            {
+                if (m_queue.front().object)
+                    core->sendEvent(*m_queue.front().event, *m_queue.front().object.get());
+                m_queue.pop();
+            }
+        }
+
+    private:
+        struct SafeEvent
+        {
+            CZWeak<CZObject> object;
+            std::shared_ptr<CZEvent> event;
+        };
+
+        std::queue<SafeEvent> m_queue;
+    };
+}
+
+template<class Cycle>
+static void Run(const char *name, UInt32 batch, Cycle cycle)
+{
+    const UInt32 cycles { 1000000 / batch };
+    Target target;
+    auto event { std::make_shared<CZLayoutEvent>() };
+
+    for (UInt32 i = 0; i < 100; i++)
+        cycle(target, event, batch);
+
+    const UInt64 allocs { Bench::Allocations() };
+    const UInt64 begin { Bench::NowNs() };
+
+    for (UInt32 i = 0; i < cycles; i++)
+        cycle(target, event, batch);
+
+    const UInt64 ns { Bench::NowNs() - begin };
+    const UInt64 total { Bench::Allocations() - allocs };
+
+    printf("%-20s batch %4u  %10.0f cycles/s  %6.1f ns/event  %6.2f allocs/cycle\n",
+           name, batch, cycles * 1e9 / ns, Float64(ns) / (cycles * batch), Float64(total) / cycles);
+}
+
+void Bench::EventQueue()
+{
+    auto core { CZCore::GetOrMake() };
+
+    printf("Post-and-drain cycles, shared events\n");
+
+    for (UInt32 batch : { 1, 16, 256 })
+    {
+        LegacyQueue legacy;
+        Run("std::queue (old)", batch, [&legacy](Target &target, const auto &event, UInt32 n) {
+            for (UInt32 i = 0; i < n; i++)
+                legacy.addEvent(event, target);
+            LegacyQueue tmp { std::move(legacy) };
+            tmp.dispatch();
+        });
+
+        CZSafeEventQueue queue;
+        Run("ring buffer", batch, [&queue](Target &target, const auto &event, UInt32 n) {
+            for (UInt32 i = 0; i < n; i++)
+                queue.addEvent(event, target);
+            queue.dispatch();
+        });
+    }
+}
@@ -0,0 +1,142 @@
+#include "Bench.h"
+#include <CZ/Core/CZCore.h>
+#include <CZ/Core/CZInputDevice.h>
+#include <CZ/Core/Events/CZPointerMoveEvent.h>
+
+using namespace CZ;
+
+namespace
+{
+    class Target : public CZObject
+    {
+    public:
+        UInt64 received {};
+        UInt64 samples {};
+        SkPoint last {};
+        SkPoint delta {};
+
+        // Simulated handler cost (e.g. hit-testing), in loop iterations
+        UInt32 work {};
+    protected:
+        bool event(const CZEvent &e) noexcept override
+        {
+            for (UInt32 i = 0; i < work; i++)
+                Bench::DoNotOptimize(i);
+
+            if (e.type() == CZEvent::Type::PointerMove)
+            {
+                const auto &move { static_cast<const CZPointerMoveEvent&>(e) };
+                last = move.pos;
+                delta += move.delta;
+                samples += move.history.empty() ? 1 : move.history.size();
+            }
+            received++;
+            return true;
+        }
+    };
+}
+
+// Simulates a 1000 Hz mouse: one posted motion event per loop iteration
+template<class Post>
+static void PointerInput(const char *name, Post post)
+{
+    constexpr UInt32 Hz { 1000 };
+    constexpr UInt32 Seconds { 5 };
+    constexpr UInt32 Warmup { 100 };
+
+    auto core { CZCore::Get() };
+    auto device { CZInputDevice::Make(CZInputDevice::Pointer, "Bench Mouse") };
+    Target target;
+
+    for (UInt32 i = 0; i < Warmup; i++)
+    {
+        post(*core, target, device, i);
+        core->dispatch(0);
+    }
+
+    const UInt64 allocs { Bench::Allocations() };
+    const UInt64 begin { Bench::NowNs() };
+
+    for (UInt32 i = 0; i < Hz * Seconds; i++)
+    {
+        post(*core, target, device, i);
+        core->dispatch(0);
+    }
+
+    const UInt64 ns { Bench::NowNs() - begin };
+    const UInt64 total { Bench::Allocations() - allocs };
+
+    printf("%-34s %8.1f allocs/s  %8.2f allocs/event  %8.0f ns/event  (%lu delivered)\n",
+           name, Float64(total) / Seconds, Float64(total) / (Hz * Seconds), Float64(ns) / (Hz * Seconds),
+           target.received);
+}
+
+// Simulates an 8000 Hz mouse with the loop waking up every 4 ms (32 events per iteration)
+static void CoalescedInput(const char *name, CZSafeEventQueue::CoalescePolicy policy)
+{
+    constexpr UInt32 Hz { 8000 };
+    constexpr UInt32 Seconds { 5 };
+    constexpr UInt32 PerIteration { 32 };
+
+    auto core { CZCore::Get() };
+    auto device { CZInputDevice::Make(CZInputDevice::Pointer, "Bench Mouse") };
+    Target target;
+    target.work = 1000;
+    core->setEventCoalescePolicy(policy);
+
+    const UInt64 begin { Bench::NowNs() };
+
+    for (UInt32 i = 0; i < Hz * Seconds; i++)
+    {
+        auto &event { core->postEvent<CZPointerMoveEvent>(target, core->loopTimeUs()) };
+        event.device = device;
+        event.pos = SkPoint::Make(i, i);
+        event.delta = SkPoint::Make(1.f, 1.f);
+
+        if ((i + 1) % PerIteration == 0)
+            core->dispatch(0);
+    }
+
+    core->dispatch(0);
+
+    const UInt64 ns { Bench::NowNs() - begin };
+    core->setEventCoalescePolicy(CZSafeEventQueue::CoalescePolicy::None);
+
+    printf("%-34s %8.0f ns/posted  %8lu delivered  %8lu samples  delta (%.0f, %.0f)\n",
+           name, Float64(ns) / (Hz * Seconds), target.received, target.samples, target.delta.x(), target.delta.y());
+}
+
+void Bench::Events()
+{
+    auto core { CZCore::GetOrMake() };
+
+    printf("Pointer motion at 1000 Hz, posted and dispatched once per event\n");
+
+    PointerInput("postEvent(shared_ptr)", [](CZCore &core, CZObject &target, const auto &device, UInt32 i) {
+        auto event { std::make_shared<CZPointerMoveEvent>() };
+        event->device = device;
+        event->pos = SkPoint::Make(i, i);
+        core.postEvent(event, target);
+    });
+
+    PointerInput("postEvent<T>(pooled)", [](CZCore &core, CZObject &target, const auto &device, UInt32 i) {
+        auto &event { core.postEvent<CZPointerMoveEvent>(target) };
+        event.device = device;
+        event.pos = SkPoint::Make(i, i);
+    });
+
+    PointerInput("postEvent<T>(pooled, loop time)", [](CZCore &core, CZObject &target, const auto &device, UInt32 i) {
+        auto &event { core.postEvent<CZPointerMoveEvent>(target, core.loopTimeUs()) };
+        event.device = device;
+        event.pos = SkPoint::Make(i, i);
+    });
+
+    printf("\nPointer motion at 8000 Hz, dispatched every 32 events, 1000 iterations of work per delivery\n");
+    CoalescedInput("CoalescePolicy::None", CZSafeEventQueue::CoalescePolicy::None);
+    CoalescedInput("CoalescePolicy::Motion", CZSafeEventQueue::CoalescePolicy::Motion);
+    printf("\n");
+
+    const auto stats { CZEventPool::GetStats() };
+    printf("Pool: %lu heap allocations, %lu reuses, %lu cached slots\n",
+           stats.heapAllocations, stats.reuses, stats.cached);
+}
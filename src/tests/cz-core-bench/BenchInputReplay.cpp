@@ -0,0 +1,153 @@
+#include "Bench.h"
+#include <CZ/Core/CZCore.h>
+#include <CZ/Core/CZInputDevice.h>
+#include <CZ/Core/CZInputRecorder.h>
+#include <CZ/Core/CZInputReplayer.h>
+#include <CZ/Core/Events/CZPointerMoveEvent.h>
+#include <CZ/Core/Events/CZPointerButtonEvent.h>
+#include <CZ/Core/Events/CZPointerScrollEvent.h>
+#include <CZ/Core/Events/CZKeyboardKeyEvent.h>
+#include <CZ/Core/Events/CZTouchDownEvent.h>
+#include <CZ/Core/Events/CZTouchMoveEvent.h>
+#include <CZ/Core/Events/CZTouchUpEvent.h>
+#include <CZ/Core/Events/CZTouchFrameEvent.h>
+#include <unistd.h>
+
+using namespace CZ;
+
+namespace
+{
+    // Folds the fields it receives into a hash so that runs can be compared
+    class Target : public CZObject
+    {
+    public:
+        UInt64 received {};
+        UInt64 hash { 1469598103934665603ull };
+    protected:
+        bool event(const CZEvent &e) noexcept override
+        {
+            const auto &input { static_cast<const CZInputEvent&>(e) };
+            mix(static_cast<UInt64>(e.type()));
+            mix(input.us);
+            mix(input.device ? input.device->caps.get() : 0);
+
+            switch (e.type())
+            {
+            case CZEvent::Type::PointerMove:
+                mixF(static_cast<const CZPointerMoveEvent&>(e).pos.x());
+                mixF(static_cast<const CZPointerMoveEvent&>(e).delta.y());
+                break;
+            case CZEvent::Type::KeyboardKey:
+                mix(static_cast<const CZKeyboardKeyEvent&>(e).code);
+                mix(static_cast<const CZKeyboardKeyEvent&>(e).utf8.size());
+                break;
+            case CZEvent::Type::TouchMove:
+                mixF(static_cast<const CZTouchMoveEvent&>(e).pos.y());
+                break;
+            default:
+                break;
+            }
+
+            received++;
+            return true;
+        }
+    private:
+        void mix(UInt64 value) noexcept { hash = (hash ^ value) * 1099511628211ull; }
+        void mixF(Float32 value) noexcept { mix(static_cast<UInt64>(value * 1000)); }
+    };
+}
+
+// About 10 seconds of mixed input: 1000 Hz pointer motion, clicks, scrolling, typing and two-finger touch
+static void Session(CZCore &core, Target &pointerTarget, Target &keyTarget) noexcept
+{
+    auto mouse { CZInputDevice::Make(CZInputDevice::Pointer, "Bench Mouse", 0x46d, 0xc077) };
+    auto keyboard { CZInputDevice::Make(CZInputDevice::Keyboard, "Bench Keyboard") };
+    auto touch { CZInputDevice::Make(CZInputDevice::Touch, "Bench Touchscreen") };
+    UInt64 us { 1000000 };
+
+    for (UInt32 i = 0; i < 10000; i++, us += 1000)
+    {
+        auto &move { core.postEvent<CZPointerMoveEvent>(pointerTarget, us) };
+        move.device = mouse;
+        move.pos = SkPoint::Make(i % 1920, i % 1080);
+        move.delta = SkPoint::Make(1.f, 0.5f);
+
+        if (i % 250 == 0)
+        {
+            auto &button { core.postEvent<CZPointerButtonEvent>(pointerTarget, us) };
+            button.device = mouse;
+            button.pressed = (i / 250) % 2 == 0;
+        }
+
+        if (i % 50 == 0)
+        {
+            auto &scroll { core.postEvent<CZPointerScrollEvent>(pointerTarget, us) };
+            scroll.device = mouse;
+            scroll.hasY = true;
+            scroll.axes = SkPoint::Make(0.f, 15.f);
+            scroll.axesDiscrete = SkIPoint::Make(0, 120);
+        }
+
+        if (i % 80 == 0)
+        {
+            auto &key { core.postEvent<CZKeyboardKeyEvent>(keyTarget, us) };
+            key.device = keyboard;
+            key.code = 30 + (i / 80) % 26;
+            key.isPressed = true;
+            key.utf8 = "a";
+        }
+
+        if (i % 4 == 0)
+        {
+            for (Int32 id = 0; id < 2; id++)
+            {
+                auto &tm { core.postEvent<CZTouchMoveEvent>(pointerTarget, us) };
+                tm.device = touch;
+                tm.id = id;
+                tm.pos = SkPoint::Make(100 + id * 50, i % 500);
+            }
+
+            core.postEvent<CZTouchFrameEvent>(pointerTarget, us).device = touch;
+        }
+
+        core.dispatch(0);
+    }
+}
+
+void Bench::InputReplay()
+{
+    auto core { CZCore::GetOrMake() };
+    const auto path { std::filesystem::temp_directory_path() / ("cz-core-bench-" + std::to_string(getpid()) + ".czir") };
+
+    Target pointerTarget, keyTarget;
+    auto recorder { CZInputRecorder::MakeFile(path) };
+    recorder->start();
+
+    UInt64 begin { Bench::NowNs() };
+    Session(*core, pointerTarget, keyTarget);
+    const UInt64 recordNs { Bench::NowNs() - begin };
+    recorder->stop();
+
+    const UInt64 events { recorder->eventCount() };
+    const auto bytes { std::filesystem::file_size(path) };
+    printf("Recorded %lu events, %lu bytes (%.1f bytes/event), session with recording %.0f ns/event\n",
+           events, bytes, Float64(bytes) / events, Float64(recordNs) / events);
+
+    Target pointerReplay, keyReplay;
+    auto replayer { CZInputReplayer::MakeFile(path) };
+    replayer->setTargetResolver([&](UInt32 id, const std::string &) -> CZObject* {
+        return id == 0 ? &pointerReplay : &keyReplay;
+    });
+
+    begin = Bench::NowNs();
+    replayer->runToEnd();
+    const UInt64 replayNs { Bench::NowNs() - begin };
+
+    printf("Replayed %lu events in %.2f ms (%.0f ns/event), %lu skipped\n",
+           replayer->postedCount(), replayNs / 1e6, Float64(replayNs) / replayer->postedCount(), replayer->skippedCount());
+    printf("Deliveries match: %s\n",
+           pointerReplay.hash == pointerTarget.hash && keyReplay.hash == keyTarget.hash &&
+           pointerReplay.received + keyReplay.received == events ? "yes" : "NO");
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,125 @@
+#include "Bench.h"
+#include <CZ/Core/CZKeySet.h>
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+using namespace CZ;
+
+namespace
+{
+    // The previous representation of CZKeymap::pressedKeys()
+    struct LegacyKeys
+    {
+        std::unordered_set<UInt32> set;
+        bool press(UInt32 code) noexcept { return set.insert(code).second; }
+        bool release(UInt32 code) noexcept { return set.erase(code) > 0; }
+        bool test(UInt32 code) const noexcept { return set.contains(code); }
+        bool any() const noexcept { return !set.empty(); }
+        UInt32 count() const noexcept { return set.size(); }
+        UInt32 sum() const noexcept { UInt32 s { 0 }; for (UInt32 code : set) s += code; return s; }
+        UInt32 modifiers() const noexcept { return test(KEY_LEFTCTRL) + test(KEY_LEFTSHIFT) + test(KEY_LEFTALT) + test(KEY_LEFTMETA); }
+    };
+
+    struct Keys
+    {
+        CZKeySet set;
+        bool press(UInt32 code) noexcept { return set.set(code); }
+        bool release(UInt32 code) noexcept { return set.reset(code); }
+        bool test(UInt32 code) const noexcept { return set.test(code); }
+        bool any() const noexcept { return set.any(); }
+        UInt32 count() const noexcept { return set.count(); }
+        UInt32 sum() const noexcept { UInt32 s { 0 }; for (UInt32 code : set) s += code; return s; }
+        UInt32 modifiers() const noexcept { return set.count(Modifiers); }
+        const CZKeySet Modifiers { KEY_LEFTCTRL, KEY_LEFTSHIFT, KEY_LEFTALT, KEY_LEFTMETA };
+    };
+}
+
+struct KeyEvent
+{
+    UInt32 code;
+    bool pressed;
+};
+
+// Random typing with up to 3 keys held, a quarter of them modifiers
+static std::vector<KeyEvent> MakeEvents(UInt32 count) noexcept
+{
+    constexpr UInt32 Modifiers[] { KEY_LEFTCTRL, KEY_LEFTSHIFT, KEY_LEFTALT, KEY_LEFTMETA };
+
+    std::vector<KeyEvent> events;
+    std::vector<UInt32> held;
+    events.reserve(count);
+    UInt32 seed { 7 };
+
+    while (events.size() < count)
+    {
+        seed = seed * 1664525 + 1013904223;
+
+        if (held.size() < 3 && (held.empty() || (seed >> 28) < 10))
+        {
+            const UInt32 code { (seed >> 24) < 64 ? Modifiers[(seed >> 22) & 3] : KEY_Q + (seed >> 16) % 40 };
+
+            if (std::find(held.begin(), held.end(), code) != held.end())
+                continue;
+
+            held.push_back(code);
+            events.push_back({ code, true });
+        }
+        else
+        {
+            const size_t index { (seed >> 16) % held.size() };
+            events.push_back({ held[index], false });
+            held[index] = held.back();
+            held.pop_back();
+        }
+    }
+
+    return events;
+}
+
+/*
+ * Every key event updates the set and then runs the queries of shortcut matching and key repeat:
+ * modifier tests, a held modifier count, any() and count(), plus a full iteration every 16 events.
+ */
+template<class T>
+static void Run(const char *name, const std::vector<KeyEvent> &events, UInt64 &checksum)
+{
+    T keys;
+    UInt64 sum { 0 };
+
+    const UInt64 allocs { Bench::Allocations() };
+    const UInt64 begin { Bench::NowNs() };
+
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        if (events[i].pressed)
+            keys.press(events[i].code);
+        else
+            keys.release(events[i].code);
+
+        sum += keys.test(KEY_LEFTCTRL) + keys.test(KEY_LEFTSHIFT) + keys.test(KEY_LEFTALT);
+        sum += keys.any() + keys.count() + keys.modifiers();
+
+        if ((i & 15) == 0)
+            sum += keys.sum();
+    }
+
+    const UInt64 ns { Bench::NowNs() - begin };
+    const UInt64 allocations { Bench::Allocations() - allocs };
+
+    printf("%-28s %8.1f ns/event  %6.3f allocs/event  checksum %llu\n",
+           name, Float64(ns) / events.size(), Float64(allocations) / events.size(), static_cast<unsigned long long>(sum));
+
+    checksum = sum;
+}
+
+void Bench::KeySet()
+{
+    printf("Key events updating the pressed keys set, each followed by shortcut and repeat queries\n");
+
+    const auto events { MakeEvents(2000000) };
+    UInt64 legacy, bitset;
+    Run<LegacyKeys>("std::unordered_set<UInt32>", events, legacy);
+    Run<Keys>("CZKeySet", events, bitset);
+    printf("Results match: %s\n", legacy == bitset ? "yes" : "no");
+}
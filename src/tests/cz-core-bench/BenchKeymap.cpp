@@ -0,0 +1,112 @@
+#include "Bench.h"
+#include <CZ/Core/CZKeymap.h>
+#include <filesystem>
+#include <cstdlib>
+#include <vector>
+
+using namespace CZ;
+
+static Float64 Run(const char *name, UInt32 iterations, size_t &size) noexcept
+{
+    const UInt64 begin { Bench::NowNs() };
+
+    for (UInt32 i = 0; i < iterations; i++)
+    {
+        auto keymap { CZKeymap::MakeServer({}) };
+
+        if (!keymap)
+        {
+            printf("%-34s failed\n", name);
+            return 0.0;
+        }
+
+        size = keymap->size();
+    }
+
+    const Float64 ms { Float64(Bench::NowNs() - begin) / iterations / 1e6 };
+    printf("%-34s %8.2f ms/keymap  (%zu bytes)\n", name, ms, size);
+    return ms;
+}
+
+/*
+ * Cost of the default server keymap created by CZCore at startup, compiled from RMLVO names
+ * (cold start) versus loaded from the on-disk cache (warm start), and of client keymaps created
+ * from it with and without the client cache.
+ */
+void Bench::Keymap()
+{
+    constexpr UInt32 Iterations { 20 };
+
+    char dirTemplate[] { "/tmp/cz-core-bench-XXXXXX" };
+
+    if (!mkdtemp(dirTemplate))
+    {
+        printf("Failed to create a temporary cache directory\n");
+        return;
+    }
+
+    const char *prevCache { getenv("CZ_CORE_KEYMAP_CACHE") };
+    const char *prevHome { getenv("XDG_CACHE_HOME") };
+    const std::string savedCache { prevCache ? prevCache : "" };
+    const std::string savedHome { prevHome ? prevHome : "" };
+    setenv("XDG_CACHE_HOME", dirTemplate, 1);
+
+    printf("CZKeymap::MakeServer({}), average of %u runs\n", Iterations);
+
+    size_t coldSize { 0 }, warmSize { 0 }, firstSize { 0 };
+    setenv("CZ_CORE_KEYMAP_CACHE", "0", 1);
+    const Float64 cold { Run("Cache disabled (cold start)", Iterations, coldSize) };
+
+    setenv("CZ_CORE_KEYMAP_CACHE", "1", 1);
+    Run("First start (compile and store)", 1, firstSize);
+    const Float64 warm { Run("Cache enabled (warm start)", Iterations, warmSize) };
+
+    if (warm > 0.0)
+        printf("Saved %.2f ms per startup (%.1fx faster), same keymap size: %s\n",
+               cold - warm, cold / warm, coldSize == warmSize && firstSize == warmSize ? "yes" : "no");
+
+    // Clients receiving the keymap of the server, e.g. once per seat or surface
+    if (auto server { CZKeymap::MakeServer({}) })
+    {
+        printf("\nCZKeymap::MakeClient(fd, size), average of %u runs\n", Iterations);
+
+        const auto makeClients = [&server](const char *name, bool clearCache) {
+            std::vector<std::shared_ptr<CZKeymap>> clients;
+            Float64 ms { 0.0 };
+
+            for (UInt32 i = 0; i < Iterations; i++)
+            {
+                if (clearCache)
+                    CZKeymap::ClearClientCache();
+
+                const UInt64 begin { Bench::NowNs() };
+                clients.emplace_back(CZKeymap::MakeClient(server->fd(), server->size()));
+                ms += Float64(Bench::NowNs() - begin) / 1e6;
+            }
+
+            printf("%-34s %8.2f ms/keymap\n", name, ms / Iterations);
+            return ms / Iterations;
+        };
+
+        const Float64 uncached { makeClients("Cache cleared (compile)", true) };
+        const Float64 cached { makeClients("Cached (shared xkb_keymap)", false) };
+
+        if (cached > 0.0)
+            printf("Saved %.2f ms per client keymap (%.1fx faster)\n", uncached - cached, uncached / cached);
+
+        CZKeymap::ClearClientCache();
+    }
+
+    std::error_code ec;
+    std::filesystem::remove_all(dirTemplate, ec);
+
+    if (prevCache)
+        setenv("CZ_CORE_KEYMAP_CACHE", savedCache.c_str(), 1);
+    else
+        unsetenv("CZ_CORE_KEYMAP_CACHE");
+
+    if (prevHome)
+        setenv("XDG_CACHE_HOME", savedHome.c_str(), 1);
+    else
+        unsetenv("XDG_CACHE_HOME");
+}
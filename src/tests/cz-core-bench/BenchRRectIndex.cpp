@@ -0,0 +1,204 @@
+#include "Bench.h"
+#include <CZ/Core/CZRRectIndex.h>
+#include <vector>
+
+using namespace CZ;
+
+namespace
+{
+    // What consumers typically write: every entry tested, keeping the topmost one
+    class LinearIndex
+    {
+    public:
+        UInt32 insert(const CZRRect &rect, Int32 z) noexcept
+        {
+            entries.push_back({ rect, z, stamp++, true });
+            return static_cast<UInt32>(entries.size());
+        }
+
+        // Same as remove() + insert() when the id is reused
+        void replace(UInt32 id, const CZRRect &rect, Int32 z) noexcept { entries[id - 1] = { rect, z, stamp++, true }; }
+
+        void move(UInt32 id, const CZRRect &rect) noexcept { entries[id - 1].rect = rect; }
+        void setZ(UInt32 id, Int32 z) noexcept { entries[id - 1].z = z; entries[id - 1].stamp = stamp++; }
+
+        UInt32 hitTest(SkPoint point) const noexcept
+        {
+            UInt32 hit { 0 };
+
+            for (UInt32 i = 0; i < entries.size(); i++)
+            {
+                const auto &e { entries[i] };
+
+                if (!e.used || !e.rect.containsPoint(point))
+                    continue;
+
+                if (hit == 0 || e.z > entries[hit - 1].z || (e.z == entries[hit - 1].z && e.stamp > entries[hit - 1].stamp))
+                    hit = i + 1;
+            }
+
+            return hit;
+        }
+
+    private:
+        struct Entry { CZRRect rect; Int32 z; UInt64 stamp; bool used; };
+        std::vector<Entry> entries;
+        UInt64 stamp { 0 };
+    };
+
+    struct Random
+    {
+        UInt32 seed { 7 };
+
+        // In [0, max)
+        Int32 next(Int32 max) noexcept
+        {
+            seed = seed * 1664525 + 1013904223;
+            return static_cast<Int32>((seed >> 8) % static_cast<UInt32>(max));
+        }
+    };
+}
+
+static CZRRect RandomRRect(Random &random, SkIPoint pos) noexcept
+{
+    const Int32 w { 40 + random.next(360) };
+    const Int32 h { 30 + random.next(270) };
+    const Int32 radius { random.next(std::min(w, h) / 2 + 1) };
+    return CZRRect(SkIRect::MakeXYWH(pos.x(), pos.y(), w, h), radius, radius, random.next(2) * radius, random.next(2) * radius);
+}
+
+/*
+ * 10k rounded windows and widgets over a 7680x4320 desktop plus a fullscreen background, hit-tested
+ * with a linear scan vs CZRRectIndex, then moved, restacked, removed and added again.
+ */
+void Bench::RRectIndex()
+{
+    constexpr UInt32 Entries { 10000 };
+    constexpr UInt32 Points { 20000 };
+    constexpr UInt32 Moves { 100000 };
+    constexpr UInt32 Churn { 2000 };
+    constexpr Int32 Width { 7680 }, Height { 4320 };
+
+    Random random;
+    LinearIndex linear;
+    CZRRectIndex index;
+    std::vector<CZRRect> rects;
+    std::vector<Int32> zs;
+
+    rects.emplace_back(SkIRect::MakeWH(Width, Height));
+    zs.emplace_back(-1);
+
+    for (UInt32 i = 0; i < Entries; i++)
+    {
+        rects.emplace_back(RandomRRect(random, SkIPoint::Make(random.next(Width), random.next(Height))));
+        zs.emplace_back(random.next(8));
+    }
+
+    UInt64 begin { Bench::NowNs() };
+
+    for (size_t i = 0; i < rects.size(); i++)
+        index.insert(rects[i], zs[i]);
+
+    const Float64 insertNs { Float64(Bench::NowNs() - begin) / Float64(rects.size()) };
+
+    for (size_t i = 0; i < rects.size(); i++)
+        linear.insert(rects[i], zs[i]);
+
+    std::vector<SkPoint> points;
+
+    for (UInt32 i = 0; i < Points; i++)
+        points.push_back(SkPoint::Make(Float32(random.next(Width * 4)) / 4.f, Float32(random.next(Height * 4)) / 4.f));
+
+    UInt32 mismatches { 0 };
+
+    const auto compare = [&](Float64 &linearNs, Float64 &indexNs) {
+        std::vector<UInt32> expected(Points), hits(Points);
+
+        begin = Bench::NowNs();
+        for (UInt32 i = 0; i < Points; i++)
+            expected[i] = linear.hitTest(points[i]);
+        linearNs = Float64(Bench::NowNs() - begin) / Points;
+
+        begin = Bench::NowNs();
+        for (UInt32 i = 0; i < Points; i++)
+            hits[i] = index.hitTest(points[i]);
+        indexNs = Float64(Bench::NowNs() - begin) / Points;
+
+        for (UInt32 i = 0; i < Points; i++)
+            mismatches += hits[i] != expected[i];
+    };
+
+    Float64 linearNs, indexNs;
+    compare(linearNs, indexNs);
+
+    printf("%u rounded rects + background in %dx%d, cell size %d\n", Entries, Width, Height, index.cellSize());
+    printf("Insert:       %8.1f ns per entry\n", insertNs);
+    printf("Hit test:     linear %8.1f ns  index %6.1f ns  x%6.1f\n", linearNs, indexNs, linearNs / indexNs);
+
+    // Dragging: small steps, most within the same cells
+    begin = Bench::NowNs();
+
+    for (UInt32 i = 0; i < Moves; i++)
+    {
+        const UInt32 id { 2 + static_cast<UInt32>(random.next(Entries)) };
+        CZRRect &rect { rects[id - 1] };
+        rect.offset(random.next(17) - 8, random.next(17) - 8);
+        index.move(id, rect);
+    }
+
+    const Float64 moveNs { Float64(Bench::NowNs() - begin) / Moves };
+
+    for (size_t i = 0; i < rects.size(); i++)
+        linear.move(static_cast<UInt32>(i + 1), rects[i]);
+
+    // Raising windows, closing some and opening others in their place, replayed on the linear index afterwards
+    struct Change { UInt32 raised; Int32 raisedZ; UInt32 removed; Int32 removedZ; CZRRect added; };
+    std::vector<Change> changes;
+
+    for (UInt32 i = 0; i < Churn; i++)
+    {
+        Change change;
+        change.raised = 2 + static_cast<UInt32>(random.next(Entries));
+        change.raisedZ = ++zs[change.raised - 1];
+        change.removed = 2 + static_cast<UInt32>(random.next(Entries));
+        change.removedZ = zs[change.removed - 1];
+        change.added = RandomRRect(random, SkIPoint::Make(random.next(Width), random.next(Height)));
+        changes.push_back(change);
+    }
+
+    begin = Bench::NowNs();
+
+    for (const auto &change : changes)
+    {
+        index.setZ(change.raised, change.raisedZ);
+        index.remove(change.removed);
+
+        // The identifier of the removed entry is reused
+        mismatches += index.insert(change.added, change.removedZ) != change.removed;
+    }
+
+    const Float64 churnNs { Float64(Bench::NowNs() - begin) / Churn };
+
+    for (const auto &change : changes)
+    {
+        linear.setZ(change.raised, change.raisedZ);
+        linear.replace(change.removed, change.added, change.removedZ);
+    }
+
+    compare(linearNs, indexNs);
+
+    std::vector<CZRRectIndex::Id> all;
+    UInt64 allCount { 0 };
+
+    for (const auto &p : points)
+    {
+        index.hitTestAll(p, all);
+        allCount += all.size();
+        mismatches += all.empty() || all.back() != 1;
+    }
+
+    printf("Move:         %8.1f ns per small move\n", moveNs);
+    printf("Restack:      %8.1f ns per setZ() + remove() + insert()\n", churnNs);
+    printf("Hit test:     linear %8.1f ns  index %6.1f ns  x%6.1f (after the changes)\n", linearNs, indexNs, linearNs / indexNs);
+    printf("Hit test all: %.1f entries per point on average%s\n", Float64(allCount) / Points, mismatches ? "  MISMATCH" : "");
+}
@@ -0,0 +1,126 @@
+#include "Bench.h"
+#include <CZ/Core/CZRegionIndex.h>
+#include <CZ/Core/Utils/CZRegionUtils.h>
+#include <cmath>
+#include <vector>
+
+using namespace CZ;
+
+// Three outputs of different sizes, one rotated and offset
+static SkRegion MultiMonitor() noexcept
+{
+    SkRegion region;
+    region.op(SkIRect::MakeXYWH(0, 0, 2560, 1440), SkRegion::Op::kUnion_Op);
+    region.op(SkIRect::MakeXYWH(2560, -300, 3840, 2160), SkRegion::Op::kUnion_Op);
+    region.op(SkIRect::MakeXYWH(6400, 100, 1080, 1920), SkRegion::Op::kUnion_Op);
+    return region;
+}
+
+// A circular confinement region with one rect per row, as for a rounded window
+static SkRegion Circle(Int32 radius) noexcept
+{
+    SkRegion region;
+
+    for (Int32 y = -radius; y < radius; y++)
+    {
+        const Int32 half { Int32(std::sqrt(Float32(radius * radius - y * y))) };
+        region.op(SkIRect::MakeLTRB(1000 - half, 1000 + y, 1000 + half, 1000 + y + 1), SkRegion::Op::kUnion_Op);
+    }
+
+    return region;
+}
+
+// Tiled windows with gaps between them, many rects per band
+static SkRegion Grid(Int32 columns, Int32 rows) noexcept
+{
+    SkRegion region;
+
+    for (Int32 y = 0; y < rows; y++)
+        for (Int32 x = 0; x < columns; x++)
+            region.op(SkIRect::MakeXYWH(x * 100 + (y % 2) * 30, y * 80, 90, 70), SkRegion::Op::kUnion_Op);
+
+    return region;
+}
+
+static UInt32 CountRects(const SkRegion &region) noexcept
+{
+    UInt32 count { 0 };
+
+    for (SkRegion::Iterator it(region); !it.done(); it.next())
+        count++;
+
+    return count;
+}
+
+/*
+ * Pointer positions around the bounds of the region, half of them outside, queried with
+ * SkRegion::contains() and CZRegionUtils::ClosestPointFrom() vs CZRegionIndex.
+ */
+static void Run(const char *name, const SkRegion &region) noexcept
+{
+    constexpr UInt32 Points { 20000 };
+    const SkIRect bounds { region.getBounds() };
+    std::vector<SkPoint> points;
+    UInt32 seed { 5 };
+
+    for (UInt32 i = 0; i < Points; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        const Float32 u { Float32(seed >> 8) / Float32(1 << 24) };
+        seed = seed * 1664525 + 1013904223;
+        const Float32 v { Float32(seed >> 8) / Float32(1 << 24) };
+        points.push_back(SkPoint::Make(
+            Float32(bounds.fLeft) - 200.f + u * Float32(bounds.width() + 400),
+            Float32(bounds.fTop) - 200.f + v * Float32(bounds.height() + 400)));
+    }
+
+    UInt64 begin { Bench::NowNs() };
+    const CZRegionIndex index { region };
+    const Float64 buildUs { Float64(Bench::NowNs() - begin) / 1e3 };
+
+    UInt32 inside { 0 }, containsMismatches { 0 }, closestMismatches { 0 };
+    std::vector<SkPoint> expected(Points);
+
+    begin = Bench::NowNs();
+    for (const auto &p : points)
+        inside += region.contains(SkScalarFloorToInt(p.x()), SkScalarFloorToInt(p.y()));
+    const Float64 containsNs { Float64(Bench::NowNs() - begin) / Points };
+
+    UInt32 indexInside { 0 };
+    begin = Bench::NowNs();
+    for (const auto &p : points)
+        indexInside += index.contains(p);
+    const Float64 indexContainsNs { Float64(Bench::NowNs() - begin) / Points };
+
+    for (const auto &p : points)
+        containsMismatches += index.contains(p) != region.contains(SkScalarFloorToInt(p.x()), SkScalarFloorToInt(p.y()));
+
+    begin = Bench::NowNs();
+    for (UInt32 i = 0; i < Points; i++)
+        expected[i] = CZRegionUtils::ClosestPointFrom(region, points[i], 1.f);
+    const Float64 closestNs { Float64(Bench::NowNs() - begin) / Points };
+
+    std::vector<SkPoint> closest(Points);
+    begin = Bench::NowNs();
+    for (UInt32 i = 0; i < Points; i++)
+        closest[i] = index.closestPoint(points[i], 1.f);
+    const Float64 indexClosestNs { Float64(Bench::NowNs() - begin) / Points };
+
+    // Ties between equally close rects may pick different points
+    for (UInt32 i = 0; i < Points; i++)
+        closestMismatches += SkPoint::Distance(closest[i], points[i]) != SkPoint::Distance(expected[i], points[i]);
+
+    printf("%-22s %5u rects %4zu bands, built in %7.1f us (%u%% of points inside)\n", name, CountRects(region),
+           index.bandCount(), buildUs, inside * 100 / Points);
+    Bench::DoNotOptimize(indexInside);
+    printf("    contains      SkRegion %8.1f ns  index %6.1f ns  x%6.1f\n", containsNs, indexContainsNs, containsNs / indexContainsNs);
+    printf("    closest point iterator %8.1f ns  index %6.1f ns  x%6.1f%s\n", closestNs, indexClosestNs,
+           closestNs / indexClosestNs, containsMismatches || closestMismatches ? "  MISMATCH" : "");
+}
+
+void Bench::RegionIndex()
+{
+    Run("Three monitors", MultiMonitor());
+    Run("Circle (r = 300)", Circle(300));
+    Run("Tiled grid (16 x 12)", Grid(16, 12));
+}
@@ -0,0 +1,138 @@
+#include "Bench.h"
+#include <CZ/Core/Utils/CZRegionUtils.h>
+#include <CZ/skia/core/SkRegion.h>
+
+using namespace CZ;
+
+// The previous CZRegionUtils::ApplyTransform(), one union per rect
+static void LegacyApplyTransform(SkRegion &region, SkISize size, CZTransform transform) noexcept
+{
+    region.op(SkIRect::MakeSize(size), SkRegion::Op::kIntersect_Op);
+
+    if (transform == CZTransform::Normal)
+        return;
+
+    const Int32 w { size.width() };
+    const Int32 h { size.height() };
+    SkRegion tmp;
+
+    for (SkRegion::Iterator it(region); !it.done(); it.next())
+    {
+        const SkIRect &r { it.rect() };
+        SkIRect out;
+
+        switch (transform)
+        {
+        case CZTransform::Flipped270: out = SkIRect::MakeLTRB(h - r.fBottom, w - r.fRight, h - r.fTop, w - r.fLeft); break;
+        case CZTransform::Flipped90:  out = SkIRect::MakeLTRB(r.fTop, r.fLeft, r.fBottom, r.fRight); break;
+        case CZTransform::Flipped180: out = SkIRect::MakeLTRB(r.fLeft, h - r.fBottom, r.fRight, h - r.fTop); break;
+        case CZTransform::Rotated180: out = SkIRect::MakeLTRB(w - r.fRight, h - r.fBottom, w - r.fLeft, h - r.fTop); break;
+        case CZTransform::Flipped:    out = SkIRect::MakeLTRB(w - r.fRight, r.fTop, w - r.fLeft, r.fBottom); break;
+        case CZTransform::Rotated90:  out = SkIRect::MakeLTRB(r.fTop, w - r.fRight, r.fBottom, w - r.fLeft); break;
+        case CZTransform::Rotated270: out = SkIRect::MakeLTRB(h - r.fBottom, r.fLeft, h - r.fTop, r.fRight); break;
+        default: out = r; break;
+        }
+
+        tmp.op(out, SkRegion::Op::kUnion_Op);
+    }
+
+    region = tmp;
+}
+
+// The previous CZRegionUtils::Scale()
+static void LegacyScale(SkRegion &region, Float32 factor) noexcept
+{
+    SkRegion tmp;
+
+    for (SkRegion::Iterator it(region); !it.done(); it.next())
+        tmp.op(SkIRect::MakeLTRB(
+                   SkScalarFloorToInt(factor * SkScalar(it.rect().fLeft)),
+                   SkScalarFloorToInt(factor * SkScalar(it.rect().fTop)),
+                   SkScalarCeilToInt(factor * SkScalar(it.rect().fRight)),
+                   SkScalarCeilToInt(factor * SkScalar(it.rect().fBottom))),
+               SkRegion::Op::kUnion_Op);
+
+    region = tmp;
+}
+
+static UInt32 CountRects(const SkRegion &region) noexcept
+{
+    UInt32 count { 0 };
+
+    for (SkRegion::Iterator it(region); !it.done(); it.next())
+        count++;
+
+    return count;
+}
+
+// Damage of scattered widgets on a 4K output, adding rects until the region has at least the given count
+static SkRegion MakeDamage(SkISize size, UInt32 rects) noexcept
+{
+    SkRegion region;
+    UInt32 seed { 7 };
+
+    while (CountRects(region) < rects)
+    {
+        seed = seed * 1664525 + 1013904223;
+        const Int32 x { Int32((seed >> 4) % UInt32(size.width() - 64)) };
+        const Int32 y { Int32((seed >> 16) % UInt32(size.height() - 64)) };
+        const Int32 width { 8 + Int32((seed >> 8) % 56) };
+        const Int32 height { 8 + Int32((seed >> 24) % 56) };
+        region.op(SkIRect::MakeXYWH(x, y, width, height), SkRegion::Op::kUnion_Op);
+    }
+
+    return region;
+}
+
+template<class F>
+static Float64 TimeUs(const SkRegion &input, UInt32 iterations, SkRegion &output, F &&apply) noexcept
+{
+    const UInt64 begin { Bench::NowNs() };
+
+    for (UInt32 i = 0; i < iterations; i++)
+    {
+        output = input;
+        apply(output);
+    }
+
+    return Float64(Bench::NowNs() - begin) / iterations / 1e3;
+}
+
+template<class L, class N>
+static void Run(const char *name, const SkRegion &input, L &&legacy, N &&batched) noexcept
+{
+    const UInt32 rects { CountRects(input) };
+    const UInt32 iterations { std::max(2u, 20000u / rects) };
+    SkRegion legacyOut, batchedOut;
+
+    const Float64 legacyUs { TimeUs(input, iterations, legacyOut, legacy) };
+    const Float64 batchedUs { TimeUs(input, iterations, batchedOut, batched) };
+
+    printf("%-12s %5u rects  per-rect union %9.2f us  batched %8.2f us  x%6.1f%s\n", name, rects, legacyUs,
+           batchedUs, legacyUs / batchedUs, legacyOut == batchedOut ? "" : "  MISMATCH");
+}
+
+void Bench::Regions()
+{
+    const SkISize size { SkISize::Make(3840, 2160) };
+
+    for (const UInt32 rects : { 10u, 100u, 1000u })
+    {
+        const SkRegion damage { MakeDamage(size, rects) };
+        printf("%sDamage of ~%u rects on a %dx%d output\n", rects == 10 ? "" : "\n", rects, size.width(), size.height());
+
+        for (Int32 i = 0; i < 8; i++)
+        {
+            const CZTransform transform { static_cast<CZTransform>(i) };
+
+            Run(CZ::TransformString(transform).data(), damage,
+                [&](SkRegion &region) { LegacyApplyTransform(region, size, transform); },
+                [&](SkRegion &region) { CZRegionUtils::ApplyTransform(region, size, transform); });
+        }
+
+        for (const Float32 factor : { 2.f, 1.5f })
+            Run(factor == 2.f ? "Scale(2)" : "Scale(1.5)", damage,
+                [&](SkRegion &region) { LegacyScale(region, factor); },
+                [&](SkRegion &region) { CZRegionUtils::Scale(region, factor); });
+    }
+}
@@ -0,0 +1,194 @@
+#include "Bench.h"
+#include <CZ/Core/CZSharedMemory.h>
+#include <algorithm>
+#include <cstring>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace CZ;
+
+/*
+ * Sharing a read-only copy of some data with a client, as done for keymaps: create the region,
+ * fill it, obtain a read-only fd and release the region.
+ */
+template<class F>
+static void Run(const char *name, UInt32 iterations, size_t size, F &&make)
+{
+    UInt32 failures { 0 };
+    const UInt64 begin { Bench::NowNs() };
+
+    for (UInt32 i = 0; i < iterations; i++)
+    {
+        const int fd { make(size) };
+
+        if (fd < 0)
+            failures++;
+        else
+            close(fd);
+    }
+
+    const Float64 us { Float64(Bench::NowNs() - begin) / iterations / 1e3 };
+    printf("%-34s %8.2f us/region  failures %u\n", name, us, failures);
+}
+
+namespace
+{
+    // The previous CZSharedMemory::resize(): unmap, truncate and map again
+    struct LegacyRegion
+    {
+        int fd { memfd_create("cz-bench", MFD_CLOEXEC) };
+        size_t size { 0 };
+        void *map { nullptr };
+        UInt64 remaps { 0 };
+
+        LegacyRegion(size_t initial) noexcept
+        {
+            ftruncate(fd, initial);
+            map = mmap(nullptr, initial, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            size = initial;
+        }
+
+        ~LegacyRegion() noexcept { munmap(map, size); close(fd); }
+
+        bool resize(size_t newSize) noexcept
+        {
+            munmap(map, size);
+            ftruncate(fd, newSize);
+            map = mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            size = newSize;
+            remaps++;
+            return map != MAP_FAILED;
+        }
+
+        UInt8 *data() const noexcept { return static_cast<UInt8*>(map); }
+    };
+
+    struct Region
+    {
+        std::shared_ptr<CZSharedMemory> shm;
+        UInt64 remaps { 0 };
+
+        Region(size_t initial, Float32 growthFactor) noexcept : shm(CZSharedMemory::MakeMemfd(initial, "cz-bench"))
+        {
+            shm->setGrowthFactor(growthFactor);
+        }
+
+        bool resize(size_t newSize) noexcept
+        {
+            const size_t capacity { shm->capacity() };
+            const bool ok { shm->resize(newSize) };
+            remaps += shm->capacity() != capacity;
+            return ok;
+        }
+        UInt8 *data() const noexcept { return static_cast<UInt8*>(shm->map()); }
+    };
+}
+
+static UInt64 MinorFaults() noexcept
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<UInt64>(usage.ru_minflt);
+}
+
+/*
+ * Grows a region from 4 KiB to 256 MiB in steps of the given size (0 doubles it), writing each new
+ * part and updating a header in the first page after every step. Each time the size doubles the
+ * whole buffer is read back, as a consumer scanning its contents would.
+ */
+template<class T>
+static void Grow(const char *name, size_t step, T &&region)
+{
+    constexpr size_t Initial { 4 * 1024 };
+    constexpr size_t Final { 256 * 1024 * 1024 };
+    const long pageSize { sysconf(_SC_PAGESIZE) };
+
+    UInt64 checksum { 0 }, moves { 0 };
+    size_t size { Initial }, nextScan { Initial * 2 };
+    memset(region.data(), 1, size);
+
+    const UInt64 faults { MinorFaults() };
+    const UInt64 begin { Bench::NowNs() };
+
+    while (size < Final)
+    {
+        const size_t newSize { std::min(Final, step ? size + step : size * 2) };
+        const UInt8 *prev { region.data() };
+
+        if (!region.resize(newSize))
+        {
+            printf("%-34s resize failed\n", name);
+            return;
+        }
+
+        moves += region.data() != prev;
+        memset(region.data() + size, 1, newSize - size);
+        region.data()[0]++;
+        size = newSize;
+
+        if (size >= nextScan)
+        {
+            for (size_t i = 0; i < size; i += pageSize)
+                checksum += region.data()[i];
+
+            nextScan *= 2;
+        }
+    }
+
+    const Float64 ms { Float64(Bench::NowNs() - begin) / 1e6 };
+    Bench::DoNotOptimize(checksum);
+    printf("%-34s %8.2f ms  %6llu remaps  %6llu moves  %8llu page faults\n", name, ms,
+           static_cast<unsigned long long>(region.remaps), static_cast<unsigned long long>(moves),
+           static_cast<unsigned long long>(MinorFaults() - faults));
+}
+
+void Bench::SharedMemory()
+{
+    constexpr UInt32 Iterations { 2000 };
+    constexpr size_t Size { 4 * 1024 };
+
+    printf("Create, fill and share read-only %zu KiB, average of %u runs\n", Size / 1024, Iterations);
+
+    Run("shm_open + reopen by name", Iterations, Size, [](size_t size) {
+        auto shm { CZSharedMemory::Make(size, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600) };
+
+        if (!shm)
+            return -1;
+
+        memset(shm->map(), 'x', size);
+        return shm->openReadOnly();
+    });
+
+    Run("memfd + seal + dup", Iterations, Size, [](size_t size) {
+        auto shm { CZSharedMemory::MakeMemfd(size) };
+
+        if (!shm)
+            return -1;
+
+        memset(shm->map(), 'x', size);
+        shm->seal();
+        return shm->openReadOnly();
+    });
+
+    Run("memfd (unsealed) + /proc reopen", Iterations, Size, [](size_t size) {
+        auto shm { CZSharedMemory::MakeMemfd(size) };
+
+        if (!shm)
+            return -1;
+
+        memset(shm->map(), 'x', size);
+        return shm->openReadOnly();
+    });
+
+    for (const size_t step : { size_t(0), size_t(64 * 1024) })
+    {
+        if (step)
+            printf("\nGrowing from 4 KiB to 256 MiB in 64 KiB steps\n");
+        else
+            printf("\nGrowing from 4 KiB to 256 MiB doubling the size\n");
+
+        Grow("munmap + ftruncate + mmap", step, LegacyRegion(4096));
+        Grow("resize() (exact, mremap)", step, Region(4096, 1.f));
+        Grow("resize() (growth factor 2)", step, Region(4096, 2.f));
+    }
+}
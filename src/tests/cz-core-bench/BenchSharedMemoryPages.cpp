@@ -0,0 +1,87 @@
+#include "Bench.h"
+#include <CZ/Core/CZSharedMemory.h>
+#include <cstring>
+#include <sys/resource.h>
+
+using namespace CZ;
+
+static UInt64 MinorFaults() noexcept
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<UInt64>(usage.ru_minflt);
+}
+
+/*
+ * Creates an 8K ARGB framebuffer (or grows a 4K one to 8K) and renders the first frame into it,
+ * counting the page faults and time spent on each step.
+ */
+static void Run(const char *name, const CZSharedMemory::Options &options, bool fromResize) noexcept
+{
+    constexpr size_t Size4K { 3840 * 2160 * 4 };
+    constexpr size_t Size8K { 7680 * 4320 * 4 };
+
+    UInt64 faults { MinorFaults() };
+    UInt64 begin { Bench::NowNs() };
+
+    auto shm { CZSharedMemory::MakeMemfd(fromResize ? Size4K : Size8K, "cz-bench", options) };
+
+    if (!shm)
+    {
+        printf("%-30s failed\n", name);
+        return;
+    }
+
+    if (fromResize)
+    {
+        memset(shm->map(), 0x20, Size4K);
+        faults = MinorFaults();
+        begin = Bench::NowNs();
+
+        if (!shm->resize(Size8K))
+        {
+            printf("%-30s resize failed\n", name);
+            return;
+        }
+    }
+
+    const Float64 setupMs { Float64(Bench::NowNs() - begin) / 1e6 };
+    const UInt64 setupFaults { MinorFaults() - faults };
+
+    faults = MinorFaults();
+    begin = Bench::NowNs();
+    memset(shm->map(), 0x40, Size8K);
+    const Float64 frameMs { Float64(Bench::NowNs() - begin) / 1e6 };
+    const UInt64 frameFaults { MinorFaults() - faults };
+
+    printf("%-30s %s %7.2f ms %7llu faults | first frame %7.2f ms %7llu faults%s\n", name,
+           fromResize ? "resize" : "create", setupMs, static_cast<unsigned long long>(setupFaults),
+           frameMs, static_cast<unsigned long long>(frameFaults),
+           options.hugetlb && !shm->options().hugetlb ? "  (no huge pages, fell back)" : "");
+}
+
+void Bench::SharedMemoryPages()
+{
+    CZSharedMemory::Options populate, thp, thpPopulate, hugetlb, numa;
+    populate.populate = true;
+    thp.transparentHugepages = true;
+    thpPopulate.transparentHugepages = true;
+    thpPopulate.populate = true;
+    hugetlb.hugetlb = true;
+    hugetlb.populate = true;
+    numa.numaNode = 0;
+    numa.populate = true;
+
+    for (const bool fromResize : { false, true })
+    {
+        printf("%s an 8K framebuffer (%.1f MiB) and rendering the first frame\n",
+               fromResize ? "\nGrowing a 4K framebuffer to" : "Creating", 7680.0 * 4320.0 * 4.0 / (1024 * 1024));
+
+        Run("Default", {}, fromResize);
+        Run("populate", populate, fromResize);
+        Run("transparentHugepages", thp, fromResize);
+        Run("transparentHugepages+populate", thpPopulate, fromResize);
+        Run("hugetlb+populate", hugetlb, fromResize);
+        Run("numaNode 0+populate", numa, fromResize);
+    }
+}
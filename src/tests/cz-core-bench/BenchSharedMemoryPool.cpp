@@ -0,0 +1,151 @@
+#include "Bench.h"
+#include <CZ/Core/CZSharedMemoryPool.h>
+#include <algorithm>
+#include <vector>
+
+using namespace CZ;
+
+namespace
+{
+    struct Op
+    {
+        bool alloc;
+        UInt32 index; // Slot in the live set
+        size_t size;
+    };
+
+    // One region per buffer, the approach before CZSharedMemoryPool
+    struct PerBuffer
+    {
+        std::vector<std::shared_ptr<CZSharedMemory>> live;
+        explicit PerBuffer(UInt32 capacity) : live(capacity) {}
+        bool alloc(UInt32 index, size_t size) noexcept { return (live[index] = CZSharedMemory::MakeMemfd(size)) != nullptr; }
+        void free(UInt32 index) noexcept { live[index].reset(); }
+    };
+
+    struct Pooled
+    {
+        std::shared_ptr<CZSharedMemoryPool> pool { CZSharedMemoryPool::Make(4 * 1024 * 1024) };
+        std::vector<CZSharedMemoryPool::Slice> live;
+        Float64 maxFragmentation { 0.0 };
+        explicit Pooled(UInt32 capacity) : live(capacity) {}
+        bool alloc(UInt32 index, size_t size) noexcept { return (live[index] = pool->alloc(size)).size > 0; }
+
+        void free(UInt32 index) noexcept
+        {
+            pool->free(live[index]);
+            live[index] = {};
+            maxFragmentation = std::max(maxFragmentation, pool->stats().fragmentation);
+        }
+    };
+}
+
+// Buffers of 32x32 to 512x512 ARGB pixels, up to 48 alive, allocated and released at random
+static std::vector<Op> MakeOps(UInt32 count, UInt32 maxLive) noexcept
+{
+    std::vector<Op> ops;
+    std::vector<UInt32> live, freeSlots;
+    ops.reserve(count);
+
+    for (UInt32 i = 0; i < maxLive; i++)
+        freeSlots.push_back(maxLive - 1 - i);
+
+    UInt32 seed { 3 };
+
+    while (ops.size() < count)
+    {
+        seed = seed * 1664525 + 1013904223;
+
+        if (!live.empty() && (freeSlots.empty() || (seed >> 31)))
+        {
+            const size_t i { (seed >> 8) % live.size() };
+            ops.push_back({ false, live[i], 0 });
+            freeSlots.push_back(live[i]);
+            live[i] = live.back();
+            live.pop_back();
+        }
+        else
+        {
+            const size_t width { 32 + (seed >> 4) % 481 };
+            const size_t height { 32 + (seed >> 14) % 481 };
+            ops.push_back({ true, freeSlots.back(), width * height * 4 });
+            live.push_back(freeSlots.back());
+            freeSlots.pop_back();
+        }
+    }
+
+    return ops;
+}
+
+static Float64 Percentile(std::vector<UInt64> &ns, Float64 p) noexcept
+{
+    if (ns.empty())
+        return 0.0;
+
+    const size_t i { std::min(ns.size() - 1, static_cast<size_t>(p * static_cast<Float64>(ns.size()))) };
+    std::nth_element(ns.begin(), ns.begin() + i, ns.end());
+    return static_cast<Float64>(ns[i]) / 1e3;
+}
+
+template<class T>
+static void Run(const char *name, const std::vector<Op> &ops, T &impl) noexcept
+{
+    std::vector<UInt64> allocNs, freeNs;
+    allocNs.reserve(ops.size());
+    freeNs.reserve(ops.size());
+    UInt32 failures { 0 };
+
+    for (const auto &op : ops)
+    {
+        const UInt64 begin { Bench::NowNs() };
+
+        if (op.alloc)
+        {
+            failures += !impl.alloc(op.index, op.size);
+            allocNs.push_back(Bench::NowNs() - begin);
+        }
+        else
+        {
+            impl.free(op.index);
+            freeNs.push_back(Bench::NowNs() - begin);
+        }
+    }
+
+    printf("%-22s alloc p50 %6.2f  p99 %7.2f  max %8.2f us | free p50 %6.2f  p99 %7.2f us | failures %u\n", name,
+           Percentile(allocNs, 0.5), Percentile(allocNs, 0.99), Percentile(allocNs, 1.0),
+           Percentile(freeNs, 0.5), Percentile(freeNs, 0.99), failures);
+}
+
+void Bench::SharedMemoryPool()
+{
+    constexpr UInt32 Ops { 40000 };
+    constexpr UInt32 MaxLive { 48 };
+
+    printf("%u random allocations and releases of 4 KiB to 1 MiB buffers, up to %u alive\n", Ops, MaxLive);
+
+    const auto ops { MakeOps(Ops, MaxLive) };
+
+    PerBuffer perBuffer { MaxLive };
+    Run("CZSharedMemory each", ops, perBuffer);
+
+    Pooled pooled { MaxLive };
+    Run("CZSharedMemoryPool", ops, pooled);
+
+    const auto stats { pooled.pool->stats() };
+    printf("Pool: %.1f MiB, %zu slices using %.1f MiB, %zu free ranges, largest %.1f MiB, "
+           "fragmentation %.2f (max %.2f), %llu grows\n",
+           static_cast<Float64>(stats.size) / (1024 * 1024), stats.slices,
+           static_cast<Float64>(stats.used) / (1024 * 1024), stats.freeRanges,
+           static_cast<Float64>(stats.largestFree) / (1024 * 1024), stats.fragmentation, pooled.maxFragmentation,
+           static_cast<unsigned long long>(stats.grows));
+    printf("Pool stats: alloc mean %.2f  max %.2f us, grow total %.2f  max %.2f us\n",
+           static_cast<Float64>(stats.allocNs) / static_cast<Float64>(std::max<UInt64>(stats.allocations + stats.failures, 1)) / 1000.0,
+           static_cast<Float64>(stats.maxAllocNs) / 1000.0, static_cast<Float64>(stats.growNs) / 1000.0,
+           static_cast<Float64>(stats.maxGrowNs) / 1000.0);
+
+    for (UInt32 i = 0; i < MaxLive; i++)
+        if (pooled.live[i])
+            pooled.free(i);
+
+    printf("Released %.1f MiB of free tail after freeing everything\n", static_cast<Float64>(pooled.pool->trim()) / (1024 * 1024));
+}
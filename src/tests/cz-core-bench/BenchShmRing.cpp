@@ -0,0 +1,236 @@
+#include "Bench.h"
+#include <CZ/Core/CZShmRing.h>
+#include <algorithm>
+#include <cstring>
+#include <sched.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace CZ;
+
+namespace
+{
+    // A telemetry or input sample
+    struct Sample
+    {
+        UInt64 sequence;
+        UInt64 sentNs;
+        Float64 values[6];
+    };
+
+    // Sent back by the consumer process
+    struct Result
+    {
+        UInt64 received;
+        UInt64 outOfOrder;
+        Float64 p50Us;
+        Float64 p99Us;
+        Float64 maxUs;
+    };
+
+    // Consumer side of a channel, in the child process
+    struct Receiver
+    {
+        std::vector<UInt64> latencyNs;
+        Result result {};
+
+        void receive(const Sample &sample) noexcept
+        {
+            result.outOfOrder += sample.sequence != result.received;
+            result.received++;
+
+            if (latencyNs.size() < latencyNs.capacity())
+                latencyNs.push_back(Bench::NowNs() - sample.sentNs);
+        }
+
+        Result finish() noexcept
+        {
+            if (!latencyNs.empty())
+            {
+                std::sort(latencyNs.begin(), latencyNs.end());
+                result.p50Us = Float64(latencyNs[latencyNs.size() / 2]) / 1e3;
+                result.p99Us = Float64(latencyNs[latencyNs.size() * 99 / 100]) / 1e3;
+                result.maxUs = Float64(latencyNs.back()) / 1e3;
+            }
+
+            return result;
+        }
+    };
+}
+
+static void SleepUs(UInt64 us) noexcept
+{
+    const timespec ts { 0, static_cast<long>(us * 1000) };
+    nanosleep(&ts, nullptr);
+}
+
+/*
+ * Runs consume(Receiver&) in a child process and produce() in this one, returning the time until
+ * the child received everything and its result.
+ */
+template<class P, class C>
+static Float64 RunProcesses(P &&produce, C &&consume, UInt64 latencySamples, Result &result) noexcept
+{
+    int pipeFds[2];
+
+    if (pipe(pipeFds) != 0)
+        return 0.0;
+
+    const UInt64 begin { Bench::NowNs() };
+    const pid_t pid { fork() };
+
+    if (pid == 0)
+    {
+        close(pipeFds[0]);
+        Receiver receiver;
+        receiver.latencyNs.reserve(latencySamples);
+        consume(receiver);
+        const Result childResult { receiver.finish() };
+        [[maybe_unused]] const auto written { write(pipeFds[1], &childResult, sizeof(childResult)) };
+        _exit(0);
+    }
+
+    close(pipeFds[1]);
+    produce();
+
+    result = {};
+    [[maybe_unused]] const auto read { ::read(pipeFds[0], &result, sizeof(result)) };
+    const Float64 ms { Float64(Bench::NowNs() - begin) / 1e6 };
+    close(pipeFds[0]);
+    waitpid(pid, nullptr, 0);
+    return ms;
+}
+
+static void Print(const char *name, Float64 ms, UInt64 intervalUs, const Result &result, const char *cost) noexcept
+{
+    if (intervalUs)
+        printf("%-24s latency p50 %6.2f  p99 %7.2f  max %8.2f us | %s\n", name, result.p50Us, result.p99Us,
+               result.maxUs, cost);
+    else
+        printf("%-24s %8.2f ms  %6.2f M msg/s | %s\n", name, ms, Float64(result.received) / ms / 1e3, cost);
+}
+
+static void Check(const Result &result, UInt64 count) noexcept
+{
+    if (result.received != count || result.outOfOrder)
+        printf("  received %llu of %llu, %llu out of order\n", static_cast<unsigned long long>(result.received),
+               static_cast<unsigned long long>(count), static_cast<unsigned long long>(result.outOfOrder));
+}
+
+/*
+ * Sends count samples, every intervalUs or as fast as possible if 0, through a CZShmRing.
+ */
+static void RunRing(const char *name, UInt64 count, UInt64 intervalUs) noexcept
+{
+    auto ring { CZShmRing::Make(256 * 1024, CZShmRing::Role::Producer) };
+
+    if (!ring)
+    {
+        printf("%-24s failed\n", name);
+        return;
+    }
+
+    UInt64 yields { 0 };
+    Result result;
+
+    const Float64 ms { RunProcesses([&] {
+        for (UInt64 i = 0; i < count; i++)
+        {
+            Sample *sample;
+
+            while (!(sample = static_cast<Sample*>(ring->reserve(sizeof(Sample)))))
+            {
+                yields++;
+                sched_yield();
+            }
+
+            sample->sequence = i;
+            sample->values[0] = Float64(i);
+            sample->sentNs = Bench::NowNs();
+            ring->commit();
+
+            if (intervalUs)
+                SleepUs(intervalUs);
+        }
+    }, [&](Receiver &receiver) {
+        auto consumer { CZShmRing::Open(ring->memoryFd(), ring->eventFd(), CZShmRing::Role::Consumer) };
+
+        while (consumer && receiver.result.received < count && consumer->wait())
+            consumer->drain([&](std::span<const UInt8> message) {
+                receiver.receive(*reinterpret_cast<const Sample*>(message.data()));
+            });
+    }, intervalUs ? count : 0, result) };
+
+    char wakeups[64];
+    snprintf(wakeups, sizeof(wakeups), "%llu wakeups, %llu full", static_cast<unsigned long long>(ring->wakeups()),
+             static_cast<unsigned long long>(yields));
+    Print(name, ms, intervalUs, result, wakeups);
+    Check(result, count);
+}
+
+/*
+ * Same through a SOCK_SEQPACKET socket pair, a write() and a read() per sample.
+ */
+static void RunSocket(const char *name, UInt64 count, UInt64 intervalUs) noexcept
+{
+    int fds[2];
+
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds) != 0)
+    {
+        printf("%-24s failed\n", name);
+        return;
+    }
+
+    Result result;
+
+    const Float64 ms { RunProcesses([&] {
+        close(fds[1]);
+        Sample sample {};
+
+        for (UInt64 i = 0; i < count; i++)
+        {
+            sample.sequence = i;
+            sample.values[0] = Float64(i);
+            sample.sentNs = Bench::NowNs();
+
+            if (write(fds[0], &sample, sizeof(sample)) != sizeof(sample))
+                break;
+
+            if (intervalUs)
+                SleepUs(intervalUs);
+        }
+    }, [&](Receiver &receiver) {
+        close(fds[0]);
+        Sample sample;
+
+        while (receiver.result.received < count && read(fds[1], &sample, sizeof(sample)) == sizeof(sample))
+            receiver.receive(sample);
+    }, intervalUs ? count : 0, result) };
+
+    close(fds[0]);
+
+    char syscalls[64];
+    snprintf(syscalls, sizeof(syscalls), "%llu syscalls", static_cast<unsigned long long>(count * 2));
+    Print(name, ms, intervalUs, result, syscalls);
+    Check(result, count);
+}
+
+void Bench::ShmRing()
+{
+    constexpr UInt64 Count { 2000000 };
+    constexpr UInt64 LatencyCount { 5000 };
+    constexpr UInt64 IntervalUs { 200 };
+
+    printf("%llu samples of %zu bytes from this process to a child, as fast as possible\n",
+           static_cast<unsigned long long>(Count), sizeof(Sample));
+    RunSocket("socketpair (SEQPACKET)", Count, 0);
+    RunRing("CZShmRing", Count, 0);
+
+    printf("\n%llu samples every %llu us, consumer sleeping between them\n",
+           static_cast<unsigned long long>(LatencyCount), static_cast<unsigned long long>(IntervalUs));
+    RunSocket("socketpair (SEQPACKET)", LatencyCount, IntervalUs);
+    RunRing("CZShmRing", LatencyCount, IntervalUs);
+}
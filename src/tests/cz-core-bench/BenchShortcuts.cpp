@@ -0,0 +1,190 @@
+#include "Bench.h"
+#include <CZ/Core/CZShortcutMap.h>
+#include <array>
+#include <vector>
+
+using namespace CZ;
+
+using Chord = CZShortcutMap::Chord;
+
+namespace
+{
+    struct Binding
+    {
+        std::array<Chord, 2> sequence;
+        UInt32 length;
+        UInt32 id;
+    };
+
+    // Scanning a list of bindings on every key event, the usual approach before CZShortcutMap
+    struct LegacyShortcuts
+    {
+        std::vector<Binding> bindings;
+        Chord pending {};
+        bool isPending { false };
+
+        static bool Equal(Chord a, Chord b) noexcept
+        {
+            return (a.modifiers & CZShortcutMap::Modifiers) == (b.modifiers & CZShortcutMap::Modifiers) &&
+                   xkb_keysym_to_lower(a.symbol) == xkb_keysym_to_lower(b.symbol);
+        }
+
+        void add(const Binding &binding) noexcept { bindings.push_back(binding); }
+
+        CZShortcutMap::Match feed(Chord chord) noexcept
+        {
+            const UInt32 step { isPending ? 1u : 0u };
+
+            for (const auto &binding : bindings)
+            {
+                if (binding.length <= step || (isPending && !Equal(binding.sequence[0], pending)))
+                    continue;
+
+                if (!Equal(binding.sequence[step], chord))
+                    continue;
+
+                if (binding.length == step + 1)
+                {
+                    isPending = false;
+                    return { CZShortcutMap::Matched, binding.id };
+                }
+
+                pending = chord;
+                isPending = true;
+                return { CZShortcutMap::Pending, 0 };
+            }
+
+            if (isPending)
+            {
+                isPending = false;
+                return { CZShortcutMap::Cancelled, 0 };
+            }
+
+            return { CZShortcutMap::None, 0 };
+        }
+    };
+
+    struct CompiledShortcuts
+    {
+        CZShortcutMap map;
+
+        void add(const Binding &binding) noexcept
+        {
+            map.add(std::span<const Chord> { binding.sequence.data(), binding.length }, binding.id);
+        }
+
+        CZShortcutMap::Match feed(Chord chord) noexcept { return map.feed(chord); }
+    };
+}
+
+static constexpr UInt32 ModifierCombos { 16 };
+
+// Every combination of Shift, Ctrl, Alt and Super
+static UInt32 Modifiers(UInt32 combo) noexcept
+{
+    return ((combo & 1) ? CZShortcutMap::Shift : 0) | ((combo & 2) ? CZShortcutMap::Ctrl : 0) |
+           ((combo & 4) ? CZShortcutMap::Alt : 0) | ((combo & 8) ? CZShortcutMap::Super : 0);
+}
+
+// Caseless keysyms (CJK Unicode), so lowercasing never merges two bindings
+static xkb_keysym_t Symbol(UInt32 index) noexcept
+{
+    return 0x1004E00 + index;
+}
+
+/*
+ * 9000 single-chord shortcuts over every modifier combination plus 1000 two-chord sequences
+ * behind 10 prefixes (e.g. Ctrl+Super+K followed by a plain key).
+ */
+static std::vector<Binding> MakeBindings() noexcept
+{
+    std::vector<Binding> bindings;
+    bindings.reserve(10000);
+
+    for (UInt32 i = 0; i < 9000; i++)
+        bindings.push_back({ {{ { Modifiers(i % ModifierCombos), Symbol(i / ModifierCombos) } }}, 1, i });
+
+    for (UInt32 i = 0; i < 1000; i++)
+        bindings.push_back({ {{ { CZShortcutMap::Ctrl | CZShortcutMap::Super, Symbol(0x1000 + i / 100) },
+                                { 0, Symbol(i % 100) } }}, 2, 9000 + i });
+
+    return bindings;
+}
+
+// Half single shortcuts, a tenth sequences and the rest plain typing that matches nothing
+static std::vector<Chord> MakeEvents(const std::vector<Binding> &bindings, UInt32 count) noexcept
+{
+    std::vector<Chord> events;
+    events.reserve(count + 1);
+    UInt32 seed { 11 };
+
+    while (events.size() < count)
+    {
+        seed = seed * 1664525 + 1013904223;
+        const UInt32 roll { (seed >> 24) % 10 };
+
+        if (roll < 5)
+            events.push_back(bindings[(seed >> 8) % 9000].sequence[0]);
+        else if (roll == 5)
+        {
+            const auto &binding { bindings[9000 + (seed >> 8) % 1000] };
+            events.push_back(binding.sequence[0]);
+            events.push_back(binding.sequence[1]);
+        }
+        else
+            events.push_back({ 0, Symbol(0x2000 + (seed >> 8) % 1000) });
+    }
+
+    return events;
+}
+
+template<class T>
+static void Run(const char *name, const std::vector<Binding> &bindings, const std::vector<Chord> &events, UInt64 &checksum)
+{
+    T shortcuts;
+
+    UInt64 begin { Bench::NowNs() };
+
+    for (const auto &binding : bindings)
+        shortcuts.add(binding);
+
+    const Float64 buildMs { Float64(Bench::NowNs() - begin) / 1e6 };
+    UInt64 sum { 0 }, matched { 0 };
+
+    const UInt64 allocs { Bench::Allocations() };
+    begin = Bench::NowNs();
+
+    for (const auto &chord : events)
+    {
+        const auto match { shortcuts.feed(chord) };
+        sum = sum * 31 + match.status * 100000 + match.id;
+        matched += match.status == CZShortcutMap::Matched;
+    }
+
+    const UInt64 ns { Bench::NowNs() - begin };
+    const UInt64 allocations { Bench::Allocations() - allocs };
+
+    printf("%-22s %10.1f ns/event  %6.3f allocs/event  build %6.2f ms  matched %llu\n",
+           name, Float64(ns) / events.size(), Float64(allocations) / events.size(), buildMs,
+           static_cast<unsigned long long>(matched));
+
+    checksum = sum;
+}
+
+void Bench::Shortcuts()
+{
+    const auto bindings { MakeBindings() };
+
+    printf("Matching key events against %zu bindings (9000 chords, 1000 two-chord sequences)\n", bindings.size());
+
+    const auto events { MakeEvents(bindings, 2000000) };
+
+    // The scan is O(bindings) per event, run it over a slice
+    const std::vector<Chord> slice { events.begin(), events.begin() + 20000 };
+
+    UInt64 legacy, compiled, compiledSlice;
+    Run<LegacyShortcuts>("Linear scan", bindings, slice, legacy);
+    Run<CompiledShortcuts>("CZShortcutMap", bindings, slice, compiledSlice);
+    Run<CompiledShortcuts>("CZShortcutMap (2M)", bindings, events, compiled);
+    printf("Results match: %s\n", legacy == compiledSlice ? "yes" : "no");
+}
@@ -0,0 +1,117 @@
+#include "Bench.h"
+#include <CZ/Core/CZCore.h>
+#include <CZ/Core/CZInputDevice.h>
+#include <CZ/Core/Events/CZTouchBatchEvent.h>
+
+using namespace CZ;
+
+namespace
+{
+    class Target : public CZObject
+    {
+    public:
+        UInt64 points {};
+        UInt64 frames {};
+        Float32 sum {};
+
+        // Expands batches into per-point events, like a consumer that was not updated
+        bool legacy {};
+    protected:
+        bool event(const CZEvent &e) noexcept override
+        {
+            if (e.type() != CZEvent::Type::TouchBatch)
+            {
+                point(e);
+                return true;
+            }
+
+            const auto &batch { static_cast<const CZTouchBatchEvent&>(e) };
+
+            if (legacy)
+            {
+                batch.forEachPointEvent([this](const CZInputEvent &p) { point(p); });
+                return true;
+            }
+
+            for (UInt32 i = 0; i < batch.count; i++)
+                sum += batch.pos[i].x();
+
+            points += batch.count;
+            frames++;
+            return true;
+        }
+    private:
+        // Kept apart from event() so expanded batch points never reach the batch cast
+        void point(const CZEvent &e) noexcept
+        {
+            if (e.type() == CZEvent::Type::TouchMove)
+            {
+                sum += static_cast<const CZTouchMoveEvent&>(e).pos.x();
+                points++;
+            }
+            else if (e.type() == CZEvent::Type::TouchFrame)
+                frames++;
+        }
+    };
+}
+
+template<class Post>
+static void Run(const char *name, bool legacy, Post post)
+{
+    constexpr UInt32 Hz { 240 };
+    constexpr UInt32 Seconds { 10 };
+    constexpr UInt32 Fingers { 10 };
+
+    auto core { CZCore::Get() };
+    auto device { CZInputDevice::Make(CZInputDevice::Touch, "Bench Touchscreen") };
+    Target target;
+    target.legacy = legacy;
+
+    const UInt64 allocs { Bench::Allocations() };
+    const UInt64 begin { Bench::NowNs() };
+
+    for (UInt32 frame = 0; frame < Hz * Seconds; frame++)
+    {
+        post(*core, target, device, frame, Fingers);
+        core->dispatch(0);
+    }
+
+    const UInt64 ns { Bench::NowNs() - begin };
+    const UInt64 total { Bench::Allocations() - allocs };
+
+    printf("%-30s %8.0f allocs/s  %6.0f ns/frame  (%lu points, %lu frames)\n",
+           name, Float64(total) / Seconds, Float64(ns) / (Hz * Seconds), target.points, target.frames);
+}
+
+void Bench::Touch()
+{
+    auto core { CZCore::GetOrMake() };
+
+    printf("10-finger touch at 240 Hz\n");
+
+    Run("per-point events (shared_ptr)", false, [](CZCore &core, CZObject &target, const auto &device, UInt32 frame, UInt32 fingers) {
+        for (UInt32 id = 0; id < fingers; id++)
+        {
+            auto event { std::make_shared<CZTouchMoveEvent>() };
+            event->device = device;
+            event->id = id;
+            event->pos = SkPoint::Make(id * 100.f, frame);
+            core.postEvent(event, target);
+        }
+
+        auto event { std::make_shared<CZTouchFrameEvent>() };
+        event->device = device;
+        core.postEvent(event, target);
+    });
+
+    const auto postBatch = [](CZCore &core, CZObject &target, const auto &device, UInt32 frame, UInt32 fingers) {
+        auto &batch { core.postEvent<CZTouchBatchEvent>(target, core.loopTimeUs()) };
+        batch.device = device;
+
+        for (UInt32 id = 0; id < fingers; id++)
+            batch.add(CZTouchBatchEvent::State::Move, id, SkPoint::Make(id * 100.f, frame));
+    };
+
+    Run("batched (pooled)", false, postBatch);
+    Run("batched, expanded by consumer", true, postBatch);
+}
@@ -0,0 +1,100 @@
+#include "Bench.h"
+#include <CZ/Core/CZVelocityTracker.h>
+#include <CZ/Core/Events/CZPointerMoveEvent.h>
+#include <cmath>
+#include <vector>
+
+using namespace CZ;
+
+namespace
+{
+    // What consumers typically write: a growing vector trimmed from the front and a full refit per query
+    class NaiveTracker
+    {
+    public:
+        void addSample(UInt64 us, SkPoint pos) noexcept
+        {
+            samples.push_back({ us, pos });
+
+            while (!samples.empty() && us - samples.front().us > 100000)
+                samples.erase(samples.begin());
+        }
+
+        SkPoint velocity() const noexcept
+        {
+            if (samples.size() < 2)
+                return {};
+
+            Float64 st {}, stt {}, sx {}, stx {}, sy {}, sty {};
+            const Float64 n ( samples.size() );
+
+            for (const auto &s : samples)
+            {
+                const Float64 t { (s.us - samples.front().us) * 1e-6 };
+                st += t; stt += t * t; sx += s.pos.x(); stx += t * s.pos.x(); sy += s.pos.y(); sty += t * s.pos.y();
+            }
+
+            const Float64 den { n * stt - st * st };
+            return SkPoint::Make((n * stx - st * sx) / den, (n * sty - st * sy) / den);
+        }
+
+    private:
+        struct Sample { UInt64 us; SkPoint pos; };
+        std::vector<Sample> samples;
+    };
+}
+
+template<class Tracker>
+static void Run(const char *name, Tracker &tracker)
+{
+    constexpr UInt32 Samples { 1000000 };
+    constexpr Float64 Vx { 1200.0 }, Vy { -450.0 };
+
+    Float64 maxError { 0.0 };
+    UInt32 seed { 1 };
+    UInt64 us { 5000000 };
+
+    const UInt64 allocs { Bench::Allocations() };
+    const UInt64 begin { Bench::NowNs() };
+
+    for (UInt32 i = 0; i < Samples; i++)
+    {
+        // 1000 Hz with +-100 us of timestamp jitter and +-0.5 px of quantization noise
+        seed = seed * 1664525 + 1013904223;
+        const Int32 jitter { static_cast<Int32>(seed >> 24) - 128 };
+        us += 1000;
+        const Float64 t { (us - 5000000) * 1e-6 };
+        const UInt64 stamped { static_cast<UInt64>(static_cast<Int64>(us) + jitter * 100 / 128) };
+        tracker.addSample(stamped, SkPoint::Make(std::round(Vx * t), std::round(Vy * t)));
+
+        const SkPoint v { tracker.velocity() };
+        Bench::DoNotOptimize(v);
+
+        if (i > 100)
+            maxError = std::max(maxError, std::hypot(v.x() - Vx, v.y() - Vy) / std::hypot(Vx, Vy));
+    }
+
+    const UInt64 ns { Bench::NowNs() - begin };
+    printf("%-22s %6.1f ns/sample (add + velocity)  %8lu allocs  max error %.2f%%\n",
+           name, Float64(ns) / Samples, Bench::Allocations() - allocs, maxError * 100.0);
+}
+
+void Bench::Velocity()
+{
+    printf("1M pointer samples at 1000 Hz, 100 ms horizon\n");
+
+    NaiveTracker naive;
+    Run("vector + refit", naive);
+
+    CZVelocityTracker tracker;
+    Run("CZVelocityTracker", tracker);
+
+    // Prediction: how close the fit gets to the true position 16 ms after the last sample
+    tracker.reset();
+
+    for (UInt64 us = 0; us <= 50000; us += 1000)
+        tracker.addSample(1000000 + us, SkPoint::Make(us * 1e-3, 0.f));
+
+    const SkPoint predicted { tracker.predict(1000000 + 66000) };
+    printf("Predicted x at +16 ms: %.2f (expected 66.00)\n", predicted.x());
+}
@@ -0,0 +1,63 @@
+#include "Bench.h"
+#include "CZTest.h"
+#include <cstdlib>
+#include <cstring>
+
+using namespace CZ;
+
+UInt64 Bench::Allocations() noexcept
+{
+    return Test::Allocations();
+}
+
+struct Entry
+{
+    const char *name;
+    void (*run)();
+};
+
+static constexpr Entry Benchmarks[]
+{
+    { "damage", Bench::DamageRing },
+    { "events", Bench::Events },
+    { "lanes", Bench::EventLanes },
+    { "queue", Bench::EventQueue },
+    { "keymap", Bench::Keymap },
+    { "keys", Bench::KeySet },
+    { "region-index", Bench::RegionIndex },
+    { "regions", Bench::Regions },
+    { "replay", Bench::InputReplay },
+    { "rrect-index", Bench::RRectIndex },
+    { "shm", Bench::SharedMemory },
+    { "shm-pages", Bench::SharedMemoryPages },
+    { "shm-pool", Bench::SharedMemoryPool },
+    { "shm-ring", Bench::ShmRing },
+    { "shortcuts", Bench::Shortcuts },
+    { "touch", Bench::Touch },
+    { "velocity", Bench::Velocity },
+};
+
+/*
+ * Usage: cz-core-bench [name...]
+ * Runs all benchmarks if no name is given.
+ */
+int main(int argc, char *argv[])
+{
+    setenv("CZ_CORE_LOG_LEVEL", "2", 0);
+
+    for (const auto &bench : Benchmarks)
+    {
+        bool selected { argc == 1 };
+
+        for (int i = 1; i < argc && !selected; i++)
+            selected = strcmp(argv[i], bench.name) == 0;
+
+        if (!selected)
+            continue;
+
+        printf("\n=== %s ===\n", bench.name);
+        bench.run();
+    }
+
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "CZTest.h"
+#include <CZ/Core/CZCore.h>
+#include <CZ/Core/CZLog.h>
+#include <CZ/Core/CZSafeEventQueue.h>
+#include <CZ/Core/Events/CZCloseEvent.h>
+#include <CZ/Core/Events/CZEventPool.h>
+#include <CZ/Core/Events/CZLayoutEvent.h>
+#include <CZ/Core/Events/CZPointerMoveEvent.h>
+#include <cstdlib>
+#include <memory>
+
+using namespace CZ;
+using Test::Check;
+
+namespace
+{
+    class Target : public CZObject
+    {
+    public:
+        UInt32 moves {};
+        UInt32 layouts {};
+        UInt32 closes {};
+        SkPoint pos {};
+        SkPoint delta {};
+        size_t historySize {};
+
+        // If set, every move posts another one, as a device producing input non-stop
+        CZSafeEventQueue *feedQueue {};
+    protected:
+        bool event(const CZEvent &e) noexcept override
+        {
+            if (e.type() == CZEvent::Type::Layout)
+                layouts++;
+            else if (e.type() == CZEvent::Type::Close)
+                closes++;
+
+            if (e.type() != CZEvent::Type::PointerMove)
+                return true;
+
+            if (feedQueue)
+                feedQueue->addEvent(std::make_shared<CZPointerMoveEvent>(), *this);
+
+            const auto &move { static_cast<const CZPointerMoveEvent&>(e) };
+            moves++;
+            pos = move.pos;
+            delta = move.delta;
+            historySize = move.history.size();
+            return true;
+        }
+    };
+}
+
+static std::shared_ptr<CZPointerMoveEvent> Move(Float32 x, UInt64 us) noexcept
+{
+    auto event { std::make_shared<CZPointerMoveEvent>(us) };
+    event->pos = SkPoint::Make(x, 0.f);
+    event->delta = SkPoint::Make(1.f, 0.f);
+    return event;
+}
+
+int main()
+{
+    setenv("CZ_CORE_LOG_LEVEL", "4", 1);
+
+    auto core { CZCore::GetOrMake() };
+
+    /* COALESCING */
+
+    {
+        CZSafeEventQueue queue;
+        queue.setCoalescePolicy(CZSafeEventQueue::CoalescePolicy::Motion);
+        Target target;
+
+        // The poster keeps the first event
+        const auto kept { Move(1.f, 1000) };
+        queue.addEvent(kept, target);
+        queue.addEvent(Move(2.f, 2000), target);
+        queue.addEvent(Move(3.f, 3000), target);
+        queue.dispatch();
+
+        Check(target.moves == 1 && target.pos.x() == 3.f, "Consecutive moves are delivered as the newest one");
+        Check(target.delta.x() == 3.f && target.historySize == 3, "Merged moves accumulate deltas and history");
+        Check(kept->pos.x() == 1.f && kept->delta.x() == 1.f && kept->us == 1000, "Events held by the poster are not modified");
+        Check(kept->history.empty(), "Events held by the poster get no history");
+
+        // Same with a pooled event handle
+        target.moves = 0;
+        auto pooled { CZEventPool::Make<CZPointerMoveEvent>(UInt64(4000)) };
+        auto &pooledMove { static_cast<CZPointerMoveEvent&>(*pooled) };
+        pooledMove.pos = SkPoint::Make(4.f, 0.f);
+        queue.addEvent(pooled, target);
+        queue.addEvent(Move(5.f, 5000), target);
+        queue.dispatch();
+
+        Check(target.moves == 1 && target.pos.x() == 5.f, "Pooled moves are coalesced");
+        Check(pooledMove.pos.x() == 4.f && pooledMove.us == 4000, "Pooled events held by the poster are not modified");
+    }
+
+    /* LANES */
+
+    {
+        CZSafeEventQueue queue;
+        Target target;
+        target.feedQueue = &queue;
+
+        for (UInt32 i = 0; i < 3; i++)
+        {
+            queue.addEvent(std::make_shared<CZLayoutEvent>(), target);
+            queue.addEvent(std::make_shared<CZCloseEvent>(), target);
+        }
+
+        queue.addEvent(std::make_shared<CZPointerMoveEvent>(), target);
+        queue.dispatch();
+
+        Check(target.moves >= 1, "Input is delivered");
+        Check(target.layouts >= 1 && target.closes >= 1, "Every lane delivers an event while input keeps arriving");
+
+        queue.dispatch();
+        queue.dispatch();
+        Check(target.layouts == 3 && target.closes == 3, "Lower lanes drain while input keeps arriving");
+
+        const UInt32 moves { target.moves };
+        queue.addEvent(std::make_shared<CZLayoutEvent>(), target);
+        queue.dispatch();
+        Check(target.moves >= moves + 1 && target.layouts == 4, "Input queued by handlers is delivered before the next lane");
+        target.feedQueue = nullptr;
+    }
+
+    return Test::Finish();
+}
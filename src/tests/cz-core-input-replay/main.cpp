@@ -0,0 +1,228 @@
+#include "CZTest.h"
+#include <CZ/Core/CZCore.h>
+#include <CZ/Core/CZInputDevice.h>
+#include <CZ/Core/CZInputRecorder.h>
+#include <CZ/Core/CZInputReplayer.h>
+#include <CZ/Core/Events/CZKeyboardKeyEvent.h>
+#include <CZ/Core/Events/CZPointerButtonEvent.h>
+#include <CZ/Core/Events/CZPointerMoveEvent.h>
+#include <CZ/Core/Events/CZPointerScrollEvent.h>
+#include <CZ/Core/Events/CZTouchBatchEvent.h>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace CZ;
+using Test::Check;
+
+using Recorder = CZInputRecorder;
+
+namespace
+{
+    class Target : public CZObject
+    {
+    public:
+        std::vector<std::shared_ptr<CZEvent>> events;
+
+        template<class T>
+        const T *find() const noexcept
+        {
+            for (const auto &e : events)
+                if (auto *event = dynamic_cast<const T*>(e.get()))
+                    return event;
+
+            return nullptr;
+        }
+    protected:
+        bool event(const CZEvent &e) noexcept override
+        {
+            events.emplace_back(e.copy());
+            return true;
+        }
+    };
+}
+
+// Offset of the first record of the given kind (and event type), or 0 if not found
+static size_t FindRecord(const std::vector<UInt8> &data, Recorder::Kind kind, CZEvent::Type type = {}) noexcept
+{
+    for (size_t offset = sizeof(Recorder::Header); offset + sizeof(Recorder::RecordHeader) <= data.size();)
+    {
+        Recorder::RecordHeader record;
+        std::memcpy(&record, data.data() + offset, sizeof(record));
+
+        if (record.kind == kind && (kind != Recorder::Kind::Event || record.type == static_cast<UInt16>(type)))
+            return offset;
+
+        offset += record.size;
+    }
+
+    return 0;
+}
+
+// Replays the data into a fresh target, nullptr if the replayer rejects it
+static std::shared_ptr<CZInputReplayer> Replay(std::vector<UInt8> data, Target &target) noexcept
+{
+    auto replayer { CZInputReplayer::MakeMemory(std::move(data)) };
+
+    if (!replayer)
+        return {};
+
+    replayer->setTargetResolver([&target](UInt32, const std::string &) -> CZObject* { return &target; });
+    replayer->runToEnd();
+    return replayer;
+}
+
+// Overwrites a payload field of the first event of the given type
+template<class T>
+static std::vector<UInt8> Corrupt(std::vector<UInt8> data, CZEvent::Type type, size_t fieldOffset, T value) noexcept
+{
+    const size_t offset { FindRecord(data, Recorder::Kind::Event, type) };
+
+    if (offset == 0)
+        return {};
+
+    std::memcpy(data.data() + offset + sizeof(Recorder::RecordHeader) + fieldOffset, &value, sizeof(value));
+    return data;
+}
+
+int main()
+{
+    setenv("CZ_CORE_LOG_LEVEL", "4", 1);
+
+    auto core { CZCore::GetOrMake() };
+    auto mouse { CZInputDevice::Make(CZInputDevice::Pointer, "Test Mouse", 0x46d, 0xc077) };
+    auto keyboard { CZInputDevice::Make(CZInputDevice::Keyboard, "Test Keyboard") };
+    Target target;
+
+    /* RECORDING */
+
+    auto recorder { Recorder::MakeMemory() };
+    const UInt64 madeUs { CZTime::Us() };
+
+    while (CZTime::Us() == madeUs) {}
+
+    Check(recorder->start(), "The recorder starts");
+
+    auto &move { core->postEvent<CZPointerMoveEvent>(target, UInt64(1000)) };
+    move.device = mouse;
+    move.pos = SkPoint::Make(10.f, 20.f);
+
+    auto &button { core->postEvent<CZPointerButtonEvent>(target, UInt64(2000)) };
+    button.device = mouse;
+    button.pressed = true;
+
+    auto &scroll { core->postEvent<CZPointerScrollEvent>(target, UInt64(3000)) };
+    scroll.device = mouse;
+    scroll.hasY = true;
+    scroll.axes = SkPoint::Make(0.f, 15.f);
+    scroll.relativeDirectionY = CZPointerScrollEvent::Inverted;
+    scroll.source = CZPointerScrollEvent::WheelLegacy;
+
+    auto &key { core->postEvent<CZKeyboardKeyEvent>(target, UInt64(4000)) };
+    key.device = keyboard;
+    key.code = 30;
+    key.isPressed = true;
+    key.isRepeat = true;
+    key.composeStatus = XKB_COMPOSE_COMPOSED;
+    key.utf8 = "é";
+
+    auto &batch { core->postEvent<CZTouchBatchEvent>(target, UInt64(5000)) };
+    batch.add(CZTouchBatchEvent::State::Down, 3, SkPoint::Make(1.f, 2.f));
+    batch.add(CZTouchBatchEvent::State::Up, 4, SkPoint::Make(3.f, 4.f));
+
+    core->dispatch(0);
+    recorder->stop();
+
+    const std::vector<UInt8> data { recorder->buffer() };
+    Recorder::Header header;
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    Check(recorder->eventCount() == 5 && target.events.size() == 5, "Every delivered input event is recorded");
+    Check(header.startUs > madeUs, "The start time is taken when recording starts");
+
+    /* ROUND TRIP */
+
+    {
+        Target replayed;
+        auto replayer { Replay(data, replayed) };
+        Check(replayer && replayer->postedCount() == 5 && replayer->skippedCount() == 0, "Every event is replayed");
+        Check(replayer && replayer->devices().size() == 2, "Devices are recreated");
+
+        const auto *m { replayed.find<CZPointerMoveEvent>() };
+        Check(m && m->pos == move.pos && m->us == 1000 && m->device && m->device->name == "Test Mouse",
+              "Pointer motion round-trips with its device");
+
+        const auto *b { replayed.find<CZPointerButtonEvent>() };
+        Check(b && b->pressed, "Bools round-trip");
+
+        const auto *s { replayed.find<CZPointerScrollEvent>() };
+        Check(s && !s->hasX && s->hasY && s->axes.y() == 15.f && s->relativeDirectionY == CZPointerScrollEvent::Inverted &&
+              s->source == CZPointerScrollEvent::WheelLegacy, "Scroll enums round-trip");
+
+        const auto *k { replayed.find<CZKeyboardKeyEvent>() };
+        Check(k && k->code == 30 && k->isPressed && k->isRepeat && k->composeStatus == XKB_COMPOSE_COMPOSED && k->utf8 == "é",
+              "Key events round-trip");
+
+        const auto *t { replayed.find<CZTouchBatchEvent>() };
+        Check(t && t->count == 2 && t->ids[1] == 4 && t->states[1] == CZTouchBatchEvent::State::Up && t->pos[0].y() == 2.f,
+              "Touch batches round-trip");
+    }
+
+    /* TRUNCATED */
+
+    {
+        Target replayed;
+        auto cut { data };
+        cut.resize(cut.size() - 3);
+        auto replayer { Replay(cut, replayed) };
+        Check(replayer && replayer->eventCount() == 4 && replayed.events.size() == 4, "A truncated record is ignored");
+
+        cut.resize(sizeof(Recorder::Header) - 1);
+        Check(!CZInputReplayer::MakeMemory(cut), "A truncated header is rejected");
+    }
+
+    /* CORRUPT */
+
+    const auto rejects = [](std::vector<UInt8> corrupt, const char *what) {
+        Target replayed;
+        auto replayer { Replay(std::move(corrupt), replayed) };
+        Check(replayer && replayer->skippedCount() == 1 && replayed.events.size() == 4, what);
+    };
+
+    // Payload layouts: see VisitFields() in CZInputRecorder.cpp, fields are packed
+    rejects(Corrupt(data, CZEvent::Type::PointerButton, 4, UInt8(2)), "A bool other than 0 or 1 is rejected");
+    rejects(Corrupt(data, CZEvent::Type::KeyboardKey, 5, UInt8(0xFF)), "A bool other than 0 or 1 is rejected (key repeat)");
+    rejects(Corrupt(data, CZEvent::Type::PointerScroll, 3, UInt8(2)), "An out of range relative direction is rejected");
+    rejects(Corrupt(data, CZEvent::Type::PointerScroll, 20, UInt32(4)), "An out of range scroll source is rejected");
+    rejects(Corrupt(data, CZEvent::Type::KeyboardKey, 10, UInt32(99)), "An out of range compose status is rejected");
+    rejects(Corrupt(data, CZEvent::Type::TouchBatch, 4 + 64 + 128 + 128 + 1, UInt8(3)), "An out of range touch state is rejected");
+    rejects(Corrupt(data, CZEvent::Type::TouchBatch, 0, UInt32(CZTouchBatchEvent::MaxPoints + 1)), "An out of range touch count is rejected");
+
+    {
+        // Event targeting an id without a description
+        auto corrupt { data };
+        const size_t offset { FindRecord(corrupt, Recorder::Kind::Event, CZEvent::Type::PointerMove) };
+        const UInt32 id { 1000 };
+        std::memcpy(corrupt.data() + offset + offsetof(Recorder::RecordHeader, target), &id, sizeof(id));
+
+        Target replayed;
+        auto replayer { CZInputReplayer::MakeMemory(std::move(corrupt)) };
+        replayer->setTargetResolver([&replayed](UInt32 id, const std::string &) -> CZObject* { return id == 0 ? &replayed : nullptr; });
+        replayer->runToEnd();
+        Check(replayer->skippedCount() == 1 && replayed.events.size() == 4, "Events of unknown targets are skipped");
+    }
+
+    {
+        // Device description with a huge id
+        auto corrupt { data };
+        const size_t offset { FindRecord(corrupt, Recorder::Kind::Device) };
+        const UInt32 id { 0xFFFF'FFF0 };
+        std::memcpy(corrupt.data() + offset + offsetof(Recorder::RecordHeader, device), &id, sizeof(id));
+
+        Target replayed;
+        auto replayer { Replay(std::move(corrupt), replayed) };
+        Check(replayer && replayer->devices().size() <= 2 && replayed.events.size() == 5, "Out of range device ids are ignored");
+    }
+
+    return Test::Finish();
+}
@@ -0,0 +1,172 @@
+#include "CZTest.h"
+#include <CZ/Core/CZCore.h>
+#include <CZ/Core/CZKeymap.h>
+#include <CZ/Core/CZKeyRepeater.h>
+#include <CZ/Core/CZLog.h>
+#include <CZ/Core/CZTime.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+using namespace CZ;
+using Test::Check;
+
+static UInt64 s_nowUs { 1000000 };
+
+static UInt64 VirtualClock() noexcept
+{
+    return s_nowUs;
+}
+
+static void Key(CZKeymap &keymap, CZKeyRepeater &repeater, UInt32 code, bool pressed, UInt64 us) noexcept
+{
+    CZKeyboardKeyEvent event { us };
+    event.code = code;
+    event.isPressed = pressed;
+    keymap.feed(event);
+    repeater.handleEvent(event);
+}
+
+int main()
+{
+    setenv("CZ_CORE_LOG_LEVEL", "4", 1);
+
+    auto core { CZCore::GetOrMake() };
+
+    // The checks rely on the keys of the "us" layout, which may not be installed (e.g. minimal containers)
+    xkb_rule_names names {};
+    names.layout = "us";
+    auto keymap { core ? CZKeymap::MakeServer(names) : nullptr };
+
+    if (!keymap)
+    {
+        CZLog(CZWarning, "Skipped: the xkb \"us\" keymap could not be compiled");
+        return 0;
+    }
+
+    keymap->setRepeatInfo(500, 32);
+
+    std::vector<CZKeyboardKeyEvent> events;
+    events.reserve(256);
+
+    CZKeyRepeater repeater { keymap, [&events](const CZKeyboardKeyEvent &e) { events.emplace_back(e); } };
+    repeater.setClock(&VirtualClock);
+
+    /* DELAY */
+
+    const UInt64 pressUs { s_nowUs };
+    Key(*keymap, repeater, KEY_A, true, pressUs);
+    Check(repeater.isRepeating() && repeater.code() == KEY_A, "A repeatable key starts repeating");
+    Check(repeater.nextRepeatUs() == pressUs + 500000, "The first repeat waits for the delay");
+
+    s_nowUs = pressUs + 499999;
+    Check(repeater.update() == 0, "Nothing is delivered before the delay");
+
+    s_nowUs = pressUs + 500000;
+    Check(repeater.update() == 1 && events.size() == 1, "The first repeat is delivered after the delay");
+    Check(events[0].isRepeat && events[0].isPressed && events[0].code == KEY_A, "Repeats are pressed copies of the key");
+    Check(events[0].symbol == XKB_KEY_a && events[0].utf8 == "a", "Repeats reuse the symbol and text of the press");
+    Check(events[0].us == pressUs + 500000, "Repeats are timestamped with their scheduled time");
+
+    /* DRIFT */
+
+    // Late wakeups of 0 to 9 ms after each deadline
+    const UInt64 allocations { Test::Allocations() };
+
+    for (UInt32 i = 1; i < 100; i++)
+    {
+        s_nowUs = pressUs + 500000 + i * 32000 + (i * 7919) % 9000;
+        repeater.update();
+    }
+
+    Check(Test::Allocations() == allocations, "Repeating allocates nothing");
+
+    bool aligned { events.size() == 100 };
+
+    for (size_t i = 0; aligned && i < events.size(); i++)
+        aligned = events[i].us == pressUs + 500000 + i * 32000;
+
+    Check(aligned, "Late wakeups do not accumulate drift");
+
+    /* MODIFIERS AND OTHER KEYS */
+
+    Key(*keymap, repeater, KEY_LEFTSHIFT, true, s_nowUs);
+    Check(repeater.isRepeating() && repeater.code() == KEY_A, "Non-repeatable keys do not interrupt the repeat");
+    Key(*keymap, repeater, KEY_LEFTSHIFT, false, s_nowUs);
+    Check(repeater.isRepeating(), "Releasing another key does not stop the repeat");
+
+    /* MISSED REPEATS */
+
+    events.clear();
+    const UInt64 stallStart { repeater.nextRepeatUs() };
+    s_nowUs = stallStart + 200000;
+    Check(repeater.update() == 1, "Drop delivers a single repeat after a stall");
+    Check(events.back().us == stallStart + 6 * 32000, "Drop delivers the most recent due repeat");
+    Check(repeater.nextRepeatUs() == stallStart + 7 * 32000, "Drop keeps the schedule aligned");
+
+    events.clear();
+    repeater.setMissedPolicy(CZKeyRepeater::MissedPolicy::CatchUp);
+    const UInt64 catchUpStart { repeater.nextRepeatUs() };
+    s_nowUs = catchUpStart + 100000;
+    Check(repeater.update() == 4 && events.size() == 4, "CatchUp delivers every missed repeat");
+    Check(events[0].us == catchUpStart && events[3].us == catchUpStart + 3 * 32000, "CatchUp keeps the scheduled timestamps");
+
+    events.clear();
+    s_nowUs = repeater.nextRepeatUs() + 1000000;
+    Check(repeater.update() == repeater.maxCatchUp(), "CatchUp bursts are limited");
+
+    /* RELEASE AND REPEAT INFO */
+
+    Key(*keymap, repeater, KEY_A, false, s_nowUs);
+    Check(!repeater.isRepeating(), "Releasing the key stops the repeat");
+
+    Key(*keymap, repeater, KEY_B, true, s_nowUs);
+    keymap->setRepeatInfo(200, 32);
+    Check(repeater.nextRepeatUs() == s_nowUs + 200000, "Repeat info changes reschedule the repeat");
+    keymap->setRepeatInfo(200, 0);
+    Check(!repeater.isRepeating(), "A rate of 0 disables repeat");
+    Key(*keymap, repeater, KEY_B, false, s_nowUs);
+
+    keymap->setRepeatInfo(100, 10);
+    Key(*keymap, repeater, KEY_C, true, s_nowUs);
+    repeater.setCallback([&repeater](const CZKeyboardKeyEvent &) { repeater.stop(); });
+    s_nowUs += 1000000;
+    Check(repeater.update() == 1 && !repeater.isRepeating(), "Stopping from the callback ends the burst");
+    Key(*keymap, repeater, KEY_C, false, s_nowUs);
+
+    /* EVENT LOOP */
+
+    // Real clock and timer: 100 ms delay, 10 ms rate. How many repeats fire depends on scheduling, so only
+    // their timestamps are checked: every one must fall exactly on the grid defined by the press
+    repeater.setClock(nullptr);
+    repeater.setMissedPolicy(CZKeyRepeater::MissedPolicy::Drop);
+
+    events.clear();
+    UInt64 maxLatenessUs { 0 };
+    repeater.setCallback([&events, &maxLatenessUs](const CZKeyboardKeyEvent &e) {
+        maxLatenessUs = std::max(maxLatenessUs, CZTime::Us() - e.us);
+        events.emplace_back(e);
+    });
+
+    const UInt64 realPressUs { CZTime::Us() };
+    Key(*keymap, repeater, KEY_D, true, realPressUs);
+
+    while (events.size() < 5 && CZTime::Us() - realPressUs < 5000000)
+        core->dispatch(10);
+
+    Key(*keymap, repeater, KEY_D, false, CZTime::Us());
+
+    aligned = !events.empty();
+
+    for (size_t i = 0; aligned && i < events.size(); i++)
+    {
+        const UInt64 us { events[i].us };
+        aligned = us >= realPressUs + 100000 && (us - realPressUs - 100000) % 10000 == 0 && (i == 0 || us > events[i - 1].us);
+    }
+
+    CZLog(CZInfo, "Event loop: {} repeats, max lateness {} us", events.size(), maxLatenessUs);
+    Check(!events.empty(), "The timer delivers repeats");
+    Check(aligned, "Timer repeats are aligned to the press");
+
+    return Test::Finish();
+}
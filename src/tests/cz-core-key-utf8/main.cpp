@@ -0,0 +1,88 @@
+#include "CZTest.h"
+#include <CZ/Core/CZLog.h>
+#include <CZ/Core/Events/CZKeyboardKeyEvent.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace CZ;
+using Test::Check;
+
+using UTF8 = CZKeyboardKeyEvent::UTF8;
+
+// Whether the text is a sequence of complete UTF-8 code points
+static bool ValidUTF8(std::string_view text) noexcept
+{
+    for (size_t i = 0; i < text.size();)
+    {
+        const UInt8 lead { static_cast<UInt8>(text[i]) };
+        const size_t sequence { lead < 0x80 ? 1u : lead >= 0xF0 ? 4u : lead >= 0xE0 ? 3u : lead >= 0xC0 ? 2u : 0u };
+
+        if (sequence == 0 || i + sequence > text.size())
+            return false;
+
+        for (size_t j = 1; j < sequence; j++)
+            if ((static_cast<UInt8>(text[i + j]) & 0xC0) != 0x80)
+                return false;
+
+        i += sequence;
+    }
+
+    return true;
+}
+
+// Fills a UTF8 both ways: by copy and in place like xkb_state_key_get_utf8() (snprintf semantics)
+static void Fill(const std::string &text, UTF8 &assigned, UTF8 &written) noexcept
+{
+    assigned.assign(text);
+    written.write([&text](char *buffer, size_t size) {
+        return std::snprintf(buffer, size, "%s", text.c_str());
+    });
+}
+
+static void CheckTruncation(const std::string &text, size_t expectedSize, const char *what) noexcept
+{
+    UTF8 assigned, written;
+    Fill(text, assigned, written);
+
+    const bool ok {
+        assigned.size() == expectedSize && written.size() == expectedSize &&
+        assigned.view() == written.view() &&
+        assigned.view() == std::string_view(text).substr(0, expectedSize) &&
+        ValidUTF8(assigned.view()) &&
+        assigned.c_str()[assigned.size()] == '\0' && written.c_str()[written.size()] == '\0' };
+
+    Check(ok, what);
+}
+
+int main()
+{
+    setenv("CZ_CORE_LOG_LEVEL", "4", 1);
+
+    const std::string a61(61, 'a');
+    const std::string a60(60, 'a');
+
+    /* FITTING TEXT */
+
+    CheckTruncation("", 0, "Empty text");
+    CheckTruncation("é", 2, "Short text is kept");
+    CheckTruncation(std::string(UTF8::Capacity, 'a'), UTF8::Capacity, "Text of exactly Capacity bytes is kept");
+    CheckTruncation(a60 + "é", UTF8::Capacity, "A code point ending at Capacity is kept");
+
+    /* TRUNCATED TEXT */
+
+    CheckTruncation(std::string(100, 'a'), UTF8::Capacity, "ASCII is cut at Capacity");
+    CheckTruncation(a61 + "é" + "zz", 61, "A 2-byte code point crossing Capacity is dropped");
+    CheckTruncation(a60 + "€" + "zz", 60, "A 3-byte code point crossing Capacity after its second byte is dropped");
+    CheckTruncation(a61 + "€", 61, "A 3-byte code point crossing Capacity after its lead byte is dropped");
+    CheckTruncation(std::string(59, 'a') + "😀" + "z", 59, "A 4-byte code point crossing Capacity is dropped");
+    CheckTruncation(std::string(58, 'a') + "😀" + "z", UTF8::Capacity, "A 4-byte code point ending at Capacity is kept");
+
+    /* CLEAR */
+
+    UTF8 text { "abc" };
+    text.clear();
+    Check(text.empty() && text.c_str()[0] == '\0', "Clear empties the text");
+
+    return Test::Finish();
+}
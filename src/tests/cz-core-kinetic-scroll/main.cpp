@@ -0,0 +1,187 @@
+#include "CZTest.h"
+#include <CZ/Core/CZCore.h>
+#include <CZ/Core/CZKineticScroll.h>
+#include <CZ/Core/CZLog.h>
+#include <CZ/Core/Events/CZPointerScrollEvent.h>
+#include <cmath>
+#include <cstdlib>
+
+using namespace CZ;
+using Test::Check;
+
+static UInt64 s_nowUs { 1000000 };
+
+static UInt64 VirtualClock() noexcept
+{
+    return s_nowUs;
+}
+
+static CZPointerScrollEvent FingerEvent(Float32 dy) noexcept
+{
+    CZPointerScrollEvent event { s_nowUs };
+    event.source = CZPointerScrollEvent::Finger;
+    event.hasY = true;
+    event.axes.set(0.f, dy);
+    return event;
+}
+
+static CZPointerScrollEvent FingerEventXY(bool hasX, Float32 dx, bool hasY, Float32 dy) noexcept
+{
+    CZPointerScrollEvent event { s_nowUs };
+    event.source = CZPointerScrollEvent::Finger;
+    event.hasX = hasX;
+    event.hasY = hasY;
+    event.axes.set(dx, dy);
+    return event;
+}
+
+// 10 finger events 8 ms apart moving 16 px each (2000 px/s), followed by an axis stop
+static void Swipe(CZKineticScroll &scroll, UInt64 restUs = 0) noexcept
+{
+    for (int i = 0; i < 10; i++)
+    {
+        s_nowUs += 8000;
+        scroll.handleEvent(FingerEvent(16.f));
+    }
+
+    s_nowUs += restUs;
+    scroll.handleEvent(FingerEvent(0.f));
+}
+
+// Steps the animation at 125 Hz until it stops, returns the number of frames
+static UInt32 Run(CZCore &core, CZKineticScroll &scroll) noexcept
+{
+    UInt32 frames { 0 };
+
+    while (scroll.isRunning() && frames < 10000)
+    {
+        s_nowUs += 8000;
+        core.updateAnimations();
+        frames++;
+    }
+
+    return frames;
+}
+
+int main()
+{
+    setenv("CZ_CORE_LOG_LEVEL", "4", 1);
+
+    auto core { CZCore::GetOrMake() };
+
+    // Frames are stepped manually with the virtual clock
+    core->setAnimationInterval(0);
+
+    UInt32 updates { 0 }, finishes { 0 };
+    CZKineticScroll scroll {
+        [&updates](CZAnimation *) { updates++; },
+        [&finishes](CZAnimation *) { finishes++; }};
+    scroll.setClock(&VirtualClock);
+
+    /* FLING */
+
+    const UInt64 allocations { Test::Allocations() };
+    Swipe(scroll);
+    Check(Test::Allocations() == allocations, "Handling events allocates nothing");
+    Check(scroll.phase() == CZKineticScroll::Phase::Flinging, "An axis stop starts the fling");
+    Check(std::abs(scroll.velocity().y() - 2000.f) < 20.f, "The release velocity matches the swipe");
+
+    const UInt32 frames { Run(*core, scroll) };
+    const Float64 expected { 160.0 + (2000.0 - scroll.minVelocity()) / scroll.friction() };
+    CZLog(CZInfo, "Fling: {} frames, offset {} (expected ~{})", frames, scroll.offset().y(), expected);
+    Check(scroll.phase() == CZKineticScroll::Phase::Idle, "The fling comes to rest");
+    Check(std::abs(scroll.offset().y() - expected) < 2.f, "The fling travels velocity / friction");
+    Check(scroll.offset().x() == 0.f, "The idle axis does not move");
+    Check(finishes == 1 && updates == frames, "Callbacks run once per frame and once on finish");
+
+    /* DETERMINISM */
+
+    const SkPoint first { scroll.offset() };
+    scroll.setOffset({ 0.f, 0.f });
+    Swipe(scroll);
+    Run(*core, scroll);
+    Check(scroll.offset() == first, "Runs on the same virtual clock are identical");
+
+    /* BOUNDS */
+
+    scroll.setOffset({ 0.f, 0.f });
+    scroll.setBounds(SkRect::MakeLTRB(0.f, 0.f, 0.f, 500.f));
+    Swipe(scroll);
+    Run(*core, scroll);
+    CZLog(CZInfo, "Bounded fling: offset {}", scroll.offset().y());
+    Check(scroll.offset().y() == 500.f, "The spring settles on the bounds");
+
+    /* LOCKED AXIS */
+
+    scroll.setOffset({ 0.f, 0.f });
+
+    for (int i = 0; i < 10; i++)
+    {
+        s_nowUs += 8000;
+        scroll.handleEvent(FingerEventXY(true, 16.f, true, 16.f));
+    }
+
+    Check(scroll.offset().x() == 0.f, "Deltas on a locked axis are dropped");
+    scroll.handleEvent(FingerEventXY(true, 0.f, true, 0.f));
+    Check(scroll.velocity().x() == 0.f && scroll.velocity().y() > 0.f, "A locked axis gets no velocity");
+    Run(*core, scroll);
+    Check(scroll.offset().x() == 0.f, "A locked axis stays in place");
+
+    /* PER AXIS STOP */
+
+    scroll.setBounds(SkRect::MakeLTRB(-SK_ScalarInfinity, -SK_ScalarInfinity, SK_ScalarInfinity, SK_ScalarInfinity));
+    scroll.setOffset({ 0.f, 0.f });
+
+    for (int i = 0; i < 10; i++)
+    {
+        s_nowUs += 8000;
+        scroll.handleEvent(FingerEventXY(true, 16.f, true, 16.f));
+    }
+
+    // The fingers stop moving horizontally but keep scrolling vertically
+    s_nowUs += 8000;
+    scroll.handleEvent(FingerEventXY(true, 0.f, true, 16.f));
+    Check(scroll.phase() == CZKineticScroll::Phase::Scrolling && scroll.isRunning(), "Stopping one axis flings it while scrolling the other");
+
+    const Float32 stoppedX { scroll.offset().x() };
+
+    for (int i = 0; i < 10; i++)
+    {
+        s_nowUs += 8000;
+        core->updateAnimations();
+        scroll.handleEvent(FingerEventXY(false, 0.f, true, 16.f));
+    }
+
+    Check(scroll.offset().x() > stoppedX + 100.f, "The stopped axis keeps flinging");
+    Check(scroll.offset().y() == 16.f * 21, "The other axis follows the fingers");
+
+    scroll.handleEvent(FingerEventXY(false, 0.f, true, 0.f));
+    Check(scroll.phase() == CZKineticScroll::Phase::Flinging, "Stopping the last axis flings it too");
+
+    // Touching one axis again only stops that one
+    s_nowUs += 8000;
+    scroll.handleEvent(FingerEventXY(false, 0.f, true, 4.f));
+    Check(scroll.isRunning() && scroll.velocity().x() > 0.f, "Scrolling one axis does not stop the fling of the other");
+    scroll.cancel();
+
+    /* RESTING FINGERS */
+
+    scroll.setOffset({ 0.f, 0.f });
+    Swipe(scroll, 200000);
+    Check(scroll.phase() == CZKineticScroll::Phase::Idle && !scroll.isRunning(), "Lifting rested fingers does not fling");
+
+    /* WHEEL */
+
+    scroll.setOffset({ 0.f, 0.f });
+    Swipe(scroll);
+    s_nowUs += 8000;
+    core->updateAnimations();
+
+    CZPointerScrollEvent wheel { FingerEvent(120.f) };
+    wheel.source = CZPointerScrollEvent::Wheel;
+    const SkPoint beforeWheel { scroll.offset() };
+    Check(!scroll.handleEvent(wheel), "Wheel events are left to the caller");
+    Check(!scroll.isRunning() && scroll.offset() == beforeWheel, "Wheel events stop the fling in place");
+
+    return Test::Finish();
+}
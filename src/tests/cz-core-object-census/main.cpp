@@ -0,0 +1,90 @@
+#include "CZTest.h"
+#include <CZ/Core/CZObject.h>
+#include <CZ/Core/CZObjectCensus.h>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+
+using namespace CZ;
+using Test::Check;
+
+namespace
+{
+    class Plain : public CZObject
+    {
+    public:
+        UInt64 data[4] {};
+    };
+
+    class alignas(128) Aligned : public CZObject
+    {
+    public:
+        UInt8 data[8] {};
+    };
+}
+
+static const CZObjectCensus::Entry *Find(const CZObjectCensus::Snapshot &snapshot, std::string_view type) noexcept
+{
+    for (const auto &entry : snapshot.entries)
+        if (entry.type.ends_with(type))
+            return &entry;
+
+    return nullptr;
+}
+
+int main()
+{
+    setenv("CZ_CORE_LOG_LEVEL", "4", 1);
+    CZObjectCensus::SetEnabled(true);
+
+    /* ALLOCATION */
+
+    {
+        std::unique_ptr<Aligned> aligned[4];
+        bool ok { true };
+
+        for (auto &object : aligned)
+        {
+            object.reset(new Aligned());
+            ok = ok && reinterpret_cast<uintptr_t>(object.get()) % alignof(Aligned) == 0;
+        }
+
+        Check(ok, "Over-aligned subclasses get aligned memory");
+
+        std::unique_ptr<Aligned> nothrow { new (std::nothrow) Aligned() };
+        Check(nothrow && reinterpret_cast<uintptr_t>(nothrow.get()) % alignof(Aligned) == 0, "Nothrow allocations are aligned too");
+
+        const auto snapshot { CZObjectCensus::Take() };
+        const auto *entry { Find(snapshot, "Aligned") };
+        Check(entry && entry->count == 5 && entry->bytes == 5 * sizeof(Aligned), "Aligned allocations are accounted");
+    }
+
+    /* THREADS */
+
+    {
+        std::unique_ptr<Plain> local { new Plain() };
+        std::unique_ptr<Plain> remote;
+        std::thread([&remote]() { remote.reset(new Plain()); }).join();
+
+        auto snapshot { CZObjectCensus::Take() };
+        const auto *entry { Find(snapshot, "Plain") };
+        Check(entry && entry->count == 1, "Only objects of the calling thread are classified");
+        Check(snapshot.count == 2 && snapshot.bytes == 2 * sizeof(Plain), "Objects of other threads are in the totals");
+
+        // A thread classifies its own objects
+        std::unique_ptr<Plain> worker;
+        std::thread([&worker]() { worker.reset(new Plain()); CZObjectCensus::Take(); }).join();
+        snapshot = CZObjectCensus::Take();
+        entry = Find(snapshot, "Plain");
+        Check(entry && entry->count >= 2 && snapshot.count == 3, "Threads classify the objects they create");
+
+        worker.reset();
+        remote.reset();
+        local.reset();
+        snapshot = CZObjectCensus::Take();
+        Check(snapshot.count == 0 && snapshot.bytes == 0, "Destroyed objects leave the totals");
+    }
+
+    CZObjectCensus::SetEnabled(false);
+    return Test::Finish();
+}
@@ -0,0 +1,115 @@
+#include "CZTest.h"
+#include <CZ/Core/CZShmRing.h>
+#include <CZ/Core/CZSharedMemory.h>
+#include <cstdlib>
+#include <cstring>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace CZ;
+using Test::Check;
+
+using Role = CZShmRing::Role;
+
+static bool Push(CZShmRing &ring, UInt32 value, size_t size) noexcept
+{
+    std::vector<UInt8> message(size, static_cast<UInt8>(value));
+    std::memcpy(message.data(), &value, sizeof(value));
+    return ring.push(message.data(), message.size());
+}
+
+// Value of the next message, or UINT32_MAX if the ring is empty or the message is not intact
+static UInt32 Pop(CZShmRing &ring, size_t size) noexcept
+{
+    const auto message { ring.peek() };
+
+    if (message.size() != size)
+        return UINT32_MAX;
+
+    UInt32 value;
+    std::memcpy(&value, message.data(), sizeof(value));
+
+    for (size_t i = sizeof(value); i < size; i++)
+        if (message[i] != static_cast<UInt8>(value))
+            return UINT32_MAX;
+
+    ring.pop();
+    return value;
+}
+
+int main()
+{
+    setenv("CZ_CORE_LOG_LEVEL", "4", 1);
+
+    auto consumer { CZShmRing::Make(4096, Role::Consumer) };
+    auto producer { consumer ? CZShmRing::Open(consumer->memoryFd(), consumer->eventFd(), Role::Producer) : nullptr };
+
+    if (!producer)
+    {
+        Check(false, "The ring can be created and opened");
+        return Test::Finish();
+    }
+
+    /* ROUND TRIP */
+
+    // Odd sizes wrap around the end of the ring several times
+    bool intact { true };
+
+    for (UInt32 i = 0; i < 64 && intact; i++)
+    {
+        intact = Push(*producer, i, 1000 + i) && Push(*producer, i + 1000, 500);
+        intact = intact && Pop(*consumer, 1000 + i) == i && Pop(*consumer, 500) == i + 1000;
+    }
+
+    Check(intact, "Messages round-trip across wraps");
+    Check(consumer->empty(), "The ring is empty once drained");
+
+    /* SEALS */
+
+    struct stat st;
+    fstat(consumer->memoryFd(), &st);
+    Check(ftruncate(consumer->memoryFd(), 0) != 0, "The region cannot be truncated by the peer");
+    Check(ftruncate(consumer->memoryFd(), st.st_size * 2) != 0, "The region cannot be grown by the peer");
+
+    {
+        // Same contents, no seals
+        auto copy { CZSharedMemory::MakeMemfd(st.st_size, "cz-shm-ring-copy") };
+        void *map { mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, consumer->memoryFd(), 0) };
+        std::memcpy(copy->map(), map, st.st_size);
+        munmap(map, st.st_size);
+        Check(!CZShmRing::Open(copy->fd(), consumer->eventFd(), Role::Producer), "Unsealed regions are rejected");
+        Check(copy->seal(F_SEAL_SHRINK) && CZShmRing::Open(copy->fd(), consumer->eventFd(), Role::Producer),
+              "Regions sealed against shrinking are accepted");
+    }
+
+    /* HOSTILE PRODUCER */
+
+    {
+        // Locate the header of the next message through the payload of the current one
+        Push(*producer, 1, 8);
+        auto *header { const_cast<UInt8*>(consumer->peek().data()) - 8 };
+        consumer->pop();
+
+        // A wrap marker that skips more than what was published
+        Push(*producer, 2, 8);
+        const UInt32 wrap { UINT32_MAX };
+        std::memcpy(header + 16, &wrap, sizeof(wrap));
+
+        Check(consumer->empty(), "A wrap beyond the head empties the ring");
+        Check(Push(*producer, 3, 8) && Pop(*consumer, 8) == 3 && consumer->empty(), "The ring keeps working after a bad wrap");
+
+        // A message larger than what was published
+        Push(*producer, 4, 8);
+        auto *next { const_cast<UInt8*>(consumer->peek().data()) - 8 };
+        consumer->pop();
+        Push(*producer, 5, 8);
+        const UInt32 size { 64 };
+        std::memcpy(next + 16, &size, sizeof(size));
+
+        Check(consumer->empty(), "A message beyond the head empties the ring");
+        Check(Push(*producer, 6, 8) && Pop(*consumer, 8) == 6, "The ring keeps working after a bad message");
+    }
+
+    return Test::Finish();
+}
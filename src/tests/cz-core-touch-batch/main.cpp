@@ -0,0 +1,121 @@
+#include "CZTest.h"
+#include <CZ/Core/Events/CZTouchBatchEvent.h>
+#include <cstdlib>
+#include <vector>
+
+using namespace CZ;
+using Test::Check;
+
+using State = CZTouchBatchEvent::State;
+
+// What forEachPointEvent() delivers, in order
+struct Delivered
+{
+    CZEvent::Type type;
+    Int32 id;
+    SkPoint pos;
+};
+
+static std::vector<Delivered> Expand(const CZTouchBatchEvent &batch) noexcept
+{
+    std::vector<Delivered> events;
+
+    batch.forEachPointEvent([&events](const CZInputEvent &e) {
+        switch (e.type())
+        {
+        case CZEvent::Type::TouchDown:
+            events.push_back({ e.type(), static_cast<const CZTouchDownEvent&>(e).id, static_cast<const CZTouchDownEvent&>(e).pos });
+            break;
+        case CZEvent::Type::TouchMove:
+            events.push_back({ e.type(), static_cast<const CZTouchMoveEvent&>(e).id, static_cast<const CZTouchMoveEvent&>(e).pos });
+            break;
+        case CZEvent::Type::TouchUp:
+            events.push_back({ e.type(), static_cast<const CZTouchUpEvent&>(e).id, {} });
+            break;
+        default:
+            events.push_back({ e.type(), -1, {} });
+            break;
+        }
+    });
+
+    return events;
+}
+
+int main()
+{
+    setenv("CZ_CORE_LOG_LEVEL", "4", 1);
+
+    /* TYPE */
+
+    {
+        const CZTouchBatchEvent batch;
+        Check(batch.isTouchEvent() && batch.isInputEvent(), "Batches are touch input events");
+        Check(static_cast<int>(CZEvent::Type::TouchBatch) > static_cast<int>(CZEvent::Type::LSurfaceUnlock),
+              "TouchBatch does not renumber the existing event types");
+    }
+
+    /* MERGING */
+
+    {
+        CZTouchBatchEvent batch;
+        batch.add(State::Down, 1, SkPoint::Make(1.f, 0.f));
+        batch.add(State::Move, 1, SkPoint::Make(2.f, 0.f));
+        batch.add(State::Move, 2, SkPoint::Make(10.f, 0.f));
+        batch.add(State::Move, 1, SkPoint::Make(3.f, 0.f));
+        batch.add(State::Move, 2, SkPoint::Make(11.f, 0.f));
+
+        Check(batch.count == 3, "Consecutive motion of a point is merged");
+        Check(batch.pos[1].x() == 3.f && batch.pos[2].x() == 11.f, "Merged motion keeps the latest position");
+    }
+
+    /* ORDER */
+
+    {
+        // A point lifted and touched again within the frame
+        CZTouchBatchEvent batch;
+        batch.add(State::Move, 1, SkPoint::Make(1.f, 0.f));
+        batch.add(State::Up, 1, SkPoint::Make(1.f, 0.f));
+        batch.add(State::Down, 1, SkPoint::Make(5.f, 0.f));
+        batch.add(State::Move, 1, SkPoint::Make(6.f, 0.f));
+
+        Check(batch.count == 4, "Motion after an Up and Down is not merged into earlier motion");
+        Check(batch.pos[0].x() == 1.f && batch.pos[3].x() == 6.f, "Motion before the Up keeps its position");
+
+        const auto events { Expand(batch) };
+        const bool ordered {
+            events.size() == 5 &&
+            events[0].type == CZEvent::Type::TouchMove && events[0].pos.x() == 1.f &&
+            events[1].type == CZEvent::Type::TouchUp &&
+            events[2].type == CZEvent::Type::TouchDown && events[2].pos.x() == 5.f &&
+            events[3].type == CZEvent::Type::TouchMove && events[3].pos.x() == 6.f &&
+            events[4].type == CZEvent::Type::TouchFrame };
+
+        Check(ordered, "Expanded events replay the frame in order");
+    }
+
+    /* APPEND */
+
+    {
+        CZTouchBatchEvent batch;
+        CZTouchDownEvent down { 1000 };
+        down.id = 7;
+        down.pos = SkPoint::Make(4.f, 4.f);
+        CZTouchUpEvent up { 2000 };
+        up.id = 7;
+
+        Check(batch.append(down) && batch.append(up), "Per-point events are appended");
+        Check(batch.count == 2 && batch.pos[1] == down.pos, "Up entries take the last position of the point");
+        Check(batch.us == 2000, "The batch takes the timestamp of the latest event");
+        Check(!batch.append(CZTouchFrameEvent()), "Frame events are not appended");
+
+        batch.clear();
+
+        for (Int32 id = 0; id < Int32(CZTouchBatchEvent::MaxPoints); id++)
+            batch.add(State::Down, id, {});
+
+        Check(!batch.add(State::Down, 100, {}), "Full batches reject new entries");
+        Check(!batch.add(State::Move, 0, {}), "Motion after a Down needs its own entry");
+    }
+
+    return Test::Finish();
+}